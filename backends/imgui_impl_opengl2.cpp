@@ -4,6 +4,8 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Alpha8 textures, uploaded as GL_ALPHA.
+//  [X] Renderer: Optional streamed vertex/index buffers (GL 1.5 or ARB_vertex_buffer_object), see ImGui_ImplOpenGL2_EnableVertexBuffers().
 // Missing features or Issues:
 //  [ ] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [ ] Renderer: Use of DrawCallback_SetSamplerLinear, DrawCallback_SetSamplerNearest is emulated by poking to glTexParameter(), as legacy OpenGL doesn't have glBindSampler().
@@ -54,6 +56,8 @@
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_opengl2.h"
 #include <stdint.h>     // intptr_t
+#include <stdio.h>      // sscanf
+#include <string.h>     // strstr
 
 // Clang/GCC warnings with -Weverything
 #if defined(__clang__)
@@ -75,6 +79,25 @@
 #else
 #include <GL/gl.h>
 #endif
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// Buffer objects are not part of the GL 1.1 headers shipped on every platform, declare what we use
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER                   0x8892
+#define GL_ELEMENT_ARRAY_BUFFER           0x8893
+#define GL_ARRAY_BUFFER_BINDING           0x8894
+#define GL_ELEMENT_ARRAY_BUFFER_BINDING   0x8895
+#define GL_STREAM_DRAW                    0x88E0
+#endif
+typedef intptr_t ImGui_ImplOpenGL2_GLsizeiptr;
+typedef intptr_t ImGui_ImplOpenGL2_GLintptr;
+typedef void (APIENTRY *ImGui_ImplOpenGL2_PFNGLGENBUFFERSPROC)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY *ImGui_ImplOpenGL2_PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY *ImGui_ImplOpenGL2_PFNGLBINDBUFFERPROC)(GLenum target, GLuint buffer);
+typedef void (APIENTRY *ImGui_ImplOpenGL2_PFNGLBUFFERDATAPROC)(GLenum target, ImGui_ImplOpenGL2_GLsizeiptr size, const void* data, GLenum usage);
+typedef void (APIENTRY *ImGui_ImplOpenGL2_PFNGLBUFFERSUBDATAPROC)(GLenum target, ImGui_ImplOpenGL2_GLintptr offset, ImGui_ImplOpenGL2_GLsizeiptr size, const void* data);
 
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
@@ -91,6 +114,16 @@ struct ImGui_ImplOpenGL2_Data
     bool        UseTexParameterToSetSampler;
     GLuint      NextSampler;
 
+    // Streamed buffer objects, only used when ImGui_ImplOpenGL2_EnableVertexBuffers() succeeded
+    bool        UseVertexBuffers;
+    GLuint      VboHandle;
+    GLuint      ElementsHandle;
+    ImGui_ImplOpenGL2_PFNGLGENBUFFERSPROC       GenBuffers;
+    ImGui_ImplOpenGL2_PFNGLDELETEBUFFERSPROC    DeleteBuffers;
+    ImGui_ImplOpenGL2_PFNGLBINDBUFFERPROC       BindBuffer;
+    ImGui_ImplOpenGL2_PFNGLBUFFERDATAPROC       BufferData;
+    ImGui_ImplOpenGL2_PFNGLBUFFERSUBDATAPROC    BufferSubData;
+
     ImGui_ImplOpenGL2_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
 
@@ -155,6 +188,42 @@ static void ImGui_ImplOpenGL2_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glLoadIdentity();
 }
 
+// Point the fixed pipeline at the vertices of one draw list: a client memory address, or an offset into VboHandle.
+static void ImGui_ImplOpenGL2_SetupVertexPointers(ImGui_ImplOpenGL2_Data* bd, const char* vtx_base)
+{
+    if (bd->UseVertexBuffers)
+    {
+        bd->BindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+        bd->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+    }
+    glVertexPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)(vtx_base + offsetof(ImDrawVert, pos)));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)(vtx_base + offsetof(ImDrawVert, uv)));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ImDrawVert), (const GLvoid*)(vtx_base + offsetof(ImDrawVert, col)));
+}
+
+// Copy every draw list of the frame into one orphaned vertex buffer and one orphaned index buffer.
+// Without this the driver copies the client arrays again on each glDrawElements() call.
+static void ImGui_ImplOpenGL2_UploadDrawData(ImGui_ImplOpenGL2_Data* bd, ImDrawData* draw_data)
+{
+    ImGui_ImplOpenGL2_GLsizeiptr vtx_size = (ImGui_ImplOpenGL2_GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+    ImGui_ImplOpenGL2_GLsizeiptr idx_size = (ImGui_ImplOpenGL2_GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+    bd->BindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+    bd->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+    GL_CALL(bd->BufferData(GL_ARRAY_BUFFER, vtx_size, nullptr, GL_STREAM_DRAW));
+    GL_CALL(bd->BufferData(GL_ELEMENT_ARRAY_BUFFER, idx_size, nullptr, GL_STREAM_DRAW));
+    ImGui_ImplOpenGL2_GLintptr vtx_offset = 0;
+    ImGui_ImplOpenGL2_GLintptr idx_offset = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        ImGui_ImplOpenGL2_GLsizeiptr list_vtx_size = (ImGui_ImplOpenGL2_GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+        ImGui_ImplOpenGL2_GLsizeiptr list_idx_size = (ImGui_ImplOpenGL2_GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        GL_CALL(bd->BufferSubData(GL_ARRAY_BUFFER, vtx_offset, list_vtx_size, draw_list->VtxBuffer.Data));
+        GL_CALL(bd->BufferSubData(GL_ELEMENT_ARRAY_BUFFER, idx_offset, list_idx_size, draw_list->IdxBuffer.Data));
+        vtx_offset += list_vtx_size;
+        idx_offset += list_idx_size;
+    }
+}
+
 // Draw callbacks
 static void ImGui_ImplOpenGL2_DrawCallback_ResetRenderState(const ImDrawList*, const ImDrawCmd*)    {} // Intentionally empty. Used as an identifier for rendering loop to call its code. Simpler to implement this way.
 static void ImGui_ImplOpenGL2_DrawCallback_SetSamplerLinear(const ImDrawList*, const ImDrawCmd*)    { ImGui_ImplOpenGL2_Data* bd = ImGui_ImplOpenGL2_GetBackendData(); bd->UseTexParameterToSetSampler = true; bd->NextSampler = GL_LINEAR; }
@@ -186,23 +255,34 @@ void ImGui_ImplOpenGL2_RenderDrawData(ImDrawData* draw_data)
     GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
     GLint last_shade_model; glGetIntegerv(GL_SHADE_MODEL, &last_shade_model);
     GLint last_tex_env_mode; glGetTexEnviv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, &last_tex_env_mode);
+    GLint last_array_buffer = 0, last_element_array_buffer = 0;
+    if (bd->UseVertexBuffers)
+    {
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
+    }
     glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TRANSFORM_BIT);
 
     // Setup desired GL state
     ImGui_ImplOpenGL2_SetupRenderState(draw_data, fb_width, fb_height);
+    if (bd->UseVertexBuffers)
+        ImGui_ImplOpenGL2_UploadDrawData(bd, draw_data);
 
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
     // Render command lists
+    // With buffer objects the "pointers" below are byte offsets into VboHandle/ElementsHandle.
+    intptr_t vtx_offset = 0;
+    intptr_t idx_offset = 0;
     for (const ImDrawList* draw_list : draw_data->CmdLists)
     {
-        const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data;
-        const ImDrawIdx* idx_buffer = draw_list->IdxBuffer.Data;
-        glVertexPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_buffer + offsetof(ImDrawVert, pos)));
-        glTexCoordPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_buffer + offsetof(ImDrawVert, uv)));
-        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_buffer + offsetof(ImDrawVert, col)));
+        const char* vtx_base = bd->UseVertexBuffers ? (const char*)vtx_offset : (const char*)draw_list->VtxBuffer.Data;
+        const ImDrawIdx* idx_buffer = bd->UseVertexBuffers ? (const ImDrawIdx*)idx_offset : draw_list->IdxBuffer.Data;
+        vtx_offset += (intptr_t)draw_list->VtxBuffer.Size * (intptr_t)sizeof(ImDrawVert);
+        idx_offset += (intptr_t)draw_list->IdxBuffer.Size * (intptr_t)sizeof(ImDrawIdx);
+        ImGui_ImplOpenGL2_SetupVertexPointers(bd, vtx_base);
 
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
@@ -211,7 +291,10 @@ void ImGui_ImplOpenGL2_RenderDrawData(ImDrawData* draw_data)
             {
                 // User callback, registered via ImDrawList::AddCallback()
                 if (pcmd->UserCallback == ImGui_ImplOpenGL2_DrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL2_SetupRenderState(draw_data, fb_width, fb_height);
+                    ImGui_ImplOpenGL2_SetupVertexPointers(bd, vtx_base);
+                }
                 else
                     pcmd->UserCallback(draw_list, pcmd);
             }
@@ -247,6 +330,11 @@ void ImGui_ImplOpenGL2_RenderDrawData(ImDrawData* draw_data)
     glDisableClientState(GL_COLOR_ARRAY);
     glDisableClientState(GL_TEXTURE_COORD_ARRAY);
     glDisableClientState(GL_VERTEX_ARRAY);
+    if (bd->UseVertexBuffers)
+    {
+        bd->BindBuffer(GL_ARRAY_BUFFER, (GLuint)last_array_buffer);
+        bd->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, (GLuint)last_element_array_buffer);
+    }
     glBindTexture(GL_TEXTURE_2D, (GLuint)last_texture);
     glMatrixMode(GL_MODELVIEW);
     glPopMatrix();
@@ -267,8 +355,9 @@ void ImGui_ImplOpenGL2_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
         const void* pixels = tex->GetPixels();
+        const GLenum gl_format = (tex->Format == ImTextureFormat_Alpha8) ? GL_ALPHA : GL_RGBA;
         GLuint gl_texture_id = 0;
 
         // Upload texture to graphics system
@@ -283,7 +372,8 @@ void ImGui_ImplOpenGL2_UpdateTexture(ImTextureData* tex)
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP));
         GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
         GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
-        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->Width, tex->Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        // With GL_MODULATE, GL_ALPHA textures keep the vertex color and multiply its alpha, as expected from Alpha8 textures
+        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, gl_format, tex->Width, tex->Height, 0, gl_format, GL_UNSIGNED_BYTE, pixels));
 
         // Store identifiers
         tex->SetTexID((ImTextureID)(intptr_t)gl_texture_id);
@@ -300,11 +390,12 @@ void ImGui_ImplOpenGL2_UpdateTexture(ImTextureData* tex)
         GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
 
         GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
+        const GLenum gl_format = (tex->Format == ImTextureFormat_Alpha8) ? GL_ALPHA : GL_RGBA;
         GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
         GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
         GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
         for (ImTextureRect& r : tex->Updates)
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
+            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
         GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
         GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
         tex->SetStatus(ImTextureStatus_OK);
@@ -335,6 +426,66 @@ void    ImGui_ImplOpenGL2_DestroyDeviceObjects()
         }
 }
 
+bool    ImGui_ImplOpenGL2_EnableVertexBuffers(ImGui_ImplOpenGL2_GetProcAddressFunc get_proc_address)
+{
+    ImGui_ImplOpenGL2_Data* bd = ImGui_ImplOpenGL2_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL2_Init()?");
+    ImGui_ImplOpenGL2_DisableVertexBuffers();
+    if (get_proc_address == nullptr)
+        return false;
+
+    // Buffer objects are core since GL 1.5, older contexts may still expose them as ARB_vertex_buffer_object.
+    // Check first: some loaders (e.g. glXGetProcAddress) return non-null pointers for any name.
+    const char* gl_version = (const char*)glGetString(GL_VERSION);
+    const char* gl_extensions = (const char*)glGetString(GL_EXTENSIONS);
+    int major = 0, minor = 0;
+    if (gl_version != nullptr)
+        sscanf(gl_version, "%d.%d", &major, &minor);
+    bool use_arb;
+    if (major > 1 || (major == 1 && minor >= 5))
+        use_arb = false;
+    else if (gl_extensions != nullptr && strstr(gl_extensions, "GL_ARB_vertex_buffer_object") != nullptr)
+        use_arb = true;
+    else
+        return false;
+
+    bd->GenBuffers = (ImGui_ImplOpenGL2_PFNGLGENBUFFERSPROC)get_proc_address(use_arb ? "glGenBuffersARB" : "glGenBuffers");
+    bd->DeleteBuffers = (ImGui_ImplOpenGL2_PFNGLDELETEBUFFERSPROC)get_proc_address(use_arb ? "glDeleteBuffersARB" : "glDeleteBuffers");
+    bd->BindBuffer = (ImGui_ImplOpenGL2_PFNGLBINDBUFFERPROC)get_proc_address(use_arb ? "glBindBufferARB" : "glBindBuffer");
+    bd->BufferData = (ImGui_ImplOpenGL2_PFNGLBUFFERDATAPROC)get_proc_address(use_arb ? "glBufferDataARB" : "glBufferData");
+    bd->BufferSubData = (ImGui_ImplOpenGL2_PFNGLBUFFERSUBDATAPROC)get_proc_address(use_arb ? "glBufferSubDataARB" : "glBufferSubData");
+    if (bd->GenBuffers == nullptr || bd->DeleteBuffers == nullptr || bd->BindBuffer == nullptr || bd->BufferData == nullptr || bd->BufferSubData == nullptr)
+    {
+        bd->GenBuffers = nullptr;
+        bd->DeleteBuffers = nullptr;
+        bd->BindBuffer = nullptr;
+        bd->BufferData = nullptr;
+        bd->BufferSubData = nullptr;
+        return false;
+    }
+    GL_CALL(bd->GenBuffers(1, &bd->VboHandle));
+    GL_CALL(bd->GenBuffers(1, &bd->ElementsHandle));
+    bd->UseVertexBuffers = true;
+    return true;
+}
+
+void    ImGui_ImplOpenGL2_DisableVertexBuffers()
+{
+    ImGui_ImplOpenGL2_Data* bd = ImGui_ImplOpenGL2_GetBackendData();
+    if (bd == nullptr || !bd->UseVertexBuffers)
+        return;
+    bd->DeleteBuffers(1, &bd->VboHandle);
+    bd->DeleteBuffers(1, &bd->ElementsHandle);
+    bd->VboHandle = bd->ElementsHandle = 0;
+    bd->UseVertexBuffers = false;
+}
+
+bool    ImGui_ImplOpenGL2_GetVertexBuffers()
+{
+    ImGui_ImplOpenGL2_Data* bd = ImGui_ImplOpenGL2_GetBackendData();
+    return bd != nullptr && bd->UseVertexBuffers;
+}
+
 bool    ImGui_ImplOpenGL2_Init()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -363,6 +514,7 @@ void    ImGui_ImplOpenGL2_Shutdown()
     ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
 
     ImGui_ImplOpenGL2_DestroyDeviceObjects();
+    ImGui_ImplOpenGL2_DisableVertexBuffers();
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
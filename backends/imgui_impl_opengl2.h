@@ -41,4 +41,12 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL2_DestroyDeviceObjects();
 // (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = nullptr to handle this manually.
 IMGUI_IMPL_API void     ImGui_ImplOpenGL2_UpdateTexture(ImTextureData* tex);
 
+// (Optional) Stream vertices and indices through buffer objects (GL 1.5 or ARB_vertex_buffer_object) instead of client-side arrays.
+// 'get_proc_address' resolves GL entry points (e.g. a wrapper around glfwGetProcAddress). Call with the GL context current.
+// Returns false and keeps rendering from client-side arrays if the context does not support buffer objects.
+typedef void* (*ImGui_ImplOpenGL2_GetProcAddressFunc)(const char* name);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL2_EnableVertexBuffers(ImGui_ImplOpenGL2_GetProcAddressFunc get_proc_address);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL2_DisableVertexBuffers();
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL2_GetVertexBuffers();
+
 #endif // #ifndef IMGUI_DISABLE
@@ -7,6 +7,10 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
 //  [x] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset) [Desktop OpenGL only!]
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Alpha8 textures, single channel when texture swizzles are available (GL 3.3+, GL ES 3.0+).
+//  [X] Renderer: Instanced rectangles and circles, see ImGui_ImplOpenGL3_AddShapeInstances().
+//  [X] Renderer: Analytic circles, rings, rounded rectangles and capsules, see ImGui_ImplOpenGL3_AddSdfShape().
+//  [X] Renderer: Signed distance field text, see ImGui_ImplOpenGL3_PushSdfText().
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -126,8 +130,12 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_opengl3.h"
+#ifdef IMGUI_COMPACT_DRAWVERT
+#include "imgui_internal.h"     // AddContextHook()
+#endif
 #include <stdio.h>
 #include <stdint.h>     // intptr_t
+#include <math.h>       // cosf, sinf
 #if defined(__APPLE__)
 #include <TargetConditionals.h>
 #endif
@@ -169,6 +177,10 @@
 #else
 #include <GLES3/gl3.h>          // Use GL ES 3
 #endif
+#elif defined(IMGUI_IMPL_OPENGL_LOADER_GL3W)
+// Full gl3w loader, initialized by the application with gl3wInit() before calling ImGui_ImplOpenGL3_Init().
+// Unlike our stripped loader it exposes glMapBufferRange() and sync objects, used by the streaming upload modes.
+#include <GL/gl3w.h>
 #elif !defined(IMGUI_IMPL_OPENGL_LOADER_CUSTOM)
 // Modern desktop OpenGL doesn't have a standard portable header file to load OpenGL function pointers.
 // Helper libraries are often used for this purpose! Here we are using our own minimal custom loader based on gl3w.
@@ -221,6 +233,36 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.0+ and GL ES 3.0+ have glMapBufferRange() and sync objects, which our stripped loader doesn't expose.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_LOADER_IMGL3W)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+#endif
+
+// Desktop GL 4.4+ and GL_ARB_buffer_storage have glBufferStorage(). Our gl3w stops at GL 4.3, it is queried at runtime.
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE) && defined(IMGUI_IMPL_OPENGL_LOADER_GL3W)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT             0x0040
+#define GL_MAP_COHERENT_BIT               0x0080
+#endif
+typedef void (APIENTRYP PFNIMGUIGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+#endif
+
+// Desktop GL 3.3+ and GL ES 3.0+ have GL_R8 textures and texture swizzles, to sample Alpha8 textures as (1, 1, 1, a) without shader changes.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && defined(GL_TEXTURE_SWIZZLE_R)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#endif
+
+// Desktop GL 3.3+ and GL ES 3.0+ have glDrawElementsInstanced() and glVertexAttribDivisor(), which our stripped loader doesn't expose.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_LOADER_IMGL3W)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+#endif
+
+// Signed distance field text shares the vertex attributes of the main shader through glBindAttribLocation(), which our stripped loader doesn't expose either.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_LOADER_IMGL3W)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -230,6 +272,16 @@
 #define GL_CALL(_CALL)      _CALL   // Call without error check
 #endif
 
+// Range of the unit shape index buffer drawn for each instance
+struct ImGui_ImplOpenGL3_UnitMesh
+{
+    GLintptr        IdxOffset;
+    GLsizei         IdxCount;
+};
+
+// Segment counts of the circle meshes, the smallest one matching the largest radius of a batch is used
+static const int    ImGui_ImplOpenGL3_CircleSegments[] = { 12, 24, 48, 96 };
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
@@ -253,6 +305,8 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasBindSampler;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    bool            HasMapBufferRange;
+    bool            HasTextureSwizzle;      // Alpha8 textures are uploaded as GL_R8, otherwise expanded to RGBA
     bool            UseTexParameterToSetSampler;
     GLuint          NextSampler;            // Used if !HasBindSampler && UseTexParameterToSetSampler.
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
@@ -261,6 +315,60 @@ struct ImGui_ImplOpenGL3_Data
 
     ImVector<char>  TempBuffer;
 
+    // Streaming upload (see ImGui_ImplOpenGL3_SetUploadMode())
+    ImGui_ImplOpenGL3_UploadMode UploadMode; // Effective mode, after falling back on missing features
+    GLintptr        VtxAttribOffset;        // Byte offset of the current draw list in the bound vertex/index buffers
+    GLintptr        IdxOffset;
+    GLint           BaseVertex;             // Added to ImDrawCmd::VtxOffset, non-zero when draw lists share a merged buffer
+    GLintptr        VtxHead;                // Write position in the streaming buffers
+    GLintptr        IdxHead;
+    bool            MergeDrawLists;         // See ImGui_ImplOpenGL3_SetMergeDrawLists()
+    bool            UseBaseVertex;          // Merged draw lists are addressed with glDrawElementsBaseVertex() instead of re-pointing attributes
+    GLintptr        MergedVtxPos;           // Position of the next draw list in the merged buffers
+    GLintptr        MergedIdxPos;
+    ImVector<char>  MergeBuffer;            // Staging for the merged glBufferData() upload
+    bool            ExclusiveContext;       // See ImGui_ImplOpenGL3_SetExclusiveContext()
+    GLuint          VaoHandle;              // Kept between frames when the context is exclusive
+#ifdef IMGUI_COMPACT_DRAWVERT
+    ImGuiID         PosStepHookId;          // Sets ImDrawVertPosOne() as every frame begins
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    GLsync          RingFences[3];          // One region per frame in flight
+#endif
+    char*           RingVtxData;            // Persistent mappings
+    char*           RingIdxData;
+    GLsizeiptr      RingVtxRegion;          // Size of one region
+    GLsizeiptr      RingIdxRegion;
+    int             RingFrame;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    PFNIMGUIGLBUFFERSTORAGEPROC BufferStorage; // nullptr when unsupported
+#endif
+
+    // Instanced shapes (see ImGui_ImplOpenGL3_AddShapeInstances())
+    bool            HasInstancing;
+    float           ProjMtx[4][4];          // Projection of the current frame, shared with the instance shader
+    GLuint          InstShaderHandle;
+    GLint           InstAttribLocationTex;
+    GLint           InstAttribLocationProjMtx;
+    GLint           InstAttribLocationFringeScale;
+    GLint           InstAttribLocationTextured;
+    GLuint          UnitVboHandle, UnitElementsHandle; // Unit meshes of every shape, static
+    GLuint          InstVboHandle;          // Instances of the batch being drawn
+    GLuint          InstVaoHandle;          // Created on the first batch of a frame, kept between frames when the context is exclusive
+    ImGui_ImplOpenGL3_UnitMesh UnitMeshes[2 + IM_COUNTOF(ImGui_ImplOpenGL3_CircleSegments)]; // Rect with fringe, plain rect, then circles
+
+    // Analytic shapes (see ImGui_ImplOpenGL3_AddSdfShape()), drawn over the plain unit rect with InstVboHandle
+    GLuint          SdfShaderHandle;
+    GLint           SdfAttribLocationProjMtx;
+    GLint           SdfAttribLocationFringeScale;
+    GLuint          SdfVaoHandle;           // Same lifetime as InstVaoHandle
+
+    // Signed distance field text (see ImGui_ImplOpenGL3_PushSdfText()), drawn from the vertices of the draw list
+    bool            HasSdfText;
+    GLuint          SdfTextShaderHandle;
+    GLint           SdfTextAttribLocationTex;
+    GLint           SdfTextAttribLocationProjMtx;
+
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
 
@@ -295,6 +403,120 @@ struct ImGui_ImplOpenGL3_VtxAttribState
 };
 #endif
 
+// GL state saved by ImGui_ImplOpenGL3_RenderDrawData() and restored after rendering.
+// Skipped entirely when the application declared exclusive ownership of the context (see ImGui_ImplOpenGL3_SetExclusiveContext()).
+struct ImGui_ImplOpenGL3_RenderStateBackup
+{
+    GLenum      last_active_texture;
+    GLuint      last_program;
+    GLuint      last_texture;
+    GLuint      last_sampler;
+    GLuint      last_array_buffer;
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    GLint       last_element_array_buffer;
+    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos;
+    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv;
+    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color;
+#endif
+    GLuint      last_vertex_array_object;
+    GLint       last_polygon_mode[2];
+    GLint       last_viewport[4];
+    GLint       last_scissor_box[4];
+    GLenum      last_blend_src_rgb;
+    GLenum      last_blend_dst_rgb;
+    GLenum      last_blend_src_alpha;
+    GLenum      last_blend_dst_alpha;
+    GLenum      last_blend_equation_rgb;
+    GLenum      last_blend_equation_alpha;
+    GLboolean   last_enable_blend;
+    GLboolean   last_enable_cull_face;
+    GLboolean   last_enable_depth_test;
+    GLboolean   last_enable_stencil_test;
+    GLboolean   last_enable_scissor_test;
+    GLboolean   last_enable_primitive_restart;
+
+    void Backup(ImGui_ImplOpenGL3_Data* bd)
+    {
+        glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
+        glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->HasBindSampler) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
+#endif
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
+        last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
+        last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
+        last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+        if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode); }
+#endif
+        glGetIntegerv(GL_VIEWPORT, last_viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
+        glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
+        glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
+        glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
+        last_enable_blend = glIsEnabled(GL_BLEND);
+        last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
+        last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+        last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
+        last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        last_enable_primitive_restart = (!bd->GlProfileIsES3 && bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+#endif
+    }
+
+    void Restore(ImGui_ImplOpenGL3_Data* bd)
+    {
+        // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
+        if (last_program == 0 || glIsProgram(last_program)) glUseProgram(last_program);
+        glBindTexture(GL_TEXTURE_2D, last_texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->HasBindSampler)
+            glBindSampler(0, last_sampler);
+#endif
+        glActiveTexture(last_active_texture);
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindVertexArray(last_vertex_array_object);
+#endif
+        glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
+        last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
+        last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
+        last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
+#endif
+        glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
+        glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
+        if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+        if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+        if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+        if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
+        if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        if (!bd->GlProfileIsES3 && bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+        // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for front-facing and back-facing faces of polygons
+        if (bd->HasPolygonMode) { if (bd->GlVersion <= 310 || bd->GlProfileIsCompat) { glPolygonMode(GL_FRONT, (GLenum)last_polygon_mode[0]); glPolygonMode(GL_BACK, (GLenum)last_polygon_mode[1]); } else { glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]); } }
+#endif // IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+
+        glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
+        glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+        (void)bd; // Not all compilation paths use this
+    }
+};
+
 // Not static to allow third-party code to use that if they want to (but undocumented)
 bool ImGui_ImplOpenGL3_InitLoader();
 bool ImGui_ImplOpenGL3_InitLoader()
@@ -330,6 +552,21 @@ void    ImGui_ImplOpenGL3_NewFrame()
             IM_ASSERT(0 && "ImGui_ImplOpenGL3_CreateDeviceObjects() failed!");
 }
 
+// Point attributes at the current draw list (offset is always 0 unless streaming)
+static void ImGui_ImplOpenGL3_SetupVertexAttribs(ImGui_ImplOpenGL3_Data* bd)
+{
+    const GLintptr base = bd->VtxAttribOffset;
+#ifdef IMGUI_COMPACT_DRAWVERT
+    // 16-bit fixed point positions are converted as integers, the projection matrix divides them by the step of the frame
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_SHORT,          GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(base + offsetof(ImDrawVert, pos))));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_UNSIGNED_SHORT, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)(base + offsetof(ImDrawVert, uv))));
+#else
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(base + offsetof(ImDrawVert, pos))));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(base + offsetof(ImDrawVert, uv))));
+#endif
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)(base + offsetof(ImDrawVert, col))));
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -379,9 +616,29 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
+#ifdef IMGUI_COMPACT_DRAWVERT
+    float vtx_projection[4][4];
+    memcpy(vtx_projection, ortho_projection, sizeof(ortho_projection));
+    const float pos_one = (float)ImDrawVertPosOneFor(draw_data->DisplaySize);
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 2; j++)
+            vtx_projection[i][j] /= pos_one;
+#else
+    const float (&vtx_projection)[4][4] = ortho_projection;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+    // Uniforms are kept by the program, SDF text only switches programs
+    if (bd->SdfTextShaderHandle != 0)
+    {
+        glUseProgram(bd->SdfTextShaderHandle);
+        glUniform1i(bd->SdfTextAttribLocationTex, 0);
+        glUniformMatrix4fv(bd->SdfTextAttribLocationProjMtx, 1, GL_FALSE, &vtx_projection[0][0]);
+    }
+#endif
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
-    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &vtx_projection[0][0]);
+    memcpy(bd->ProjMtx, ortho_projection, sizeof(ortho_projection)); // Unscaled, shape instances hold float positions
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->HasBindSampler)
@@ -399,13 +656,15 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
+    ImGui_ImplOpenGL3_SetupVertexAttribs(bd);
 }
 
 // Draw callbacks
 static void ImGui_ImplOpenGL3_DrawCallback_ResetRenderState(const ImDrawList*, const ImDrawCmd*)    {} // Intentionally empty. Used as an identifier for rendering loop to call its code. Simpler to implement this way.
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+static void ImGui_ImplOpenGL3_DrawCallback_PushSdfText(const ImDrawList*, const ImDrawCmd*)         {} // Intentionally empty. Used as an identifier for rendering loop to call its code.
+static void ImGui_ImplOpenGL3_DrawCallback_PopSdfText(const ImDrawList*, const ImDrawCmd*)          {} // Intentionally empty. Used as an identifier for rendering loop to call its code.
+#endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 static void ImGui_ImplOpenGL3_DrawCallback_SetSamplerLinear(const ImDrawList*, const ImDrawCmd*)    { ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData(); if (bd->HasBindSampler) { glBindSampler(0, bd->TexSamplers[0]); } else { bd->UseTexParameterToSetSampler = true; bd->NextSampler = GL_LINEAR; } }
 static void ImGui_ImplOpenGL3_DrawCallback_SetSamplerNearest(const ImDrawList*, const ImDrawCmd*)   { ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData(); if (bd->HasBindSampler) { glBindSampler(0, bd->TexSamplers[1]); } else { bd->UseTexParameterToSetSampler = true; bd->NextSampler = GL_NEAREST; } }
@@ -414,6 +673,419 @@ static void ImGui_ImplOpenGL3_DrawCallback_SetSamplerLinear(const ImDrawList*, c
 static void ImGui_ImplOpenGL3_DrawCallback_SetSamplerNearest(const ImDrawList*, const ImDrawCmd*)   { ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData(); bd->UseTexParameterToSetSampler = true; bd->NextSampler = GL_NEAREST; }
 #endif
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+// Instanced shapes: the draw list only holds a callback command whose payload is this header followed by the instances.
+// Payloads are not necessarily aligned in the draw list, the header is copied out before use.
+struct ImGui_ImplOpenGL3_ShapeBatch
+{
+    ImTextureID     TexID;                  // ImTextureID_Invalid for untextured shapes
+    int             Mesh;                   // Index in UnitMeshes[]
+    int             Count;
+    float           FringeScale;            // Width of the anti-aliasing fringe, 0 to disable it
+};
+
+static void ImGui_ImplOpenGL3_DrawCallback_Shapes(const ImDrawList*, const ImDrawCmd*)  {} // Intentionally empty. Used as an identifier for rendering loop to call its code.
+
+static void ImGui_ImplOpenGL3_SetupShapeVertexArray(ImGui_ImplOpenGL3_Data* bd)
+{
+    // Attribute 0 walks the unit mesh, attributes 1-3 advance once per instance
+    GL_CALL(glGenVertexArrays(1, &bd->InstVaoHandle));
+    glBindVertexArray(bd->InstVaoHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->UnitVboHandle);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->UnitElementsHandle);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (GLvoid*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->InstVboHandle);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(1, 2, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_ShapeInstance), (GLvoid*)offsetof(ImGui_ImplOpenGL3_ShapeInstance, Pos));
+    glVertexAttribPointer(2, 2, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_ShapeInstance), (GLvoid*)offsetof(ImGui_ImplOpenGL3_ShapeInstance, Size));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImGui_ImplOpenGL3_ShapeInstance), (GLvoid*)offsetof(ImGui_ImplOpenGL3_ShapeInstance, Col));
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribDivisor(3, 1);
+}
+
+// Returns false when the clipping rectangle is empty
+static bool ImGui_ImplOpenGL3_SetupShapeScissor(ImDrawData* draw_data, const ImDrawCmd* pcmd, int fb_height)
+{
+    ImVec2 clip_min((pcmd->ClipRect.x - draw_data->DisplayPos.x) * draw_data->FramebufferScale.x, (pcmd->ClipRect.y - draw_data->DisplayPos.y) * draw_data->FramebufferScale.y);
+    ImVec2 clip_max((pcmd->ClipRect.z - draw_data->DisplayPos.x) * draw_data->FramebufferScale.x, (pcmd->ClipRect.w - draw_data->DisplayPos.y) * draw_data->FramebufferScale.y);
+    if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+        return false;
+    GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+    return true;
+}
+
+static void ImGui_ImplOpenGL3_RenderShapes(ImDrawData* draw_data, const ImDrawCmd* pcmd, int fb_height, GLuint vertex_array_object)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (!ImGui_ImplOpenGL3_SetupShapeScissor(draw_data, pcmd, fb_height))
+        return;
+
+    ImGui_ImplOpenGL3_ShapeBatch batch;
+    memcpy(&batch, pcmd->UserCallbackData, sizeof(batch));
+    const ImGui_ImplOpenGL3_UnitMesh& mesh = bd->UnitMeshes[batch.Mesh];
+    glUseProgram(bd->InstShaderHandle);
+    glUniform1i(bd->InstAttribLocationTex, 0);
+    glUniformMatrix4fv(bd->InstAttribLocationProjMtx, 1, GL_FALSE, &bd->ProjMtx[0][0]);
+    glUniform1f(bd->InstAttribLocationFringeScale, batch.FringeScale);
+    glUniform1f(bd->InstAttribLocationTextured, batch.TexID != ImTextureID_Invalid ? 1.0f : 0.0f);
+    if (batch.TexID != ImTextureID_Invalid)
+        GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)batch.TexID));
+    if (bd->InstVaoHandle == 0)
+        ImGui_ImplOpenGL3_SetupShapeVertexArray(bd);
+    glBindVertexArray(bd->InstVaoHandle);
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->InstVboHandle));
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)batch.Count * (int)sizeof(ImGui_ImplOpenGL3_ShapeInstance), (const char*)pcmd->UserCallbackData + sizeof(batch), GL_STREAM_DRAW));
+    GL_CALL(glDrawElementsInstanced(GL_TRIANGLES, mesh.IdxCount, GL_UNSIGNED_SHORT, (void*)mesh.IdxOffset, batch.Count));
+
+    // Back to the draw list state, the array buffer binding is not part of the vertex array object
+    glUseProgram(bd->ShaderHandle);
+    glBindVertexArray(vertex_array_object);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+}
+
+// Analytic shapes: same layout as instanced shapes, with ImGui_ImplOpenGL3_SdfShape instances.
+// Consecutive shapes of a draw list are appended to the payload of the same command.
+struct ImGui_ImplOpenGL3_SdfBatch
+{
+    int             Count;
+    float           FringeScale;            // Width of the anti-aliasing fringe, 0 for hard edges
+};
+
+static void ImGui_ImplOpenGL3_DrawCallback_SdfShapes(const ImDrawList*, const ImDrawCmd*)  {} // Intentionally empty. Used as an identifier for rendering loop to call its code.
+
+static void ImGui_ImplOpenGL3_SetupSdfVertexArray(ImGui_ImplOpenGL3_Data* bd)
+{
+    // Attribute 0 walks the plain unit rect, attributes 1-5 advance once per shape
+    GL_CALL(glGenVertexArrays(1, &bd->SdfVaoHandle));
+    glBindVertexArray(bd->SdfVaoHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->UnitVboHandle);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->UnitElementsHandle);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (GLvoid*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->InstVboHandle);
+    for (GLuint attrib = 1; attrib <= 5; attrib++)
+    {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+    glVertexAttribPointer(1, 2, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_SdfShape), (GLvoid*)offsetof(ImGui_ImplOpenGL3_SdfShape, Pos));
+    glVertexAttribPointer(2, 2, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_SdfShape), (GLvoid*)offsetof(ImGui_ImplOpenGL3_SdfShape, Size));
+    glVertexAttribPointer(3, 2, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_SdfShape), (GLvoid*)offsetof(ImGui_ImplOpenGL3_SdfShape, Axis));
+    glVertexAttribPointer(4, 2, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_SdfShape), (GLvoid*)offsetof(ImGui_ImplOpenGL3_SdfShape, Rounding)); // Rounding, Thickness
+    glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImGui_ImplOpenGL3_SdfShape), (GLvoid*)offsetof(ImGui_ImplOpenGL3_SdfShape, Col));
+}
+
+static void ImGui_ImplOpenGL3_RenderSdfShapes(ImDrawData* draw_data, const ImDrawCmd* pcmd, int fb_height, GLuint vertex_array_object)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (!ImGui_ImplOpenGL3_SetupShapeScissor(draw_data, pcmd, fb_height))
+        return;
+
+    ImGui_ImplOpenGL3_SdfBatch batch;
+    memcpy(&batch, pcmd->UserCallbackData, sizeof(batch));
+    const ImGui_ImplOpenGL3_UnitMesh& mesh = bd->UnitMeshes[1];
+    glUseProgram(bd->SdfShaderHandle);
+    glUniformMatrix4fv(bd->SdfAttribLocationProjMtx, 1, GL_FALSE, &bd->ProjMtx[0][0]);
+    glUniform1f(bd->SdfAttribLocationFringeScale, batch.FringeScale);
+    if (bd->SdfVaoHandle == 0)
+        ImGui_ImplOpenGL3_SetupSdfVertexArray(bd);
+    glBindVertexArray(bd->SdfVaoHandle);
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->InstVboHandle));
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)batch.Count * (int)sizeof(ImGui_ImplOpenGL3_SdfShape), (const char*)pcmd->UserCallbackData + sizeof(batch), GL_STREAM_DRAW));
+    GL_CALL(glDrawElementsInstanced(GL_TRIANGLES, mesh.IdxCount, GL_UNSIGNED_SHORT, (void*)mesh.IdxOffset, batch.Count));
+
+    glUseProgram(bd->ShaderHandle);
+    glBindVertexArray(vertex_array_object);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+}
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+// Streaming upload: every draw list of the frame is written at increasing offsets of the same buffers,
+// instead of re-specifying the buffers once per draw list with glBufferData().
+// - MapRange: unsynchronized glMapBufferRange() into a buffer which is orphaned when the write position wraps.
+// - PersistentRing: a persistently-mapped buffer split in 3 regions, one per frame in flight, each guarded by a fence.
+static GLsizeiptr ImGui_ImplOpenGL3_GrowSize(GLsizeiptr current, GLsizeiptr required, GLsizeiptr granularity)
+{
+    GLsizeiptr size = current > 0 ? current : 64 * 1024;
+    while (size < required)
+        size *= 2;
+    return (size + granularity - 1) / granularity * granularity; // Keep draw list offsets aligned on whole vertices/indices
+}
+
+static void ImGui_ImplOpenGL3_DestroyStreamingBuffers(ImGui_ImplOpenGL3_Data* bd)
+{
+    for (GLsync& fence : bd->RingFences)
+        if (fence != nullptr)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    // Immutable storage cannot be re-specified, use fresh buffer objects (deleting them also unmaps them)
+    if (bd->VboHandle != 0)
+    {
+        glDeleteBuffers(1, &bd->VboHandle);
+        glDeleteBuffers(1, &bd->ElementsHandle);
+        glGenBuffers(1, &bd->VboHandle);
+        glGenBuffers(1, &bd->ElementsHandle);
+    }
+    bd->RingVtxData = bd->RingIdxData = nullptr;
+    bd->RingVtxRegion = bd->RingIdxRegion = 0;
+    bd->VertexBufferSize = bd->IndexBufferSize = 0;
+    bd->VtxHead = bd->IdxHead = 0;
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static bool ImGui_ImplOpenGL3_CreateRing(ImGui_ImplOpenGL3_Data* bd, GLsizeiptr vtx_size, GLsizeiptr idx_size)
+{
+    const GLsizeiptr vtx_region = ImGui_ImplOpenGL3_GrowSize(bd->RingVtxRegion, vtx_size, sizeof(ImDrawVert));
+    const GLsizeiptr idx_region = ImGui_ImplOpenGL3_GrowSize(bd->RingIdxRegion, idx_size, sizeof(ImDrawIdx));
+    ImGui_ImplOpenGL3_DestroyStreamingBuffers(bd);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+    GL_CALL(bd->BufferStorage(GL_ARRAY_BUFFER, vtx_region * IM_COUNTOF(bd->RingFences), nullptr, flags));
+    bd->RingVtxData = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vtx_region * IM_COUNTOF(bd->RingFences), flags);
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+    GL_CALL(bd->BufferStorage(GL_ELEMENT_ARRAY_BUFFER, idx_region * IM_COUNTOF(bd->RingFences), nullptr, flags));
+    bd->RingIdxData = (char*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, idx_region * IM_COUNTOF(bd->RingFences), flags);
+    if (bd->RingVtxData == nullptr || bd->RingIdxData == nullptr)
+    {
+        ImGui_ImplOpenGL3_DestroyStreamingBuffers(bd);
+        glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+        return false;
+    }
+    bd->RingVtxRegion = vtx_region;
+    bd->RingIdxRegion = idx_region;
+    return true;
+}
+#endif
+
+static void ImGui_ImplOpenGL3_BeginStreaming(ImDrawData* draw_data)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->UploadMode == ImGui_ImplOpenGL3_UploadMode_PersistentRing)
+    {
+        const GLsizeiptr vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+        const GLsizeiptr idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+        if (bd->RingVtxRegion < vtx_size || bd->RingIdxRegion < idx_size)
+            if (!ImGui_ImplOpenGL3_CreateRing(bd, vtx_size, idx_size))
+            {
+                bd->UploadMode = ImGui_ImplOpenGL3_UploadMode_MapRange; // Driver refused the mapping, keep going without it
+                return;
+            }
+        const int region = bd->RingFrame % IM_COUNTOF(bd->RingFences);
+        if (GLsync fence = bd->RingFences[region])
+        {
+            // Only blocks when the GPU is more than 2 frames behind
+            GLenum result;
+            do
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+            while (result == GL_TIMEOUT_EXPIRED);
+            glDeleteSync(fence);
+            bd->RingFences[region] = nullptr;
+        }
+        bd->VtxHead = bd->RingVtxRegion * region;
+        bd->IdxHead = bd->RingIdxRegion * region;
+    }
+#else
+    IM_UNUSED(draw_data);
+    IM_UNUSED(bd);
+#endif
+}
+
+// Orphan on wrap: the driver hands us fresh storage while the GPU keeps reading the old one.
+// Until then we only ever write past what previous draws used, which needs no synchronization.
+static void ImGui_ImplOpenGL3_ReserveStream(ImGui_ImplOpenGL3_Data* bd, GLsizeiptr vtx_size, GLsizeiptr idx_size)
+{
+    if (bd->VtxHead + vtx_size > bd->VertexBufferSize)
+    {
+        bd->VertexBufferSize = ImGui_ImplOpenGL3_GrowSize(bd->VertexBufferSize, vtx_size, sizeof(ImDrawVert));
+        GL_CALL(glBufferData(GL_ARRAY_BUFFER, bd->VertexBufferSize, nullptr, GL_STREAM_DRAW));
+        bd->VtxHead = 0;
+    }
+    if (bd->IdxHead + idx_size > bd->IndexBufferSize)
+    {
+        bd->IndexBufferSize = ImGui_ImplOpenGL3_GrowSize(bd->IndexBufferSize, idx_size, sizeof(ImDrawIdx));
+        GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, bd->IndexBufferSize, nullptr, GL_STREAM_DRAW));
+        bd->IdxHead = 0;
+    }
+}
+
+static void ImGui_ImplOpenGL3_StreamDrawList(const ImDrawList* draw_list)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const GLsizeiptr vtx_size = (GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+    const GLsizeiptr idx_size = (GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+    if (bd->UploadMode == ImGui_ImplOpenGL3_UploadMode_PersistentRing)
+    {
+        // Regions were sized for the whole frame in ImGui_ImplOpenGL3_BeginStreaming()
+        memcpy(bd->RingVtxData + bd->VtxHead, draw_list->VtxBuffer.Data, (size_t)vtx_size);
+        memcpy(bd->RingIdxData + bd->IdxHead, draw_list->IdxBuffer.Data, (size_t)idx_size);
+    }
+    else
+    {
+        ImGui_ImplOpenGL3_ReserveStream(bd, vtx_size, idx_size);
+        const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        // A range which cannot be mapped is uploaded with glBufferSubData(), the draw still gets its data
+        if (vtx_size > 0)
+        {
+            if (void* dst = glMapBufferRange(GL_ARRAY_BUFFER, bd->VtxHead, vtx_size, access))
+            {
+                memcpy(dst, draw_list->VtxBuffer.Data, (size_t)vtx_size);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+            else
+            {
+                GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, bd->VtxHead, vtx_size, (const GLvoid*)draw_list->VtxBuffer.Data));
+            }
+        }
+        if (idx_size > 0)
+        {
+            if (void* dst = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, bd->IdxHead, idx_size, access))
+            {
+                memcpy(dst, draw_list->IdxBuffer.Data, (size_t)idx_size);
+                glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+            }
+            else
+            {
+                GL_CALL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, bd->IdxHead, idx_size, (const GLvoid*)draw_list->IdxBuffer.Data));
+            }
+        }
+    }
+    bd->VtxAttribOffset = bd->VtxHead;
+    bd->IdxOffset = bd->IdxHead;
+    bd->VtxHead += vtx_size;
+    bd->IdxHead += idx_size;
+    ImGui_ImplOpenGL3_SetupVertexAttribs(bd);
+}
+
+static void ImGui_ImplOpenGL3_EndStreaming()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd->UploadMode == ImGui_ImplOpenGL3_UploadMode_PersistentRing)
+    {
+        bd->RingFences[bd->RingFrame % IM_COUNTOF(bd->RingFences)] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        bd->RingFrame++;
+    }
+}
+#endif // #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+
+// Merged upload: the vertices and indices of all draw lists are concatenated and uploaded once per frame,
+// then each draw list is addressed by its offset in the merged buffers.
+static void ImGui_ImplOpenGL3_UploadMerged(ImDrawData* draw_data)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const GLsizeiptr vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+    const GLsizeiptr idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+    char* vtx_dst = nullptr;
+    char* idx_dst = nullptr;
+    bool mapped = false;
+    IM_UNUSED(mapped); // Only with glMapBufferRange()
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    if (bd->UploadMode == ImGui_ImplOpenGL3_UploadMode_PersistentRing)
+    {
+        vtx_dst = bd->RingVtxData + bd->VtxHead;
+        idx_dst = bd->RingIdxData + bd->IdxHead;
+    }
+    else if (bd->UploadMode == ImGui_ImplOpenGL3_UploadMode_MapRange && vtx_size > 0 && idx_size > 0)
+    {
+        ImGui_ImplOpenGL3_ReserveStream(bd, vtx_size, idx_size);
+        const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        vtx_dst = (char*)glMapBufferRange(GL_ARRAY_BUFFER, bd->VtxHead, vtx_size, access);
+        idx_dst = (char*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, bd->IdxHead, idx_size, access);
+        mapped = true;
+        if (vtx_dst == nullptr || idx_dst == nullptr)
+        {
+            // Only the buffer which did map may be unmapped
+            if (vtx_dst != nullptr)
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            if (idx_dst != nullptr)
+                glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+            vtx_dst = idx_dst = nullptr;
+            mapped = false;
+        }
+    }
+    else if (bd->UploadMode == ImGui_ImplOpenGL3_UploadMode_MapRange)
+    {
+        ImGui_ImplOpenGL3_ReserveStream(bd, vtx_size, idx_size);
+    }
+    else
+#endif
+    {
+        bd->VtxHead = bd->IdxHead = 0;
+    }
+
+    // Staging copy when the destination is not mapped (default mode, or mapping failed)
+    const bool staged = (vtx_dst == nullptr);
+    if (staged)
+    {
+        bd->MergeBuffer.resize((int)(vtx_size + idx_size));
+        vtx_dst = bd->MergeBuffer.Data;
+        idx_dst = bd->MergeBuffer.Data + vtx_size;
+    }
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        const size_t list_vtx_size = (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        const size_t list_idx_size = (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+        memcpy(vtx_dst, draw_list->VtxBuffer.Data, list_vtx_size);
+        memcpy(idx_dst, draw_list->IdxBuffer.Data, list_idx_size);
+        vtx_dst += list_vtx_size;
+        idx_dst += list_idx_size;
+    }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    if (mapped)
+    {
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    }
+    else
+#endif
+    if (staged && bd->UploadMode == ImGui_ImplOpenGL3_UploadMode_BufferData)
+    {
+        GL_CALL(glBufferData(GL_ARRAY_BUFFER, vtx_size, (const GLvoid*)bd->MergeBuffer.Data, GL_STREAM_DRAW));
+        GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_size, (const GLvoid*)(bd->MergeBuffer.Data + vtx_size), GL_STREAM_DRAW));
+    }
+    else if (staged && vtx_size > 0 && idx_size > 0)
+    {
+        GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, bd->VtxHead, vtx_size, (const GLvoid*)bd->MergeBuffer.Data));
+        GL_CALL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, bd->IdxHead, idx_size, (const GLvoid*)(bd->MergeBuffer.Data + vtx_size)));
+    }
+    bd->MergedVtxPos = bd->VtxHead;
+    bd->MergedIdxPos = bd->IdxHead;
+    bd->VtxHead += vtx_size;
+    bd->IdxHead += idx_size;
+    // Buffer objects may have been recreated by the ring, attributes always need pointing once
+    if (bd->UseBaseVertex)
+    {
+        bd->VtxAttribOffset = 0;
+        ImGui_ImplOpenGL3_SetupVertexAttribs(bd);
+    }
+}
+
+static void ImGui_ImplOpenGL3_SelectMergedDrawList(const ImDrawList* draw_list)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    bd->IdxOffset = bd->MergedIdxPos;
+    if (bd->UseBaseVertex)
+    {
+        // No GL call at all between draw lists
+        bd->BaseVertex = (GLint)(bd->MergedVtxPos / (GLintptr)sizeof(ImDrawVert));
+    }
+    else
+    {
+        bd->VtxAttribOffset = bd->MergedVtxPos;
+        ImGui_ImplOpenGL3_SetupVertexAttribs(bd);
+    }
+    bd->MergedVtxPos += (GLintptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+    bd->MergedIdxPos += (GLintptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+}
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -437,50 +1109,25 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 ImGui_ImplOpenGL3_UpdateTexture(tex);
 
     // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
+    ImGui_ImplOpenGL3_RenderStateBackup backup;
+    if (!bd->ExclusiveContext)
+        backup.Backup(bd);
     glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->HasBindSampler) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
-#endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
-    GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos; last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    GLint last_polygon_mode[2]; if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode); }
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (!bd->GlProfileIsES3 && bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
-#endif
 
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
+    // With an exclusive context there is no other context nor other VAO user, keep ours between frames.
     GLuint vertex_array_object = 0;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+    if (bd->ExclusiveContext)
+    {
+        if (bd->VaoHandle == 0)
+            GL_CALL(glGenVertexArrays(1, &bd->VaoHandle));
+        vertex_array_object = bd->VaoHandle;
+    }
+    else
+        GL_CALL(glGenVertexArrays(1, &vertex_array_object));
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
@@ -488,6 +1135,19 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
+    // Elide redundant texture binds and scissor changes between commands. User callbacks may change anything, they reset the cache.
+    ImTextureID bound_texture = ImTextureID_Invalid;
+    GLint scissor_box[4] = { -1, -1, -1, -1 };
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    const bool streaming = bd->UploadMode != ImGui_ImplOpenGL3_UploadMode_BufferData;
+    if (streaming)
+        ImGui_ImplOpenGL3_BeginStreaming(draw_data);
+#endif
+    const bool merged = bd->MergeDrawLists;
+    if (merged)
+        ImGui_ImplOpenGL3_UploadMerged(draw_data);
+
     // Render command lists
     for (const ImDrawList* draw_list : draw_data->CmdLists)
     {
@@ -499,8 +1159,21 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - We are now back to using exclusively glBufferData(). So bd->UseBufferSubData IS ALWAYS FALSE in this code.
         //   We are keeping the old code path for a while in case people finding new issues may want to test the bd->UseBufferSubData path.
         // - See https://github.com/ocornut/imgui/issues/4468 and please report any corruption issues.
+        // - See ImGui_ImplOpenGL3_SetUploadMode() for the streaming alternatives.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        if (merged)
+        {
+            ImGui_ImplOpenGL3_SelectMergedDrawList(draw_list);
+        }
+        else
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+        if (streaming)
+        {
+            ImGui_ImplOpenGL3_StreamDrawList(draw_list);
+        }
+        else
+#endif
         if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
@@ -530,8 +1203,23 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 if (pcmd->UserCallback == ImGui_ImplOpenGL3_DrawCallback_ResetRenderState)
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+                else if (pcmd->UserCallback == ImGui_ImplOpenGL3_DrawCallback_Shapes)
+                    ImGui_ImplOpenGL3_RenderShapes(draw_data, pcmd, fb_height, vertex_array_object);
+                else if (pcmd->UserCallback == ImGui_ImplOpenGL3_DrawCallback_SdfShapes)
+                    ImGui_ImplOpenGL3_RenderSdfShapes(draw_data, pcmd, fb_height, vertex_array_object);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+                // Same vertices, attribute locations and texture unit as the main shader: only the program changes
+                else if (pcmd->UserCallback == ImGui_ImplOpenGL3_DrawCallback_PushSdfText)
+                    glUseProgram(bd->SdfTextShaderHandle);
+                else if (pcmd->UserCallback == ImGui_ImplOpenGL3_DrawCallback_PopSdfText)
+                    glUseProgram(bd->ShaderHandle);
+#endif
                 else
                     pcmd->UserCallback(draw_list, pcmd);
+                bound_texture = ImTextureID_Invalid;
+                scissor_box[2] = -1;
             }
             else
             {
@@ -542,10 +1230,20 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     continue;
 
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+                const GLint scissor[4] = { (int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y) };
+                if (memcmp(scissor, scissor_box, sizeof(scissor)) != 0)
+                {
+                    GL_CALL(glScissor(scissor[0], scissor[1], scissor[2], scissor[3]));
+                    memcpy(scissor_box, scissor, sizeof(scissor));
+                }
 
                 // Bind texture, Draw
-                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                const ImTextureID tex_id = pcmd->GetTexID();
+                if (tex_id != bound_texture)
+                {
+                    GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)tex_id));
+                    bound_texture = tex_id;
+                }
 
                 // Emulate sampler change (even though it is technically part of texture data)
                 // As a sort of hack/workaround, we only start writing using glTextParameter() if sampler is ever changed explicitly.
@@ -557,56 +1255,45 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
-                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
+                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(bd->IdxOffset + pcmd->IdxOffset * sizeof(ImDrawIdx)), bd->BaseVertex + (GLint)pcmd->VtxOffset));
                 else
 #endif
-                GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
+                GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(bd->IdxOffset + pcmd->IdxOffset * sizeof(ImDrawIdx))));
             }
         }
     }
 
-    // Destroy the temporary VAO
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    if (streaming)
+        ImGui_ImplOpenGL3_EndStreaming();
 #endif
+    bd->VtxAttribOffset = bd->IdxOffset = 0;
+    bd->BaseVertex = 0;
 
-    // Restore modified GL state
-    // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
-    if (last_program == 0 || glIsProgram(last_program)) glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (bd->HasBindSampler)
-        glBindSampler(0, last_sampler);
-#endif
-    glActiveTexture(last_active_texture);
+    // Destroy the temporary VAOs
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(last_vertex_array_object);
+    if (!bd->ExclusiveContext)
+        GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
 #endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
-    last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
-    last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
-    last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
-#endif
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (!bd->GlProfileIsES3 && bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (!bd->ExclusiveContext && bd->InstVaoHandle != 0)
+    {
+        GL_CALL(glDeleteVertexArrays(1, &bd->InstVaoHandle));
+        bd->InstVaoHandle = 0;
+    }
+    if (!bd->ExclusiveContext && bd->SdfVaoHandle != 0)
+    {
+        GL_CALL(glDeleteVertexArrays(1, &bd->SdfVaoHandle));
+        bd->SdfVaoHandle = 0;
+    }
 #endif
 
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for front-facing and back-facing faces of polygons
-    if (bd->HasPolygonMode) { if (bd->GlVersion <= 310 || bd->GlProfileIsCompat) { glPolygonMode(GL_FRONT, (GLenum)last_polygon_mode[0]); glPolygonMode(GL_BACK, (GLenum)last_polygon_mode[1]); } else { glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]); } }
-#endif // IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+    // Restore modified GL state
+    // With an exclusive context only leave scissor test off, so that the next glClear() covers the whole framebuffer
+    if (!bd->ExclusiveContext)
+        backup.Restore(bd);
+    else
+        glDisable(GL_SCISSOR_TEST);
     (void)bd; // Not all compilation paths use this
 }
 
@@ -620,8 +1307,37 @@ static void ImGui_ImplOpenGL3_DestroyTexture(ImTextureData* tex)
     tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
+// Copy a rectangle of the texture into a contiguous buffer, expanding Alpha8 pixels to white RGBA if requested
+static const void* ImGui_ImplOpenGL3_CopyTextureRect(ImTextureData* tex, int x, int y, int w, int h, bool expand_alpha)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const int src_pitch = w * tex->BytesPerPixel;
+    const int dst_pitch = expand_alpha ? w * 4 : src_pitch;
+    bd->TempBuffer.resize(h * dst_pitch);
+    char* out_p = bd->TempBuffer.Data;
+    for (int row = 0; row < h; row++, out_p += dst_pitch)
+    {
+        const unsigned char* src_p = (const unsigned char*)tex->GetPixelsAt(x, y + row);
+        if (!expand_alpha)
+        {
+            memcpy(out_p, src_p, src_pitch);
+            continue;
+        }
+        ImU32* dst_p = (ImU32*)(void*)out_p;
+        for (int col = 0; col < w; col++)
+            dst_p[col] = IM_COL32(255, 255, 255, src_p[col]);
+    }
+    IM_ASSERT(out_p == bd->TempBuffer.end());
+    return bd->TempBuffer.Data;
+}
+
 void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 {
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
+    const bool single_channel = (tex->Format == ImTextureFormat_Alpha8) && bd->HasTextureSwizzle;
+    const bool expand_alpha = (tex->Format == ImTextureFormat_Alpha8) && !single_channel;
+
     // FIXME: Consider backing up and restoring
     if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
     {
@@ -638,8 +1354,7 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
-        const void* pixels = tex->GetPixels();
+        const void* pixels = expand_alpha ? ImGui_ImplOpenGL3_CopyTextureRect(tex, 0, 0, tex->Width, tex->Height, true) : tex->GetPixels();
         GLuint gl_texture_id = 0;
 
         // Upload texture to graphics system
@@ -652,6 +1367,18 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        if (single_channel)
+        {
+            // A quarter of the memory and upload bandwidth of RGBA, sampled as (1, 1, 1, r)
+            GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, tex->Width, tex->Height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED));
+        }
+        else
+#endif
         GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->Width, tex->Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
 
         // Store identifiers
@@ -670,25 +1397,27 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 
         GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
         GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
-#if GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
-        for (ImTextureRect& r : tex->Updates)
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        const GLenum gl_format = single_channel ? GL_RED : GL_RGBA;
 #else
-        // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
-        ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-        for (ImTextureRect& r : tex->Updates)
+        const GLenum gl_format = GL_RGBA;
+#endif
+#if GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+        if (!expand_alpha)
         {
-            const int src_pitch = r.w * tex->BytesPerPixel;
-            bd->TempBuffer.resize(r.h * src_pitch);
-            char* out_p = bd->TempBuffer.Data;
-            for (int y = 0; y < r.h; y++, out_p += src_pitch)
-                memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
-            IM_ASSERT(out_p == bd->TempBuffer.end());
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
+            for (ImTextureRect& r : tex->Updates)
+                GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
         }
+        else
 #endif
+        {
+            // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
+            // Alpha8 pixels are expanded on the way when the texture couldn't be created single channel.
+            for (ImTextureRect& r : tex->Updates)
+                GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, ImGui_ImplOpenGL3_CopyTextureRect(tex, r.x, r.y, r.w, r.h, expand_alpha)));
+        }
         tex->SetStatus(ImTextureStatus_OK);
         GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
     }
@@ -734,6 +1463,269 @@ static bool CheckProgram(GLuint handle, const char* desc)
     return (GLboolean)status == GL_TRUE;
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+// Unit meshes are centred on the origin with a half extent of 1. Each vertex stores its direction from the centre,
+// then -0.5 on the solid edge or +0.5 on the transparent edge of the anti-aliasing fringe, scaled by FringeScale.
+// This matches the fringe of ImDrawList's own anti-aliased fills.
+static void ImGui_ImplOpenGL3_CreateUnitMeshes(ImGui_ImplOpenGL3_Data* bd)
+{
+    ImVector<float> vtx;
+    ImVector<ImU16> idx;
+    auto add_vtx = [&vtx](float x, float y, float edge) { vtx.push_back(x); vtx.push_back(y); vtx.push_back(edge); };
+    auto add_tri = [&idx](int a, int b, int c) { idx.push_back((ImU16)a); idx.push_back((ImU16)b); idx.push_back((ImU16)c); };
+
+    // Rect: the plain quad comes first so the same indices serve both meshes
+    static const float corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+    for (int edge = 0; edge < 2; edge++)
+        for (const auto& corner : corners)
+            add_vtx(corner[0], corner[1], edge == 0 ? -0.5f : 0.5f);
+    add_tri(0, 1, 2);
+    add_tri(0, 2, 3);
+    for (int i = 0; i < 4; i++)
+    {
+        const int j = (i + 1) % 4;
+        add_tri(i, j, 4 + j);
+        add_tri(i, 4 + j, 4 + i);
+    }
+    bd->UnitMeshes[0].IdxOffset = 0;
+    bd->UnitMeshes[0].IdxCount = idx.Size;
+    bd->UnitMeshes[1].IdxOffset = 0;
+    bd->UnitMeshes[1].IdxCount = 6;
+
+    // Circles: centre, solid ring, transparent ring
+    for (int lod = 0; lod < IM_COUNTOF(ImGui_ImplOpenGL3_CircleSegments); lod++)
+    {
+        const int segments = ImGui_ImplOpenGL3_CircleSegments[lod];
+        const int centre = vtx.Size / 3;
+        const int idx_offset = idx.Size;
+        add_vtx(0.0f, 0.0f, 0.0f);
+        for (int edge = 0; edge < 2; edge++)
+            for (int i = 0; i < segments; i++)
+            {
+                const float a = (float)i * 2.0f * 3.14159265358979323846f / (float)segments;
+                add_vtx(cosf(a), sinf(a), edge == 0 ? -0.5f : 0.5f);
+            }
+        for (int i = 0; i < segments; i++)
+        {
+            const int inner_a = centre + 1 + i, inner_b = centre + 1 + (i + 1) % segments;
+            add_tri(centre, inner_a, inner_b);
+            add_tri(inner_a, inner_b, inner_b + segments);
+            add_tri(inner_a, inner_b + segments, inner_a + segments);
+        }
+        bd->UnitMeshes[2 + lod].IdxOffset = (GLintptr)idx_offset * (int)sizeof(ImU16);
+        bd->UnitMeshes[2 + lod].IdxCount = idx.Size - idx_offset;
+    }
+
+    // Both are uploaded through GL_ARRAY_BUFFER, so that no vertex array object gets an element buffer attached here
+    glGenBuffers(1, &bd->UnitVboHandle);
+    glGenBuffers(1, &bd->UnitElementsHandle);
+    glGenBuffers(1, &bd->InstVboHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->UnitVboHandle);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vtx.size_in_bytes(), vtx.Data, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->UnitElementsHandle);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)idx.size_in_bytes(), idx.Data, GL_STATIC_DRAW);
+}
+
+// Returns 0 on failure. Attributes are bound to locations 0, 1, 2.. in order.
+static GLuint ImGui_ImplOpenGL3_CreateShapeProgram(int glsl_version, const GLchar* vertex_shader, const GLchar* fragment_shader, const char* const* attribs, int attribs_count, const char* desc)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    // Shape shaders are valid for GLSL 130 and above, GLSL 300 es additionally needs default precisions.
+    // Fragments of analytic shapes hold positions in pixels, which mediump can't represent accurately.
+    const GLchar* vertex_precision = (glsl_version == 300) ? "precision highp float;\n" : "";
+    const GLchar* fragment_precision = (glsl_version == 300) ? "precision highp float;\n" : "";
+    const GLchar* vertex_shader_with_version[3] = { bd->GlslVersionString, vertex_precision, vertex_shader };
+    const GLchar* fragment_shader_with_version[3] = { bd->GlslVersionString, fragment_precision, fragment_shader };
+
+    GLuint program = 0;
+    GLuint vert_handle = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vert_handle, 3, vertex_shader_with_version, nullptr);
+    glCompileShader(vert_handle);
+    GLuint frag_handle = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(frag_handle, 3, fragment_shader_with_version, nullptr);
+    glCompileShader(frag_handle);
+    const bool compiled = CheckShader(vert_handle, desc) && CheckShader(frag_handle, desc);
+    if (compiled)
+    {
+        program = glCreateProgram();
+        glAttachShader(program, vert_handle);
+        glAttachShader(program, frag_handle);
+        for (int n = 0; n < attribs_count; n++)
+            glBindAttribLocation(program, (GLuint)n, attribs[n]);
+        glLinkProgram(program);
+        glDetachShader(program, vert_handle);
+        glDetachShader(program, frag_handle);
+    }
+    glDeleteShader(vert_handle);
+    glDeleteShader(frag_handle);
+    if (!compiled || !CheckProgram(program, desc))
+    {
+        if (program) { glDeleteProgram(program); }
+        return 0;
+    }
+    return program;
+}
+
+static bool ImGui_ImplOpenGL3_CreateShapeObjects(int glsl_version)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    const GLchar* inst_vertex_shader =
+        "uniform mat4 ProjMtx;\n"
+        "uniform float FringeScale;\n"
+        "in vec3 UnitPos;\n"
+        "in vec2 InstPos;\n"
+        "in vec2 InstSize;\n"
+        "in vec4 InstColor;\n"
+        "out vec2 Frag_UV;\n"
+        "out vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    Frag_UV = UnitPos.xy * 0.5 + 0.5;\n"
+        "    Frag_Color = vec4(InstColor.rgb, UnitPos.z > 0.0 ? 0.0 : InstColor.a);\n"
+        "    gl_Position = ProjMtx * vec4(InstPos + UnitPos.xy * (InstSize + UnitPos.z * FringeScale), 0, 1);\n"
+        "}\n";
+
+    const GLchar* inst_fragment_shader =
+        "uniform sampler2D Texture;\n"
+        "uniform float Textured;\n"
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "out vec4 Out_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    Out_Color = Frag_Color * mix(vec4(1.0), texture(Texture, Frag_UV.st), Textured);\n"
+        "}\n";
+
+    // The quad covers the shape, its outline and one fringe width of margin.
+    // Frag_Local is the position in the frame of the shape, in the same units as the draw list.
+    const GLchar* sdf_vertex_shader =
+        "uniform mat4 ProjMtx;\n"
+        "uniform float FringeScale;\n"
+        "in vec3 UnitPos;\n"
+        "in vec2 InstPos;\n"
+        "in vec2 InstSize;\n"
+        "in vec2 InstAxis;\n"
+        "in vec2 InstRoundingThickness;\n"
+        "in vec4 InstColor;\n"
+        "out vec2 Frag_Local;\n"
+        "out vec2 Frag_Size;\n"
+        "out vec2 Frag_RoundingThickness;\n"
+        "out vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    Frag_Local = UnitPos.xy * (InstSize + InstRoundingThickness.y * 0.5 + max(FringeScale, 1.0));\n"
+        "    Frag_Size = InstSize;\n"
+        "    Frag_RoundingThickness = vec2(min(InstRoundingThickness.x, min(InstSize.x, InstSize.y)), InstRoundingThickness.y);\n"
+        "    Frag_Color = InstColor;\n"
+        "    vec2 pos = InstPos + InstAxis * Frag_Local.x + vec2(-InstAxis.y, InstAxis.x) * Frag_Local.y;\n"
+        "    gl_Position = ProjMtx * vec4(pos, 0, 1);\n"
+        "}\n";
+
+    // Signed distance to a rounded box, then to its outline. The fringe is centred on the edge like ImDrawList's.
+    const GLchar* sdf_fragment_shader =
+        "uniform float FringeScale;\n"
+        "in vec2 Frag_Local;\n"
+        "in vec2 Frag_Size;\n"
+        "in vec2 Frag_RoundingThickness;\n"
+        "in vec4 Frag_Color;\n"
+        "out vec4 Out_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    float rounding = Frag_RoundingThickness.x;\n"
+        "    vec2 q = abs(Frag_Local) - Frag_Size + rounding;\n"
+        "    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - rounding;\n"
+        "    if (Frag_RoundingThickness.y > 0.0)\n"
+        "        d = abs(d) - Frag_RoundingThickness.y * 0.5;\n"
+        "    float coverage = FringeScale > 0.0 ? clamp(0.5 - d / FringeScale, 0.0, 1.0) : (d <= 0.0 ? 1.0 : 0.0);\n"
+        "    if (coverage <= 0.0)\n"
+        "        discard;\n"
+        "    Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * coverage);\n"
+        "}\n";
+
+    static const char* const inst_attribs[] = { "UnitPos", "InstPos", "InstSize", "InstColor" };
+    static const char* const sdf_attribs[] = { "UnitPos", "InstPos", "InstSize", "InstAxis", "InstRoundingThickness", "InstColor" };
+    bd->InstShaderHandle = ImGui_ImplOpenGL3_CreateShapeProgram(glsl_version, inst_vertex_shader, inst_fragment_shader, inst_attribs, IM_COUNTOF(inst_attribs), "instance shader");
+    bd->SdfShaderHandle = ImGui_ImplOpenGL3_CreateShapeProgram(glsl_version, sdf_vertex_shader, sdf_fragment_shader, sdf_attribs, IM_COUNTOF(sdf_attribs), "analytic shape shader");
+    if (bd->InstShaderHandle == 0 || bd->SdfShaderHandle == 0)
+    {
+        // Shapes will be tessellated instead
+        if (bd->InstShaderHandle) { glDeleteProgram(bd->InstShaderHandle); bd->InstShaderHandle = 0; }
+        if (bd->SdfShaderHandle) { glDeleteProgram(bd->SdfShaderHandle); bd->SdfShaderHandle = 0; }
+        return false;
+    }
+
+    bd->InstAttribLocationTex = glGetUniformLocation(bd->InstShaderHandle, "Texture");
+    bd->InstAttribLocationProjMtx = glGetUniformLocation(bd->InstShaderHandle, "ProjMtx");
+    bd->InstAttribLocationFringeScale = glGetUniformLocation(bd->InstShaderHandle, "FringeScale");
+    bd->InstAttribLocationTextured = glGetUniformLocation(bd->InstShaderHandle, "Textured");
+    bd->SdfAttribLocationProjMtx = glGetUniformLocation(bd->SdfShaderHandle, "ProjMtx");
+    bd->SdfAttribLocationFringeScale = glGetUniformLocation(bd->SdfShaderHandle, "FringeScale");
+    ImGui_ImplOpenGL3_CreateUnitMeshes(bd);
+    return true;
+}
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+// Signed distance field text: the vertex shader and the attribute locations of the main shader, with a fragment shader
+// thresholding the field at its on-edge value (128) and anti-aliasing over the screen space rate of change of the field.
+// The white pixel of the atlas is past the threshold everywhere, vertex colors keep their alpha.
+static bool ImGui_ImplOpenGL3_CreateSdfTextObjects(int glsl_version, const GLchar* vertex_shader)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    const GLchar* fragment_output =
+        (glsl_version >= 410) ? "layout (location = 0) out vec4 Out_Color;\n" :
+        (glsl_version == 300) ? "precision mediump float;\nlayout (location = 0) out vec4 Out_Color;\n" :
+        "out vec4 Out_Color;\n";
+    const GLchar* fragment_shader =
+        "uniform sampler2D Texture;\n"
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    float dist = texture(Texture, Frag_UV.st).a - 128.0 / 255.0;\n"
+        "    float alpha = clamp(dist / max(fwidth(dist), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * alpha);\n"
+        "}\n";
+    const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
+    const GLchar* fragment_shader_with_version[3] = { bd->GlslVersionString, fragment_output, fragment_shader };
+
+    GLuint vert_handle = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
+    glCompileShader(vert_handle);
+    GLuint frag_handle = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(frag_handle, 3, fragment_shader_with_version, nullptr);
+    glCompileShader(frag_handle);
+    const bool compiled = CheckShader(vert_handle, "SDF text shader") && CheckShader(frag_handle, "SDF text shader");
+    GLuint program = 0;
+    if (compiled)
+    {
+        program = glCreateProgram();
+        glAttachShader(program, vert_handle);
+        glAttachShader(program, frag_handle);
+        glBindAttribLocation(program, bd->AttribLocationVtxPos, "Position");
+        glBindAttribLocation(program, bd->AttribLocationVtxUV, "UV");
+        glBindAttribLocation(program, bd->AttribLocationVtxColor, "Color");
+        glLinkProgram(program);
+        glDetachShader(program, vert_handle);
+        glDetachShader(program, frag_handle);
+    }
+    glDeleteShader(vert_handle);
+    glDeleteShader(frag_handle);
+    if (!compiled || !CheckProgram(program, "SDF text shader"))
+    {
+        if (program) { glDeleteProgram(program); }
+        return false;
+    }
+    bd->SdfTextShaderHandle = program;
+    bd->SdfTextAttribLocationTex = glGetUniformLocation(program, "Texture");
+    bd->SdfTextAttribLocationProjMtx = glGetUniformLocation(program, "ProjMtx");
+    return true;
+}
+#endif
+
 bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 {
     ImGui_ImplOpenGL3_InitLoader();
@@ -920,6 +1912,15 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     glGenBuffers(1, &bd->VboHandle);
     glGenBuffers(1, &bd->ElementsHandle);
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (bd->HasInstancing)
+        bd->HasInstancing = (glsl_version >= 130) && ImGui_ImplOpenGL3_CreateShapeObjects(glsl_version);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+    if (bd->HasSdfText)
+        bd->HasSdfText = ImGui_ImplOpenGL3_CreateSdfTextObjects(glsl_version, vertex_shader);
+#endif
+
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->HasBindSampler)
     {
@@ -953,10 +1954,31 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->TexSamplers[0]) { glDeleteSamplers(2, &bd->TexSamplers[0]); bd->TexSamplers[0] = bd->TexSamplers[1] = 0; }
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    for (GLsync& fence : bd->RingFences)
+        if (fence != nullptr) { glDeleteSync(fence); fence = nullptr; }
+#endif
+    bd->RingVtxData = bd->RingIdxData = nullptr;
+    bd->RingVtxRegion = bd->RingIdxRegion = 0;
+    bd->VertexBufferSize = bd->IndexBufferSize = 0;
+    bd->VtxHead = bd->IdxHead = 0;
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    if (bd->VaoHandle)      { glDeleteVertexArrays(1, &bd->VaoHandle); bd->VaoHandle = 0; }
 #endif
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (bd->InstVaoHandle)  { glDeleteVertexArrays(1, &bd->InstVaoHandle); bd->InstVaoHandle = 0; }
+    if (bd->SdfVaoHandle)   { glDeleteVertexArrays(1, &bd->SdfVaoHandle); bd->SdfVaoHandle = 0; }
+#endif
+    if (bd->InstVboHandle)  { glDeleteBuffers(1, &bd->InstVboHandle); bd->InstVboHandle = 0; }
+    if (bd->UnitVboHandle)  { glDeleteBuffers(1, &bd->UnitVboHandle); bd->UnitVboHandle = 0; }
+    if (bd->UnitElementsHandle) { glDeleteBuffers(1, &bd->UnitElementsHandle); bd->UnitElementsHandle = 0; }
+    if (bd->InstShaderHandle) { glDeleteProgram(bd->InstShaderHandle); bd->InstShaderHandle = 0; }
+    if (bd->SdfShaderHandle) { glDeleteProgram(bd->SdfShaderHandle); bd->SdfShaderHandle = 0; }
+    if (bd->SdfTextShaderHandle) { glDeleteProgram(bd->SdfTextShaderHandle); bd->SdfTextShaderHandle = 0; }
 
     // Destroy all textures
     for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
@@ -1068,6 +2090,22 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     bd->HasBindSampler = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
 #endif
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    bd->HasInstancing = (bd->GlVersion >= 330 || bd->GlProfileIsES3); // Cleared again if the instance shader fails to build
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+    int glsl_version_number = 130;
+    sscanf(bd->GlslVersionString, "#version %d", &glsl_version_number);
+    bd->HasSdfText = (glsl_version_number >= 130); // Needs fwidth(). Cleared again if the SDF text shader fails to build
+#endif
+    bd->HasMapBufferRange = (bd->GlVersion >= 300 || bd->GlProfileIsES3) && !bd->GlProfileIsES2;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    bd->HasTextureSwizzle = (bd->GlVersion >= 330 || bd->GlProfileIsES3) && !bd->GlProfileIsES2;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    bd->UseBaseVertex = (bd->GlVersion >= 320);
+#endif
+    bool has_buffer_storage = (bd->GlVersion >= 440 && !bd->GlProfileIsES3);
 #ifdef IMGUI_IMPL_OPENGL_HAS_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -1076,10 +2114,286 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+        if (extension != nullptr && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            has_buffer_storage = true;
+    }
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (has_buffer_storage)
+        bd->BufferStorage = (PFNIMGUIGLBUFFERSTORAGEPROC)gl3wGetProcAddress("glBufferStorage");
+#endif
+    IM_UNUSED(has_buffer_storage);
+
+#ifdef IMGUI_COMPACT_DRAWVERT
+    // Vertices are written while the frame is built, possibly while a render thread draws the previous one: the step is
+    // taken from the display size when the frame begins, RenderDrawData() finds it again from draw_data->DisplaySize.
+    ImGuiContextHook pos_step_hook;
+    pos_step_hook.Type = ImGuiContextHookType_NewFramePre;
+    pos_step_hook.Callback = [](ImGuiContext* ctx, ImGuiContextHook*) { ImDrawVertPosOne() = ImDrawVertPosOneFor(ctx->IO.DisplaySize); };
+    bd->PosStepHookId = ImGui::AddContextHook(ImGui::GetCurrentContext(), &pos_step_hook);
+#endif
+
+    return true;
+}
+
+ImGui_ImplOpenGL3_UploadMode ImGui_ImplOpenGL3_SetUploadMode(ImGui_ImplOpenGL3_UploadMode mode)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+
+    // Fall back to the next best mode the context supports
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (mode == ImGui_ImplOpenGL3_UploadMode_PersistentRing && bd->BufferStorage == nullptr)
+#else
+    if (mode == ImGui_ImplOpenGL3_UploadMode_PersistentRing)
+#endif
+        mode = ImGui_ImplOpenGL3_UploadMode_MapRange;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    if (mode == ImGui_ImplOpenGL3_UploadMode_MapRange && !bd->HasMapBufferRange)
+#else
+    if (mode == ImGui_ImplOpenGL3_UploadMode_MapRange)
+#endif
+        mode = ImGui_ImplOpenGL3_UploadMode_BufferData;
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MAP_BUFFER_RANGE
+    if (mode != bd->UploadMode)
+    {
+        GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+        ImGui_ImplOpenGL3_DestroyStreamingBuffers(bd);
+        glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+    }
+#endif
+    bd->UploadMode = mode;
+    return mode;
+}
+
+ImGui_ImplOpenGL3_UploadMode ImGui_ImplOpenGL3_GetUploadMode()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->UploadMode;
+}
+
+void ImGui_ImplOpenGL3_SetMergeDrawLists(bool enabled)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->MergeDrawLists = enabled;
+    if (!enabled)
+        bd->MergeBuffer.clear();
+}
+
+bool ImGui_ImplOpenGL3_GetMergeDrawLists()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->MergeDrawLists;
+}
+
+void ImGui_ImplOpenGL3_SetExclusiveContext(bool exclusive)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    if (!exclusive && bd->VaoHandle != 0)
+    {
+        glDeleteVertexArrays(1, &bd->VaoHandle);
+        bd->VaoHandle = 0;
+    }
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (!exclusive && bd->InstVaoHandle != 0)
+    {
+        glDeleteVertexArrays(1, &bd->InstVaoHandle);
+        bd->InstVaoHandle = 0;
+    }
+    if (!exclusive && bd->SdfVaoHandle != 0)
+    {
+        glDeleteVertexArrays(1, &bd->SdfVaoHandle);
+        bd->SdfVaoHandle = 0;
+    }
+#endif
+    bd->ExclusiveContext = exclusive;
+}
+
+bool ImGui_ImplOpenGL3_HasInstancing()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->HasInstancing;
+}
+
+// The batch and its instances are appended to the callback data of 'draw_list', no backend state is written: call it from the thread
+// building the draw list. Whether to batch is decided from the device objects, which only ImGui_ImplOpenGL3_NewFrame() creates.
+void ImGui_ImplOpenGL3_AddShapeInstances(ImDrawList* draw_list, ImGui_ImplOpenGL3_Shape shape, const ImGui_ImplOpenGL3_ShapeInstance* instances, int count, ImTextureID tex_id)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    if (count <= 0)
+        return;
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Before the first NewFrame() the device objects don't exist yet, tessellate
+    if (bd->HasInstancing && bd->InstShaderHandle != 0)
+    {
+        ImGui_ImplOpenGL3_ShapeBatch batch;
+        batch.TexID = tex_id;
+        batch.Count = count;
+        // Like ImDrawList::AddImage(), textures are mapped without fringe
+        const bool anti_aliased = (tex_id == ImTextureID_Invalid) && (draw_list->Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+        batch.FringeScale = anti_aliased ? draw_list->_FringeScale : 0.0f;
+        if (shape == ImGui_ImplOpenGL3_Shape_Circle)
+        {
+            float max_radius = 0.0f;
+            for (int n = 0; n < count; n++)
+            {
+                const ImVec2 size = instances[n].Size;
+                const float radius = size.x > size.y ? size.x : size.y;
+                if (radius > max_radius)
+                    max_radius = radius;
+            }
+            const int segments = draw_list->_CalcCircleAutoSegmentCount(max_radius);
+            int lod = 0;
+            while (lod + 1 < IM_COUNTOF(ImGui_ImplOpenGL3_CircleSegments) && ImGui_ImplOpenGL3_CircleSegments[lod] < segments)
+                lod++;
+            batch.Mesh = 2 + lod;
+        }
+        else
+        {
+            batch.Mesh = anti_aliased ? 0 : 1;
+        }
+        // AddCallback() copies the header and leaves an empty command after the callback: append the instances to its payload
+        draw_list->AddCallback(ImGui_ImplOpenGL3_DrawCallback_Shapes, &batch, sizeof(batch));
+        ImDrawCmd& cmd = draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 2];
+        const int instances_size = count * (int)sizeof(ImGui_ImplOpenGL3_ShapeInstance);
+        draw_list->_CallbacksDataBuf.resize(draw_list->_CallbacksDataBuf.Size + instances_size);
+        memcpy(draw_list->_CallbacksDataBuf.Data + cmd.UserCallbackDataOffset + sizeof(batch), instances, (size_t)instances_size);
+        cmd.UserCallbackDataSize += instances_size;
+        return;
+    }
+#endif
+
+    for (int n = 0; n < count; n++)
+    {
+        const ImGui_ImplOpenGL3_ShapeInstance& inst = instances[n];
+        const ImVec2 p_min(inst.Pos.x - inst.Size.x, inst.Pos.y - inst.Size.y);
+        const ImVec2 p_max(inst.Pos.x + inst.Size.x, inst.Pos.y + inst.Size.y);
+        if (shape == ImGui_ImplOpenGL3_Shape_Circle)
+            draw_list->AddEllipseFilled(inst.Pos, inst.Size, inst.Col);
+        else if (tex_id != ImTextureID_Invalid)
+            draw_list->AddImage(tex_id, p_min, p_max, ImVec2(0, 0), ImVec2(1, 1), inst.Col);
+        else
+            draw_list->AddRectFilled(p_min, p_max, inst.Col);
+    }
+}
+
+// Grows the payload of the previous shape's callback when nothing was drawn in between, so 'draw_list' must still be the one
+// being built, from its own thread. Returns false without the SDF shader, before the first ImGui_ImplOpenGL3_NewFrame() included.
+bool ImGui_ImplOpenGL3_AddSdfShape(ImDrawList* draw_list, const ImGui_ImplOpenGL3_SdfShape& shape)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (!bd->HasInstancing || bd->SdfShaderHandle == 0)
+        return false;
+    if ((shape.Col & IM_COL32_A_MASK) == 0)
+        return true;
+
+    ImGui_ImplOpenGL3_SdfBatch batch;
+    batch.Count = 1;
+    batch.FringeScale = (draw_list->Flags & ImDrawListFlags_AntiAliasedFill) ? draw_list->_FringeScale : 0.0f;
+
+    // AddCallback() leaves an empty command after the callback. While nothing else was drawn since the previous shape,
+    // the same clipping rectangle is set and its payload is the last one, append to it rather than adding a draw call.
+    ImVector<ImDrawCmd>& cmds = draw_list->CmdBuffer;
+    if (cmds.Size >= 2)
+    {
+        ImDrawCmd& prev_cmd = cmds.Data[cmds.Size - 2];
+        const ImDrawCmd& curr_cmd = cmds.Data[cmds.Size - 1];
+        if (prev_cmd.UserCallback == ImGui_ImplOpenGL3_DrawCallback_SdfShapes && curr_cmd.UserCallback == nullptr && curr_cmd.ElemCount == 0
+            && memcmp(&prev_cmd.ClipRect, &curr_cmd.ClipRect, sizeof(ImVec4)) == 0
+            && prev_cmd.UserCallbackDataOffset + prev_cmd.UserCallbackDataSize == draw_list->_CallbacksDataBuf.Size)
+        {
+            unsigned char* header = draw_list->_CallbacksDataBuf.Data + prev_cmd.UserCallbackDataOffset;
+            ImGui_ImplOpenGL3_SdfBatch prev_batch;
+            memcpy(&prev_batch, header, sizeof(prev_batch));
+            if (prev_batch.FringeScale == batch.FringeScale)
+            {
+                prev_batch.Count++;
+                memcpy(header, &prev_batch, sizeof(prev_batch));
+                draw_list->_CallbacksDataBuf.resize(draw_list->_CallbacksDataBuf.Size + (int)sizeof(shape));
+                memcpy(draw_list->_CallbacksDataBuf.Data + draw_list->_CallbacksDataBuf.Size - sizeof(shape), &shape, sizeof(shape));
+                prev_cmd.UserCallbackDataSize += (int)sizeof(shape);
+                return true;
+            }
+        }
     }
+
+    char payload[sizeof(batch) + sizeof(shape)];
+    memcpy(payload, &batch, sizeof(batch));
+    memcpy(payload + sizeof(batch), &shape, sizeof(shape));
+    draw_list->AddCallback(ImGui_ImplOpenGL3_DrawCallback_SdfShapes, payload, sizeof(payload));
+    return true;
+#else
+    IM_UNUSED(draw_list);
+    IM_UNUSED(shape);
+    return false;
 #endif
+}
+
+bool ImGui_ImplOpenGL3_HasSdfText()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->HasSdfText;
+}
 
+// May take back the pop of the previous SDF text of 'draw_list' so both texts share a draw call: call it from the thread building
+// the list, right before the text it applies to, and match it with ImGui_ImplOpenGL3_PopSdfText() after that text.
+bool ImGui_ImplOpenGL3_PushSdfText(ImDrawList* draw_list)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+    if (!bd->HasSdfText || bd->SdfTextShaderHandle == 0)
+        return false;
+
+    // AddCallback() leaves an empty command after the callback. While nothing was drawn since the previous SDF text
+    // and the same clipping rectangle and texture are set, drop its pop instead: both texts end up in the same draw call.
+    ImVector<ImDrawCmd>& cmds = draw_list->CmdBuffer;
+    if (cmds.Size >= 2)
+    {
+        ImDrawCmd& prev_cmd = cmds.Data[cmds.Size - 2];
+        const ImDrawCmd& curr_cmd = cmds.Data[cmds.Size - 1];
+        if (prev_cmd.UserCallback == ImGui_ImplOpenGL3_DrawCallback_PopSdfText && curr_cmd.UserCallback == nullptr && curr_cmd.ElemCount == 0
+            && memcmp(&prev_cmd.ClipRect, &curr_cmd.ClipRect, sizeof(ImVec4)) == 0 && memcmp(&prev_cmd.TexRef, &curr_cmd.TexRef, sizeof(ImTextureRef)) == 0
+            && prev_cmd.VtxOffset == curr_cmd.VtxOffset && prev_cmd.IdxOffset == curr_cmd.IdxOffset)
+        {
+            prev_cmd.UserCallback = nullptr;
+            prev_cmd.UserCallbackData = nullptr;
+            prev_cmd.UserCallbackDataSize = 0;
+            prev_cmd.UserCallbackDataOffset = -1;
+            cmds.pop_back();
+            if (cmds.Size >= 2)
+                draw_list->_TryMergeDrawCmds(); // Back to the command holding the previous text, which then grows
+            return true;
+        }
+    }
+    draw_list->AddCallback(ImGui_ImplOpenGL3_DrawCallback_PushSdfText, nullptr);
     return true;
+#else
+    IM_UNUSED(draw_list);
+    return false;
+#endif
+}
+
+void ImGui_ImplOpenGL3_PopSdfText(ImDrawList* draw_list)
+{
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_SDF_TEXT
+    draw_list->AddCallback(ImGui_ImplOpenGL3_DrawCallback_PopSdfText, nullptr);
+#else
+    IM_UNUSED(draw_list);
+#endif
 }
 
 void    ImGui_ImplOpenGL3_Shutdown()
@@ -1090,6 +2404,9 @@ void    ImGui_ImplOpenGL3_Shutdown()
     ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
 
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
+#ifdef IMGUI_COMPACT_DRAWVERT
+    ImGui::RemoveContextHook(ImGui::GetCurrentContext(), bd->PosStepHookId);
+#endif
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
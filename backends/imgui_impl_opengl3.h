@@ -7,6 +7,8 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
 //  [x] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset) [Desktop OpenGL only!]
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Instanced rectangles and circles, see ImGui_ImplOpenGL3_AddShapeInstances().
+//  [X] Renderer: Analytic circles, rings, rounded rectangles and capsules, see ImGui_ImplOpenGL3_AddSdfShape().
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -43,6 +45,66 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 // (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = nullptr to handle this manually.
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex);
 
+// (Optional) Vertex/index upload strategy. Call after Init() with the GL context current.
+// Unsupported modes fall back to the next best one, the mode actually used is returned.
+enum ImGui_ImplOpenGL3_UploadMode
+{
+    ImGui_ImplOpenGL3_UploadMode_BufferData = 0,    // glBufferData() for every draw list (default)
+    ImGui_ImplOpenGL3_UploadMode_MapRange,          // Unsynchronized glMapBufferRange() into an orphaned stream buffer (GL 3.0+, GL ES 3.0+)
+    ImGui_ImplOpenGL3_UploadMode_PersistentRing,    // Persistently-mapped ring buffer guarded by fences (GL 4.4+ or GL_ARB_buffer_storage, gl3w loader)
+};
+IMGUI_IMPL_API ImGui_ImplOpenGL3_UploadMode ImGui_ImplOpenGL3_SetUploadMode(ImGui_ImplOpenGL3_UploadMode mode);
+IMGUI_IMPL_API ImGui_ImplOpenGL3_UploadMode ImGui_ImplOpenGL3_GetUploadMode();
+
+// (Optional) Concatenate the vertices/indices of every draw list and upload them once per frame, in any upload mode.
+// Draw lists are then addressed with glDrawElementsBaseVertex() (GL 3.2+), or by re-pointing vertex attributes.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetMergeDrawLists(bool enabled);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_GetMergeDrawLists();
+
+// (Optional) Declare that nothing else renders with this GL context. RenderDrawData() then neither saves nor restores
+// the GL state it touches (about 30 glGet/glIsEnabled round trips per frame) and keeps its vertex array object between frames.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetExclusiveContext(bool exclusive);
+
+// (Optional) Instanced shapes: many copies of a unit shape drawn by a single glDrawElementsInstanced() (GL 3.3+ or GL ES 3.0+, not with the stripped loader).
+// Only the instances are stored in the draw list (20 bytes each) instead of the tessellated vertices and indices.
+// Without instancing support the shapes are tessellated into the draw list, so the call can always be made.
+enum ImGui_ImplOpenGL3_Shape
+{
+    ImGui_ImplOpenGL3_Shape_Rect = 0,       // Axis-aligned rectangle, mapped with the whole texture if one is given
+    ImGui_ImplOpenGL3_Shape_Circle,         // Filled circle or ellipse
+};
+struct ImGui_ImplOpenGL3_ShapeInstance
+{
+    ImVec2  Pos;                            // Centre
+    ImVec2  Size;                           // Half extent, i.e. the radius for circles
+    ImU32   Col;
+};
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_AddShapeInstances(ImDrawList* draw_list, ImGui_ImplOpenGL3_Shape shape, const ImGui_ImplOpenGL3_ShapeInstance* instances, int count, ImTextureID tex_id = ImTextureID_Invalid);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_HasInstancing();
+
+// (Optional) Analytic shapes: one quad per shape, whose fragment shader evaluates the signed distance to a rounded box
+// and anti-aliases its edge, instead of tessellating arcs. Requires instancing support, see above.
+// Shapes added one after another to a draw list are drawn together by a single glDrawElementsInstanced().
+// Returns false when unsupported, the caller should then tessellate the shape with ImDrawList.
+struct ImGui_ImplOpenGL3_SdfShape
+{
+    ImVec2  Pos;                            // Centre
+    ImVec2  Size;                           // Half extent along Axis, then across it
+    ImVec2  Axis;                           // Unit vector, (1, 0) for axis-aligned shapes
+    float   Rounding;                       // Corner radius, clamped to the smaller half extent: circles and capsules use Size.y
+    float   Thickness;                      // Outline centred on the edge, 0 to fill the shape
+    ImU32   Col;
+};
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_AddSdfShape(ImDrawList* draw_list, const ImGui_ImplOpenGL3_SdfShape& shape);
+
+// (Optional) Signed distance field text: between Push and Pop, the draw list is drawn with a shader which reads the alpha
+// of the texture as a distance field with its edge at 128, as baked by stbtt_GetGlyphSDF(), and anti-aliases that edge at
+// any scale. Only push around text of fonts baked as distance fields. Requires GLSL 130+, not with the stripped loader.
+// Texts pushed one after another share a draw call. Push returns false when unsupported, Pop must then not be called.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_HasSdfText();
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_PushSdfText(ImDrawList* draw_list);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_PopSdfText(ImDrawList* draw_list);
+
 // Configuration flags to add in your imconfig file:
 //#define IMGUI_IMPL_OPENGL_ES2     // Enable ES 2 (Auto-detected on Emscripten)
 //#define IMGUI_IMPL_OPENGL_ES3     // Enable ES 3 (Auto-detected on iOS/Android)
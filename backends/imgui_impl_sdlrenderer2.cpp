@@ -13,7 +13,9 @@
 //  [X] Renderer: User texture binding. Use 'SDL_Texture*' as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Alpha8 textures, expanded to RGBA on upload as SDL_Renderer has no alpha-only texture format.
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+//  [X] Renderer: Exact vertex ranges per command, consecutive commands with the same texture and clip rectangle are merged into one SDL_RenderGeometryRaw() call.
 // Missing features or Issues:
 //  [ ] Renderer: Missing support for DrawCallback_SetSamplerLinear, DrawCallback_SetSamplerNearest callbacks: SDLRenderer2 does not support changing SDL_SCALE_MODE while rendering.
 
@@ -45,6 +47,8 @@
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_sdlrenderer2.h"
 #include <stdint.h>     // intptr_t
+#include <limits.h>     // INT_MAX
+#include <string.h>     // memcpy
 
 // Clang warnings with -Weverything
 #if defined(__clang__)
@@ -64,6 +68,10 @@
 struct ImGui_ImplSDLRenderer2_Data
 {
     SDL_Renderer*   Renderer;       // Main viewport's renderer
+    bool            Exclusive;      // See ImGui_ImplSDLRenderer2_SetExclusiveRenderer()
+    ImVector<ImDrawVert> BatchVtx;  // Vertices of a batch spanning several draw lists
+    ImVector<int>   BatchIdx;       // Indices of the current batch, rebased to its first vertex
+    ImVector<ImU32> TexPixels;      // Alpha8 pixels expanded to RGBA for upload
 
     ImGui_ImplSDLRenderer2_Data()   { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -94,6 +102,118 @@ void ImGui_ImplSDLRenderer2_NewFrame()
 // Draw callbacks
 static void ImGui_ImplSDLRenderer2_DrawCallback_ResetRenderState(const ImDrawList*, const ImDrawCmd*) {} // Intentionally empty. Used as an identifier for rendering loop to call its code. Simpler to implement this way.
 
+// Consecutive commands sharing texture and clip rectangle are submitted with a single SDL_RenderGeometryRaw() call.
+// Only the vertex range actually referenced by the indices is passed: SDL walks every vertex it is given, handing it
+// the rest of the draw list for each command made the cost O(commands x vertices).
+struct ImGui_ImplSDLRenderer2_Batch
+{
+    SDL_Texture*        Texture;
+    SDL_Rect            ClipRect;
+    const ImDrawList*   DrawList;   // Owner of the vertices while the batch stays within one draw list, nullptr once copied to BatchVtx
+    int                 VtxMin;     // First vertex of the range, in DrawList->VtxBuffer
+    int                 VtxCount;
+    bool                Pending;
+};
+
+static void ImGui_ImplSDLRenderer2_FlushBatch(ImGui_ImplSDLRenderer2_Data* bd, ImGui_ImplSDLRenderer2_Batch* batch, SDL_Renderer* renderer, SDL_Rect* current_clip)
+{
+    if (!batch->Pending)
+        return;
+    batch->Pending = false;
+    const SDL_Rect& r = batch->ClipRect;
+    if (r.x != current_clip->x || r.y != current_clip->y || r.w != current_clip->w || r.h != current_clip->h)
+    {
+        SDL_RenderSetClipRect(renderer, &r);
+        *current_clip = r;
+    }
+
+    const ImDrawVert* vtx = batch->DrawList ? batch->DrawList->VtxBuffer.Data + batch->VtxMin : bd->BatchVtx.Data;
+    const float* xy = (const float*)(const void*)((const char*)vtx + offsetof(ImDrawVert, pos));
+    const float* uv = (const float*)(const void*)((const char*)vtx + offsetof(ImDrawVert, uv));
+#if SDL_VERSION_ATLEAST(2,0,19)
+    const SDL_Color* color = (const SDL_Color*)(const void*)((const char*)vtx + offsetof(ImDrawVert, col)); // SDL 2.0.19+
+#else
+    const int* color = (const int*)(const void*)((const char*)vtx + offsetof(ImDrawVert, col)); // SDL 2.0.17 and 2.0.18
+#endif
+    SDL_RenderGeometryRaw(renderer, batch->Texture,
+        xy, (int)sizeof(ImDrawVert),
+        color, (int)sizeof(ImDrawVert),
+        uv, (int)sizeof(ImDrawVert),
+        batch->VtxCount,
+        bd->BatchIdx.Data, bd->BatchIdx.Size, (int)sizeof(int));
+}
+
+static void ImGui_ImplSDLRenderer2_AddToBatch(ImGui_ImplSDLRenderer2_Data* bd, ImGui_ImplSDLRenderer2_Batch* batch, SDL_Renderer* renderer, SDL_Rect* current_clip,
+                                              const ImDrawList* draw_list, const ImDrawCmd* pcmd, SDL_Texture* tex, const SDL_Rect& clip)
+{
+    if (pcmd->ElemCount == 0)
+        return;
+
+    // Exact range of vertices used by this command
+    const ImDrawIdx* idx_buffer = draw_list->IdxBuffer.Data + pcmd->IdxOffset;
+    int vtx_min = INT_MAX, vtx_max = 0;
+    for (unsigned int i = 0; i < pcmd->ElemCount; i++)
+    {
+        int idx = (int)idx_buffer[i];
+        vtx_min = (idx < vtx_min) ? idx : vtx_min;
+        vtx_max = (idx > vtx_max) ? idx : vtx_max;
+    }
+    vtx_min += (int)pcmd->VtxOffset;
+    vtx_max += (int)pcmd->VtxOffset;
+
+    if (batch->Pending && (batch->Texture != tex || batch->ClipRect.x != clip.x || batch->ClipRect.y != clip.y || batch->ClipRect.w != clip.w || batch->ClipRect.h != clip.h))
+        ImGui_ImplSDLRenderer2_FlushBatch(bd, batch, renderer, current_clip);
+
+    int base; // Index of vertex 'vtx_min' within the batch
+    if (!batch->Pending)
+    {
+        batch->Texture = tex;
+        batch->ClipRect = clip;
+        batch->DrawList = draw_list;
+        batch->VtxMin = vtx_min;
+        batch->VtxCount = vtx_max - vtx_min + 1;
+        batch->Pending = true;
+        bd->BatchIdx.resize(0);
+        base = 0;
+    }
+    else if (batch->DrawList == draw_list)
+    {
+        // Same draw list: widen the range in place. Commands almost always move forward in the vertex buffer.
+        if (vtx_min < batch->VtxMin)
+        {
+            int shift = batch->VtxMin - vtx_min;
+            for (int& idx : bd->BatchIdx)
+                idx += shift;
+            batch->VtxCount += shift;
+            batch->VtxMin = vtx_min;
+        }
+        if (vtx_max - batch->VtxMin + 1 > batch->VtxCount)
+            batch->VtxCount = vtx_max - batch->VtxMin + 1;
+        base = vtx_min - batch->VtxMin;
+    }
+    else
+    {
+        // Crossing into another draw list: gather the vertices of both into BatchVtx
+        if (batch->DrawList != nullptr)
+        {
+            bd->BatchVtx.resize(batch->VtxCount);
+            memcpy(bd->BatchVtx.Data, batch->DrawList->VtxBuffer.Data + batch->VtxMin, (size_t)batch->VtxCount * sizeof(ImDrawVert));
+            batch->DrawList = nullptr;
+        }
+        base = bd->BatchVtx.Size;
+        bd->BatchVtx.resize(base + vtx_max - vtx_min + 1);
+        memcpy(bd->BatchVtx.Data + base, draw_list->VtxBuffer.Data + vtx_min, (size_t)(vtx_max - vtx_min + 1) * sizeof(ImDrawVert));
+        batch->VtxCount = bd->BatchVtx.Size;
+    }
+
+    int rebase = base - vtx_min + (int)pcmd->VtxOffset;
+    int idx_pos = bd->BatchIdx.Size;
+    bd->BatchIdx.resize(idx_pos + (int)pcmd->ElemCount);
+    int* idx_out = bd->BatchIdx.Data + idx_pos;
+    for (unsigned int i = 0; i < pcmd->ElemCount; i++)
+        idx_out[i] = (int)idx_buffer[i] + rebase;
+}
+
 void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer* renderer)
 {
     // If there's a scale factor set by the user, use that instead
@@ -127,9 +247,13 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
         SDL_Rect    ClipRect;
     };
     BackupSDLRendererState old = {};
-    old.ClipEnabled = SDL_RenderIsClipEnabled(renderer) == SDL_TRUE;
-    SDL_RenderGetViewport(renderer, &old.Viewport);
-    SDL_RenderGetClipRect(renderer, &old.ClipRect);
+    ImGui_ImplSDLRenderer2_Data* bd = ImGui_ImplSDLRenderer2_GetBackendData();
+    if (!bd->Exclusive)
+    {
+        old.ClipEnabled = SDL_RenderIsClipEnabled(renderer) == SDL_TRUE;
+        SDL_RenderGetViewport(renderer, &old.Viewport);
+        SDL_RenderGetClipRect(renderer, &old.ClipRect);
+    }
 
     // Setup desired state
     ImGui_ImplSDLRenderer2_SetupRenderState(renderer);
@@ -144,22 +268,25 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = render_scale;
 
+    // Elide redundant clip rect changes between commands. User callbacks may change anything, they reset the cache.
+    SDL_Rect current_clip = { 0, 0, -1, -1 };
+    ImGui_ImplSDLRenderer2_Batch batch = {};
+
     // Render command lists
     for (const ImDrawList* draw_list : draw_data->CmdLists)
     {
-        const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data;
-        const ImDrawIdx* idx_buffer = draw_list->IdxBuffer.Data;
-
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
             if (pcmd->UserCallback)
             {
                 // User callback, registered via ImDrawList::AddCallback()
+                ImGui_ImplSDLRenderer2_FlushBatch(bd, &batch, renderer, &current_clip);
                 if (pcmd->UserCallback == ImGui_ImplSDLRenderer2_DrawCallback_ResetRenderState)
                     ImGui_ImplSDLRenderer2_SetupRenderState(renderer);
                 else
                     pcmd->UserCallback(draw_list, pcmd);
+                current_clip.w = -1;
             }
             else
             {
@@ -174,32 +301,47 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
                     continue;
 
                 SDL_Rect r = { (int)(clip_min.x), (int)(clip_min.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y) };
-                SDL_RenderSetClipRect(renderer, &r);
-
-                const float* xy = (const float*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, pos));
-                const float* uv = (const float*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, uv));
-#if SDL_VERSION_ATLEAST(2,0,19)
-                const SDL_Color* color = (const SDL_Color*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, col)); // SDL 2.0.19+
-#else
-                const int* color = (const int*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, col)); // SDL 2.0.17 and 2.0.18
-#endif
-
-                // Bind texture, Draw
-                SDL_Texture* tex = (SDL_Texture*)pcmd->GetTexID();
-                SDL_RenderGeometryRaw(renderer, tex,
-                    xy, (int)sizeof(ImDrawVert),
-                    color, (int)sizeof(ImDrawVert),
-                    uv, (int)sizeof(ImDrawVert),
-                    draw_list->VtxBuffer.Size - pcmd->VtxOffset,
-                    idx_buffer + pcmd->IdxOffset, pcmd->ElemCount, sizeof(ImDrawIdx));
+                ImGui_ImplSDLRenderer2_AddToBatch(bd, &batch, renderer, &current_clip, draw_list, pcmd, (SDL_Texture*)pcmd->GetTexID(), r);
             }
         }
     }
+    ImGui_ImplSDLRenderer2_FlushBatch(bd, &batch, renderer, &current_clip);
     platform_io.Renderer_RenderState = nullptr;
 
     // Restore modified SDL_Renderer state
-    SDL_RenderSetViewport(renderer, &old.Viewport);
-    SDL_RenderSetClipRect(renderer, old.ClipEnabled ? &old.ClipRect : nullptr);
+    if (!bd->Exclusive)
+    {
+        SDL_RenderSetViewport(renderer, &old.Viewport);
+        SDL_RenderSetClipRect(renderer, old.ClipEnabled ? &old.ClipRect : nullptr);
+    }
+}
+
+void ImGui_ImplSDLRenderer2_SetExclusiveRenderer(bool exclusive)
+{
+    ImGui_ImplSDLRenderer2_Data* bd = ImGui_ImplSDLRenderer2_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSDLRenderer2_Init()?");
+    bd->Exclusive = exclusive;
+}
+
+// Returns RGBA pixels of a rectangle of the texture, along with their pitch
+static const void* ImGui_ImplSDLRenderer2_GetRGBAPixels(ImTextureData* tex, int x, int y, int w, int h, int* out_pitch)
+{
+    if (tex->Format == ImTextureFormat_RGBA32)
+    {
+        *out_pitch = tex->GetPitch();
+        return tex->GetPixelsAt(x, y);
+    }
+    ImGui_ImplSDLRenderer2_Data* bd = ImGui_ImplSDLRenderer2_GetBackendData();
+    bd->TexPixels.resize(w * h);
+    ImU32* dst = bd->TexPixels.Data;
+    for (int row = 0; row < h; row++)
+    {
+        const unsigned char* src = (const unsigned char*)tex->GetPixelsAt(x, y + row);
+        for (int col = 0; col < w; col++)
+            *dst++ = IM_COL32(255, 255, 255, src[col]);
+    }
+    *out_pitch = w * 4;
+    return bd->TexPixels.Data;
 }
 
 void ImGui_ImplSDLRenderer2_UpdateTexture(ImTextureData* tex)
@@ -211,13 +353,15 @@ void ImGui_ImplSDLRenderer2_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
 
         // Create texture
         // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
         SDL_Texture* sdl_texture = SDL_CreateTexture(bd->Renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, tex->Width, tex->Height);
         IM_ASSERT(sdl_texture != nullptr && "Backend failed to create texture!");
-        SDL_UpdateTexture(sdl_texture, nullptr, tex->GetPixels(), tex->GetPitch());
+        int pitch = 0;
+        const void* pixels = ImGui_ImplSDLRenderer2_GetRGBAPixels(tex, 0, 0, tex->Width, tex->Height, &pitch);
+        SDL_UpdateTexture(sdl_texture, nullptr, pixels, pitch);
         SDL_SetTextureBlendMode(sdl_texture, SDL_BLENDMODE_BLEND);
         SDL_SetTextureScaleMode(sdl_texture, SDL_ScaleModeLinear);
 
@@ -233,7 +377,9 @@ void ImGui_ImplSDLRenderer2_UpdateTexture(ImTextureData* tex)
         for (ImTextureRect& r : tex->Updates)
         {
             SDL_Rect sdl_r = { r.x, r.y, r.w, r.h };
-            SDL_UpdateTexture(sdl_texture, &sdl_r, tex->GetPixelsAt(r.x, r.y), tex->GetPitch());
+            int pitch = 0;
+            const void* pixels = ImGui_ImplSDLRenderer2_GetRGBAPixels(tex, r.x, r.y, r.w, r.h, &pitch);
+            SDL_UpdateTexture(sdl_texture, &sdl_r, pixels, pitch);
         }
         tex->SetStatus(ImTextureStatus_OK);
     }
@@ -44,6 +44,10 @@ IMGUI_IMPL_API void     ImGui_ImplSDLRenderer2_DestroyDeviceObjects();
 // (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = nullptr to handle this manually.
 IMGUI_IMPL_API void     ImGui_ImplSDLRenderer2_UpdateTexture(ImTextureData* tex);
 
+// (Optional) Declare that nothing else renders with this SDL_Renderer: RenderDrawData() then doesn't save and restore
+// the viewport and clip rect around its work (the clip rect is left set, SDL_RenderClear() ignores it).
+IMGUI_IMPL_API void     ImGui_ImplSDLRenderer2_SetExclusiveRenderer(bool exclusive);
+
 // [BETA] Selected render state data shared with callbacks.
 // This is temporarily stored in GetPlatformIO().Renderer_RenderState during the ImGui_ImplSDLRenderer2_RenderDrawData() call.
 // (Please open an issue if you feel you need access to more data)
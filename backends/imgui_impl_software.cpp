@@ -0,0 +1,727 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer (no graphics API required)
+// This needs to be used along with a Platform Backend, or with code filling io.DisplaySize/io.DeltaTime/inputs itself (e.g. headless).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use ImGui_ImplSoftware_CreateTexture() to create a texture identifier from RGBA pixels.
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures), RGBA32 and Alpha8 formats.
+//  [X] Renderer: Standard draw callbacks: DrawCallback_ResetRenderState, DrawCallback_SetSamplerLinear, DrawCallback_SetSamplerNearest.
+// Output is a RGBA8 (byte order R,G,B,A) pixel buffer owned by the caller: triangles are binned into tiles and the tiles are
+// rasterized by a pool of worker threads, with scissoring, bilinear texture sampling and "over" alpha blending.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+// How it works:
+// - Commands are split in segments at user callbacks. Each segment runs two parallel phases.
+// - Setup: every worker takes a contiguous slice of the segment triangles, computes edge and attribute planes and
+//   appends the triangle to the bins of the 64x64 tiles it overlaps. Bins are per worker, so no locking is needed.
+// - Raster: workers pick tiles. A tile walks the bins of worker 0, 1, ... in order, which preserves submission order,
+//   so the output does not depend on the number of threads.
+// - Coverage uses pixel centers with a top-left fill rule: pixels on an edge shared by two triangles are drawn once.
+// - Spans of a single color (most UI fills) are blended 4 pixels at a time with SSE2 when available.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_software.h"
+#include <stdint.h>     // intptr_t
+#include <string.h>     // memcpy
+#include <math.h>       // floorf, ceilf
+#include <algorithm>    // std::min, std::max
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMGUI_IMPL_SOFTWARE_HAS_SSE2
+#endif
+
+static const int ImGui_ImplSoftware_TileSize = 64;
+
+// Texture in CPU memory, same byte order as the framebuffer
+struct ImGui_ImplSoftware_Texture
+{
+    int             Width;
+    int             Height;
+    ImVector<ImU32> Pixels;
+};
+
+enum ImGui_ImplSoftware_TriangleFlags_
+{
+    ImGui_ImplSoftware_TriangleFlags_ColorVarying   = 1 << 0,   // Vertex colors differ, interpolate them
+    ImGui_ImplSoftware_TriangleFlags_UVVarying      = 1 << 1,   // UVs differ, sample the texture per pixel
+    ImGui_ImplSoftware_TriangleFlags_Nearest        = 1 << 2,   // Point sampling
+};
+
+// Triangle after setup, in framebuffer space
+struct ImGui_ImplSoftware_Triangle
+{
+    float   Edge[3][3];     // A, B, C of the edge functions A*x+B*y+C, positive inside
+    float   Plane[6][3];    // d/dx, d/dy and value at origin of R, G, B, A (0..255) and U, V (in texels, minus 0.5)
+    int     MinX, MinY, MaxX, MaxY; // Bounding box clipped to the scissor rectangle, max is exclusive
+    const ImGui_ImplSoftware_Texture* Texture;
+    ImU32   Color;          // Vertex color when not ColorVarying
+    ImU32   Texel;          // Sampled texel when not UVVarying
+    int     Flags;
+};
+
+// Run of consecutive triangles sharing texture, scissor and sampler
+struct ImGui_ImplSoftware_DrawItem
+{
+    const ImDrawVert*   VtxBuffer;
+    const ImDrawIdx*    IdxBuffer;
+    int                 FirstTriangle;  // Within the segment
+    int                 TriangleCount;
+    const ImGui_ImplSoftware_Texture* Texture;
+    int                 ClipMinX, ClipMinY, ClipMaxX, ClipMaxY;
+    bool                Nearest;
+};
+
+struct ImGui_ImplSoftware_Data
+{
+    int                             ThreadCount;
+    std::vector<std::thread>        Workers;
+    std::mutex                      Mutex;
+    std::condition_variable         WorkCond;
+    std::condition_variable         DoneCond;
+    void                            (*Job)(ImGui_ImplSoftware_Data* bd, int thread_index);
+    unsigned int                    JobGeneration;
+    int                             JobsPending;
+    bool                            Stop;
+
+    // Current frame
+    ImU32*                          Pixels;
+    int                             Width, Height, Stride;  // Stride in pixels
+    int                             TilesX, TilesY;
+    ImVec2                          ClipOff, ClipScale;
+    bool                            NextNearest;
+    ImVector<ImGui_ImplSoftware_DrawItem> Items;
+    int                             TriangleCount;
+    std::vector<ImVector<ImGui_ImplSoftware_Triangle>> Triangles;  // [thread]
+    std::vector<ImVector<ImU32>>    Bins;                           // [thread * tiles + tile], indices into Triangles[thread]
+    std::atomic<int>                NextTile;
+
+    ImGui_ImplSoftware_Data() : ThreadCount(1), Job(nullptr), JobGeneration(0), JobsPending(0), Stop(false), Pixels(nullptr), Width(0), Height(0), Stride(0), TilesX(0), TilesY(0), NextNearest(false), TriangleCount(0), NextTile(0) {}
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+// It is STRONGLY preferred that you use docking branch with multi-viewports (== single Dear ImGui context + multiple windows) instead of multiple Dear ImGui contexts.
+static ImGui_ImplSoftware_Data* ImGui_ImplSoftware_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoftware_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Worker pool
+//-----------------------------------------------------------------------------
+
+static void ImGui_ImplSoftware_WorkerMain(ImGui_ImplSoftware_Data* bd, int thread_index)
+{
+    unsigned int generation = 0;
+    for (;;)
+    {
+        void (*job)(ImGui_ImplSoftware_Data*, int);
+        {
+            std::unique_lock<std::mutex> lock(bd->Mutex);
+            bd->WorkCond.wait(lock, [bd, generation] { return bd->Stop || bd->JobGeneration != generation; });
+            if (bd->Stop)
+                return;
+            generation = bd->JobGeneration;
+            job = bd->Job;
+        }
+        job(bd, thread_index);
+        {
+            std::lock_guard<std::mutex> lock(bd->Mutex);
+            bd->JobsPending--;
+        }
+        bd->DoneCond.notify_one();
+    }
+}
+
+// Run 'job' on every thread (the calling thread is thread 0) and wait for all of them
+static void ImGui_ImplSoftware_RunParallel(ImGui_ImplSoftware_Data* bd, void (*job)(ImGui_ImplSoftware_Data*, int))
+{
+    if (bd->ThreadCount > 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock(bd->Mutex);
+            bd->Job = job;
+            bd->JobsPending = bd->ThreadCount - 1;
+            bd->JobGeneration++;
+        }
+        bd->WorkCond.notify_all();
+    }
+    job(bd, 0);
+    if (bd->ThreadCount > 1)
+    {
+        std::unique_lock<std::mutex> lock(bd->Mutex);
+        bd->DoneCond.wait(lock, [bd] { return bd->JobsPending == 0; });
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Pixel helpers
+//-----------------------------------------------------------------------------
+
+// Exact round(x / 255) for 0 <= x <= 255*255
+static inline int ImGui_ImplSoftware_Div255(int x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline int ImGui_ImplSoftware_ToByte(float v)
+{
+    int i = (int)(v + 0.5f);
+    return i < 0 ? 0 : i > 255 ? 255 : i;
+}
+
+// "Over" blending with straight alpha: RGB = src * a + dst * (1 - a), A = a + dst_a * (1 - a)
+static inline ImU32 ImGui_ImplSoftware_Blend(ImU32 dst, int r, int g, int b, int a)
+{
+    int ia = 255 - a;
+    int dr = (int)(dst & 0xFF), dg = (int)((dst >> 8) & 0xFF), db = (int)((dst >> 16) & 0xFF), da = (int)(dst >> 24);
+    return (ImU32)ImGui_ImplSoftware_Div255(r * a + dr * ia)
+        | ((ImU32)ImGui_ImplSoftware_Div255(g * a + dg * ia) << 8)
+        | ((ImU32)ImGui_ImplSoftware_Div255(b * a + db * ia) << 16)
+        | ((ImU32)ImGui_ImplSoftware_Div255(255 * a + da * ia) << 24);
+}
+
+static inline ImU32 ImGui_ImplSoftware_Sample(const ImGui_ImplSoftware_Texture* tex, float u, float v, bool nearest)
+{
+    const int w = tex->Width, h = tex->Height;
+    if (nearest)
+    {
+        int x = (int)floorf(u + 0.5f), y = (int)floorf(v + 0.5f);
+        x = x < 0 ? 0 : x >= w ? w - 1 : x;
+        y = y < 0 ? 0 : y >= h ? h - 1 : y;
+        return tex->Pixels.Data[y * w + x];
+    }
+    float fx0 = floorf(u), fy0 = floorf(v);
+    float fx = u - fx0, fy = v - fy0;
+    int x0 = (int)fx0, y0 = (int)fy0;
+    int x1 = x0 + 1, y1 = y0 + 1;
+    x0 = x0 < 0 ? 0 : x0 >= w ? w - 1 : x0;
+    x1 = x1 < 0 ? 0 : x1 >= w ? w - 1 : x1;
+    y0 = y0 < 0 ? 0 : y0 >= h ? h - 1 : y0;
+    y1 = y1 < 0 ? 0 : y1 >= h ? h - 1 : y1;
+    ImU32 c00 = tex->Pixels.Data[y0 * w + x0], c10 = tex->Pixels.Data[y0 * w + x1];
+    ImU32 c01 = tex->Pixels.Data[y1 * w + x0], c11 = tex->Pixels.Data[y1 * w + x1];
+    if (c00 == c10 && c00 == c01 && c00 == c11)
+        return c00;
+    float w00 = (1.0f - fx) * (1.0f - fy), w10 = fx * (1.0f - fy), w01 = (1.0f - fx) * fy, w11 = fx * fy;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        float c = ((c00 >> shift) & 0xFF) * w00 + ((c10 >> shift) & 0xFF) * w10 + ((c01 >> shift) & 0xFF) * w01 + ((c11 >> shift) & 0xFF) * w11;
+        out |= (ImU32)ImGui_ImplSoftware_ToByte(c) << shift;
+    }
+    return out;
+}
+
+// Modulate a texel by a vertex color
+static inline ImU32 ImGui_ImplSoftware_Modulate(ImU32 a, ImU32 b)
+{
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= (ImU32)ImGui_ImplSoftware_Div255((int)((a >> shift) & 0xFF) * (int)((b >> shift) & 0xFF)) << shift;
+    return out;
+}
+
+static void ImGui_ImplSoftware_FillSpanFlat(ImU32* dst, int count, ImU32 color)
+{
+    const int r = (int)(color & 0xFF), g = (int)((color >> 8) & 0xFF), b = (int)((color >> 16) & 0xFF), a = (int)(color >> 24);
+    if (a == 255)
+    {
+        for (int i = 0; i < count; i++)
+            dst[i] = color;
+        return;
+    }
+    int i = 0;
+#ifdef IMGUI_IMPL_SOFTWARE_HAS_SSE2
+    // Same arithmetic as ImGui_ImplSoftware_Blend(), on 16-bit lanes: out = ((t + (t >> 8)) >> 8) with t = dst * (255 - a) + src * a + 128
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i inv_alpha = _mm_set1_epi16((short)(255 - a));
+    const __m128i src_term = _mm_set_epi16((short)(255 * a + 128), (short)(b * a + 128), (short)(g * a + 128), (short)(r * a + 128),
+                                           (short)(255 * a + 128), (short)(b * a + 128), (short)(g * a + 128), (short)(r * a + 128));
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i px = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), inv_alpha), src_term);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), inv_alpha), src_term);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = ImGui_ImplSoftware_Blend(dst[i], r, g, b, a);
+}
+
+//-----------------------------------------------------------------------------
+// Setup
+//-----------------------------------------------------------------------------
+
+static bool ImGui_ImplSoftware_SetupTriangle(ImGui_ImplSoftware_Triangle* tri, const ImGui_ImplSoftware_DrawItem& item, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImVec2& clip_off, const ImVec2& clip_scale)
+{
+    const float x0 = (v0->pos.x - clip_off.x) * clip_scale.x, y0 = (v0->pos.y - clip_off.y) * clip_scale.y;
+    const float x1 = (v1->pos.x - clip_off.x) * clip_scale.x, y1 = (v1->pos.y - clip_off.y) * clip_scale.y;
+    const float x2 = (v2->pos.x - clip_off.x) * clip_scale.x, y2 = (v2->pos.y - clip_off.y) * clip_scale.y;
+    float area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+    if (area == 0.0f)
+        return false;
+
+    // Bounding box, clipped
+    float min_x = std::min(x0, std::min(x1, x2)), max_x = std::max(x0, std::max(x1, x2));
+    float min_y = std::min(y0, std::min(y1, y2)), max_y = std::max(y0, std::max(y1, y2));
+    tri->MinX = std::max(item.ClipMinX, (int)std::max(floorf(min_x), -1.0f));
+    tri->MinY = std::max(item.ClipMinY, (int)std::max(floorf(min_y), -1.0f));
+    tri->MaxX = std::min(item.ClipMaxX, (int)std::min(ceilf(max_x), 65536.0f));
+    tri->MaxY = std::min(item.ClipMaxY, (int)std::min(ceilf(max_y), 65536.0f));
+    if (tri->MinX >= tri->MaxX || tri->MinY >= tri->MaxY)
+        return false;
+
+    // Edge i is opposite to vertex i. Edges shared by two triangles come out as exact negations of each other.
+    const float sign = area > 0.0f ? 1.0f : -1.0f;
+    tri->Edge[0][0] = sign * (y1 - y2); tri->Edge[0][1] = sign * (x2 - x1); tri->Edge[0][2] = sign * (x1 * y2 - x2 * y1);
+    tri->Edge[1][0] = sign * (y2 - y0); tri->Edge[1][1] = sign * (x0 - x2); tri->Edge[1][2] = sign * (x2 * y0 - x0 * y2);
+    tri->Edge[2][0] = sign * (y0 - y1); tri->Edge[2][1] = sign * (x1 - x0); tri->Edge[2][2] = sign * (x0 * y1 - x1 * y0);
+    area *= sign;
+
+    // Attributes
+    const ImGui_ImplSoftware_Texture* tex = item.Texture;
+    tri->Texture = tex;
+    tri->Flags = item.Nearest ? ImGui_ImplSoftware_TriangleFlags_Nearest : 0;
+    tri->Color = v0->col;
+    tri->Texel = IM_COL32_WHITE;
+    if (v0->col != v1->col || v0->col != v2->col)
+        tri->Flags |= ImGui_ImplSoftware_TriangleFlags_ColorVarying;
+    const float tex_w = tex ? (float)tex->Width : 1.0f, tex_h = tex ? (float)tex->Height : 1.0f;
+    if (tex != nullptr)
+    {
+        if (v0->uv.x != v1->uv.x || v0->uv.x != v2->uv.x || v0->uv.y != v1->uv.y || v0->uv.y != v2->uv.y)
+            tri->Flags |= ImGui_ImplSoftware_TriangleFlags_UVVarying;
+        else
+            tri->Texel = ImGui_ImplSoftware_Sample(tex, v0->uv.x * tex_w - 0.5f, v0->uv.y * tex_h - 0.5f, item.Nearest);
+    }
+    if (!(tri->Flags & (ImGui_ImplSoftware_TriangleFlags_ColorVarying | ImGui_ImplSoftware_TriangleFlags_UVVarying)))
+    {
+        tri->Color = ImGui_ImplSoftware_Modulate(tri->Color, tri->Texel);
+        if ((tri->Color >> 24) == 0)
+            return false;
+    }
+    const float inv_area = 1.0f / area;
+    float values[6][3];
+    const ImDrawVert* v[3] = { v0, v1, v2 };
+    for (int i = 0; i < 3; i++)
+    {
+        values[0][i] = (float)((v[i]->col >> IM_COL32_R_SHIFT) & 0xFF);
+        values[1][i] = (float)((v[i]->col >> IM_COL32_G_SHIFT) & 0xFF);
+        values[2][i] = (float)((v[i]->col >> IM_COL32_B_SHIFT) & 0xFF);
+        values[3][i] = (float)((v[i]->col >> IM_COL32_A_SHIFT) & 0xFF);
+        values[4][i] = v[i]->uv.x * tex_w - 0.5f;
+        values[5][i] = v[i]->uv.y * tex_h - 0.5f;
+    }
+    for (int p = 0; p < 6; p++)
+        for (int k = 0; k < 3; k++)
+            tri->Plane[p][k] = (values[p][0] * tri->Edge[0][k] + values[p][1] * tri->Edge[1][k] + values[p][2] * tri->Edge[2][k]) * inv_area;
+    return true;
+}
+
+static void ImGui_ImplSoftware_SetupJob(ImGui_ImplSoftware_Data* bd, int thread_index)
+{
+    ImVector<ImGui_ImplSoftware_Triangle>& triangles = bd->Triangles[thread_index];
+    ImVector<ImU32>* bins = &bd->Bins[(size_t)thread_index * bd->TilesX * bd->TilesY];
+    triangles.resize(0);
+    for (int i = 0; i < bd->TilesX * bd->TilesY; i++)
+        bins[i].resize(0);
+
+    const int begin = (int)((long long)bd->TriangleCount * thread_index / bd->ThreadCount);
+    const int end = (int)((long long)bd->TriangleCount * (thread_index + 1) / bd->ThreadCount);
+    if (begin >= end)
+        return;
+
+    // Find the first item of our slice
+    int item_lo = 0, item_hi = bd->Items.Size - 1;
+    while (item_lo < item_hi)
+    {
+        int mid = (item_lo + item_hi + 1) / 2;
+        if (bd->Items[mid].FirstTriangle <= begin)
+            item_lo = mid;
+        else
+            item_hi = mid - 1;
+    }
+
+    const ImVec2 clip_off = bd->ClipOff;
+    const ImVec2 clip_scale = bd->ClipScale;
+    ImGui_ImplSoftware_Triangle tri;
+    for (int item_i = item_lo, n = begin; item_i < bd->Items.Size && n < end; item_i++)
+    {
+        const ImGui_ImplSoftware_DrawItem& item = bd->Items[item_i];
+        for (int t = n - item.FirstTriangle; t < item.TriangleCount && n < end; t++, n++)
+        {
+            const ImDrawIdx* idx = item.IdxBuffer + t * 3;
+            if (!ImGui_ImplSoftware_SetupTriangle(&tri, item, item.VtxBuffer + idx[0], item.VtxBuffer + idx[1], item.VtxBuffer + idx[2], clip_off, clip_scale))
+                continue;
+            const ImU32 tri_index = (ImU32)triangles.Size;
+            triangles.push_back(tri);
+            const int tile_x0 = tri.MinX / ImGui_ImplSoftware_TileSize, tile_x1 = (tri.MaxX - 1) / ImGui_ImplSoftware_TileSize;
+            const int tile_y0 = tri.MinY / ImGui_ImplSoftware_TileSize, tile_y1 = (tri.MaxY - 1) / ImGui_ImplSoftware_TileSize;
+            for (int ty = tile_y0; ty <= tile_y1; ty++)
+                for (int tx = tile_x0; tx <= tile_x1; tx++)
+                    bins[ty * bd->TilesX + tx].push_back(tri_index);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Rasterization
+//-----------------------------------------------------------------------------
+
+static void ImGui_ImplSoftware_RasterTriangle(ImGui_ImplSoftware_Data* bd, const ImGui_ImplSoftware_Triangle& tri, int tile_x0, int tile_y0, int tile_x1, int tile_y1)
+{
+    const int x_begin = std::max(tri.MinX, tile_x0), x_end = std::min(tri.MaxX, tile_x1);
+    const int y_begin = std::max(tri.MinY, tile_y0), y_end = std::min(tri.MaxY, tile_y1);
+    const bool color_varying = (tri.Flags & ImGui_ImplSoftware_TriangleFlags_ColorVarying) != 0;
+    const bool uv_varying = (tri.Flags & ImGui_ImplSoftware_TriangleFlags_UVVarying) != 0;
+    const bool nearest = (tri.Flags & ImGui_ImplSoftware_TriangleFlags_Nearest) != 0;
+    for (int y = y_begin; y < y_end; y++)
+    {
+        // Solve the span of pixel centers inside all three edges. Ties go to edges with A > 0, or A == 0 and B > 0.
+        const float yc = (float)y + 0.5f;
+        int x0 = x_begin, x1 = x_end;
+        bool empty = false;
+        for (int e = 0; e < 3 && !empty; e++)
+        {
+            const float a = tri.Edge[e][0], b = tri.Edge[e][1];
+            const float s = b * yc + tri.Edge[e][2];
+            if (a == 0.0f)
+            {
+                empty = s < 0.0f || (s == 0.0f && !(b > 0.0f));
+                continue;
+            }
+            float bound = -s / a - 0.5f;
+            bound = std::min(std::max(bound, -2.0f), 65538.0f);
+            if (a > 0.0f)
+                x0 = std::max(x0, (int)ceilf(bound));
+            else
+                x1 = std::min(x1, (int)ceilf(bound));
+        }
+        if (empty || x0 >= x1)
+            continue;
+
+        ImU32* dst = bd->Pixels + (size_t)y * bd->Stride;
+        if (!color_varying && !uv_varying)
+        {
+            ImGui_ImplSoftware_FillSpanFlat(dst + x0, x1 - x0, tri.Color);
+            continue;
+        }
+        const float xc = (float)x0 + 0.5f;
+        float attr[6], step[6];
+        for (int p = 0; p < 6; p++)
+        {
+            attr[p] = tri.Plane[p][0] * xc + tri.Plane[p][1] * yc + tri.Plane[p][2];
+            step[p] = tri.Plane[p][0];
+        }
+        for (int x = x0; x < x1; x++)
+        {
+            ImU32 color = color_varying
+                ? (ImU32)ImGui_ImplSoftware_ToByte(attr[0]) | ((ImU32)ImGui_ImplSoftware_ToByte(attr[1]) << 8) | ((ImU32)ImGui_ImplSoftware_ToByte(attr[2]) << 16) | ((ImU32)ImGui_ImplSoftware_ToByte(attr[3]) << 24)
+                : tri.Color;
+            ImU32 texel = uv_varying ? ImGui_ImplSoftware_Sample(tri.Texture, attr[4], attr[5], nearest) : tri.Texel;
+            ImU32 src = texel == IM_COL32_WHITE ? color : ImGui_ImplSoftware_Modulate(color, texel);
+            int src_a = (int)(src >> 24);
+            if (src_a == 255)
+                dst[x] = src;
+            else if (src_a != 0)
+                dst[x] = ImGui_ImplSoftware_Blend(dst[x], (int)(src & 0xFF), (int)((src >> 8) & 0xFF), (int)((src >> 16) & 0xFF), src_a);
+            for (int p = 0; p < 6; p++)
+                attr[p] += step[p];
+        }
+    }
+}
+
+static void ImGui_ImplSoftware_RasterJob(ImGui_ImplSoftware_Data* bd, int)
+{
+    const int tile_count = bd->TilesX * bd->TilesY;
+    for (int tile = bd->NextTile.fetch_add(1); tile < tile_count; tile = bd->NextTile.fetch_add(1))
+    {
+        const int tile_x0 = (tile % bd->TilesX) * ImGui_ImplSoftware_TileSize;
+        const int tile_y0 = (tile / bd->TilesX) * ImGui_ImplSoftware_TileSize;
+        const int tile_x1 = std::min(tile_x0 + ImGui_ImplSoftware_TileSize, bd->Width);
+        const int tile_y1 = std::min(tile_y0 + ImGui_ImplSoftware_TileSize, bd->Height);
+        for (int t = 0; t < bd->ThreadCount; t++)
+        {
+            const ImVector<ImGui_ImplSoftware_Triangle>& triangles = bd->Triangles[t];
+            const ImVector<ImU32>& bin = bd->Bins[(size_t)t * tile_count + tile];
+            for (ImU32 tri_index : bin)
+                ImGui_ImplSoftware_RasterTriangle(bd, triangles[tri_index], tile_x0, tile_y0, tile_x1, tile_y1);
+        }
+    }
+}
+
+// Draw all items gathered since the last flush
+static void ImGui_ImplSoftware_FlushItems(ImGui_ImplSoftware_Data* bd)
+{
+    if (bd->Items.Size == 0)
+        return;
+    ImGui_ImplSoftware_RunParallel(bd, ImGui_ImplSoftware_SetupJob);
+    bd->NextTile.store(0);
+    ImGui_ImplSoftware_RunParallel(bd, ImGui_ImplSoftware_RasterJob);
+    bd->Items.resize(0);
+    bd->TriangleCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Public API
+//-----------------------------------------------------------------------------
+
+void    ImGui_ImplSoftware_NewFrame()
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftware_Init()?");
+    IM_UNUSED(bd);
+}
+
+// Draw callbacks
+static void ImGui_ImplSoftware_DrawCallback_ResetRenderState(const ImDrawList*, const ImDrawCmd*)   { ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData(); bd->NextNearest = false; }
+static void ImGui_ImplSoftware_DrawCallback_SetSamplerLinear(const ImDrawList*, const ImDrawCmd*)   { ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData(); bd->NextNearest = false; }
+static void ImGui_ImplSoftware_DrawCallback_SetSamplerNearest(const ImDrawList*, const ImDrawCmd*)  { ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData(); bd->NextNearest = true; }
+
+void    ImGui_ImplSoftware_RenderDrawData(ImDrawData* draw_data, unsigned char* pixels, int width, int height, int stride)
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftware_Init()?");
+    IM_ASSERT(stride % 4 == 0 && ((intptr_t)pixels & 3) == 0 && "Framebuffer rows must be 4-byte aligned.");
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0 || width <= 0 || height <= 0)
+        return;
+
+    // Catch up with texture updates. Most of the times, the list will have 1 element with an OK status, aka nothing to do.
+    // (This almost always points to ImGui::GetPlatformIO().Textures[] but is part of ImDrawData to allow overriding or disabling texture updates).
+    if (draw_data->Textures != nullptr)
+        for (ImTextureData* tex : *draw_data->Textures)
+            if (tex->Status != ImTextureStatus_OK)
+                ImGui_ImplSoftware_UpdateTexture(tex);
+
+    bd->Pixels = (ImU32*)(void*)pixels;
+    bd->Width = width;
+    bd->Height = height;
+    bd->Stride = stride / 4;
+    const int tiles_x = (width + ImGui_ImplSoftware_TileSize - 1) / ImGui_ImplSoftware_TileSize;
+    const int tiles_y = (height + ImGui_ImplSoftware_TileSize - 1) / ImGui_ImplSoftware_TileSize;
+    if (tiles_x != bd->TilesX || tiles_y != bd->TilesY)
+    {
+        bd->TilesX = tiles_x;
+        bd->TilesY = tiles_y;
+        bd->Bins.clear();
+        bd->Bins.resize((size_t)bd->ThreadCount * tiles_x * tiles_y);
+    }
+    bd->NextNearest = false;
+    bd->Items.resize(0);
+    bd->TriangleCount = 0;
+
+    // Setup render state structure (for callbacks)
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+    ImGui_ImplSoftware_RenderState render_state;
+    render_state.Pixels = pixels;
+    render_state.Width = width;
+    render_state.Height = height;
+    render_state.Stride = stride;
+    platform_io.Renderer_RenderState = &render_state;
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    bd->ClipOff = clip_off;
+    bd->ClipScale = clip_scale;
+
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback)
+            {
+                // Sampler changes only affect the commands that follow, everything else may read or write the framebuffer
+                if (pcmd->UserCallback == ImGui_ImplSoftware_DrawCallback_SetSamplerLinear || pcmd->UserCallback == ImGui_ImplSoftware_DrawCallback_SetSamplerNearest || pcmd->UserCallback == ImGui_ImplSoftware_DrawCallback_ResetRenderState)
+                {
+                    pcmd->UserCallback(draw_list, pcmd);
+                    continue;
+                }
+                ImGui_ImplSoftware_FlushItems(bd);
+                pcmd->UserCallback(draw_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+            ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+            if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y || pcmd->ElemCount < 3)
+                continue;
+            ImGui_ImplSoftware_DrawItem item;
+            item.VtxBuffer = draw_list->VtxBuffer.Data + pcmd->VtxOffset;
+            item.IdxBuffer = draw_list->IdxBuffer.Data + pcmd->IdxOffset;
+            item.FirstTriangle = bd->TriangleCount;
+            item.TriangleCount = (int)(pcmd->ElemCount / 3);
+            ImTextureID tex_id = pcmd->GetTexID();
+            item.Texture = (tex_id == ImTextureID_Invalid || tex_id == 0) ? nullptr : (const ImGui_ImplSoftware_Texture*)(intptr_t)tex_id;
+            item.ClipMinX = std::max(0, (int)clip_min.x);
+            item.ClipMinY = std::max(0, (int)clip_min.y);
+            item.ClipMaxX = std::min(width, (int)clip_max.x);
+            item.ClipMaxY = std::min(height, (int)clip_max.y);
+            item.Nearest = bd->NextNearest;
+            if (item.ClipMinX >= item.ClipMaxX || item.ClipMinY >= item.ClipMaxY)
+                continue;
+            bd->Items.push_back(item);
+            bd->TriangleCount += item.TriangleCount;
+        }
+    }
+    ImGui_ImplSoftware_FlushItems(bd);
+    platform_io.Renderer_RenderState = nullptr;
+    bd->Pixels = nullptr;
+}
+
+static ImGui_ImplSoftware_Texture* ImGui_ImplSoftware_NewTexture(int width, int height)
+{
+    ImGui_ImplSoftware_Texture* tex = IM_NEW(ImGui_ImplSoftware_Texture)();
+    tex->Width = width;
+    tex->Height = height;
+    tex->Pixels.resize(width * height);
+    return tex;
+}
+
+// Copy a region of an ImTextureData into our texture, expanding Alpha8 to white RGBA
+static void ImGui_ImplSoftware_CopyRegion(ImGui_ImplSoftware_Texture* dst, ImTextureData* src, int x, int y, int w, int h)
+{
+    for (int row = y; row < y + h; row++)
+    {
+        ImU32* out = dst->Pixels.Data + row * dst->Width + x;
+        if (src->Format == ImTextureFormat_RGBA32)
+        {
+            memcpy(out, src->GetPixelsAt(x, row), (size_t)w * 4);
+        }
+        else
+        {
+            const unsigned char* in = (const unsigned char*)src->GetPixelsAt(x, row);
+            for (int i = 0; i < w; i++)
+                out[i] = 0x00FFFFFF | ((ImU32)in[i] << 24);
+        }
+    }
+}
+
+void ImGui_ImplSoftware_UpdateTexture(ImTextureData* tex)
+{
+    if (tex->Status == ImTextureStatus_WantCreate)
+    {
+        //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
+        IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
+        ImGui_ImplSoftware_Texture* backend_tex = ImGui_ImplSoftware_NewTexture(tex->Width, tex->Height);
+        ImGui_ImplSoftware_CopyRegion(backend_tex, tex, 0, 0, tex->Width, tex->Height);
+        tex->SetTexID((ImTextureID)(intptr_t)backend_tex);
+        tex->BackendUserData = backend_tex;
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantUpdates)
+    {
+        ImGui_ImplSoftware_Texture* backend_tex = (ImGui_ImplSoftware_Texture*)tex->BackendUserData;
+        IM_ASSERT(backend_tex->Width == tex->Width && backend_tex->Height == tex->Height);
+        for (ImTextureRect& r : tex->Updates)
+            ImGui_ImplSoftware_CopyRegion(backend_tex, tex, r.x, r.y, r.w, r.h);
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantDestroy)
+    {
+        ImGui_ImplSoftware_Texture* backend_tex = (ImGui_ImplSoftware_Texture*)tex->BackendUserData;
+        IM_DELETE(backend_tex);
+
+        // Clear identifiers and mark as destroyed (in order to allow e.g. calling InvalidateDeviceObjects while running)
+        tex->SetTexID(ImTextureID_Invalid);
+        tex->BackendUserData = nullptr;
+        tex->SetStatus(ImTextureStatus_Destroyed);
+    }
+}
+
+ImTextureID ImGui_ImplSoftware_CreateTexture(const void* pixels, int width, int height)
+{
+    ImGui_ImplSoftware_Texture* tex = ImGui_ImplSoftware_NewTexture(width, height);
+    memcpy(tex->Pixels.Data, pixels, (size_t)width * height * 4);
+    return (ImTextureID)(intptr_t)tex;
+}
+
+void    ImGui_ImplSoftware_DestroyTexture(ImTextureID tex_id)
+{
+    ImGui_ImplSoftware_Texture* tex = (ImGui_ImplSoftware_Texture*)(intptr_t)tex_id;
+    IM_DELETE(tex);
+}
+
+bool    ImGui_ImplSoftware_Init(int thread_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoftware_Data* bd = IM_NEW(ImGui_ImplSoftware_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_software";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;   // We can honor ImGuiPlatformIO::Textures[] requests during render.
+
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+    platform_io.DrawCallback_ResetRenderState = ImGui_ImplSoftware_DrawCallback_ResetRenderState;
+    platform_io.DrawCallback_SetSamplerLinear = ImGui_ImplSoftware_DrawCallback_SetSamplerLinear;
+    platform_io.DrawCallback_SetSamplerNearest = ImGui_ImplSoftware_DrawCallback_SetSamplerNearest;
+
+    if (thread_count <= 0)
+        thread_count = (int)std::thread::hardware_concurrency();
+    bd->ThreadCount = std::min(std::max(thread_count, 1), 64);
+    bd->Triangles.resize((size_t)bd->ThreadCount);
+    for (int i = 1; i < bd->ThreadCount; i++)
+        bd->Workers.push_back(std::thread(ImGui_ImplSoftware_WorkerMain, bd, i));
+    return true;
+}
+
+void    ImGui_ImplSoftware_Shutdown()
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+
+    // Destroy all textures
+    for (ImTextureData* tex : platform_io.Textures)
+        if (tex->RefCount == 1)
+        {
+            tex->SetStatus(ImTextureStatus_WantDestroy);
+            ImGui_ImplSoftware_UpdateTexture(tex);
+        }
+
+    {
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        bd->Stop = true;
+    }
+    bd->WorkCond.notify_all();
+    for (std::thread& worker : bd->Workers)
+        worker.join();
+
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+    platform_io.ClearRendererHandlers();
+    IM_DELETE(bd);
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // #ifndef IMGUI_DISABLE
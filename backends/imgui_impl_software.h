@@ -0,0 +1,51 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer (no graphics API required)
+// This needs to be used along with a Platform Backend, or with code filling io.DisplaySize/io.DeltaTime/inputs itself (e.g. headless).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use ImGui_ImplSoftware_CreateTexture() to create a texture identifier from RGBA pixels.
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures), RGBA32 and Alpha8 formats.
+//  [X] Renderer: Standard draw callbacks: DrawCallback_ResetRenderState, DrawCallback_SetSamplerLinear, DrawCallback_SetSamplerNearest.
+// Output is a RGBA8 (byte order R,G,B,A) pixel buffer owned by the caller: triangles are binned into tiles and the tiles are
+// rasterized by a pool of worker threads, with scissoring, bilinear texture sampling and "over" alpha blending.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+
+// Follow "Getting Started" link and check examples/ folder to learn about using backends!
+// 'thread_count' == 0 uses one worker per hardware thread, 1 rasterizes on the calling thread only.
+IMGUI_IMPL_API bool     ImGui_ImplSoftware_Init(int thread_count = 0);
+IMGUI_IMPL_API void     ImGui_ImplSoftware_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftware_NewFrame();
+// Draw into 'pixels' ('width' x 'height' RGBA8 pixels, 'stride' bytes per row). The buffer is blended onto, never cleared.
+IMGUI_IMPL_API void     ImGui_ImplSoftware_RenderDrawData(ImDrawData* draw_data, unsigned char* pixels, int width, int height, int stride);
+
+// (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = nullptr to handle this manually.
+IMGUI_IMPL_API void     ImGui_ImplSoftware_UpdateTexture(ImTextureData* tex);
+
+// User textures. Pixels are RGBA8 and copied.
+IMGUI_IMPL_API ImTextureID ImGui_ImplSoftware_CreateTexture(const void* pixels, int width, int height);
+IMGUI_IMPL_API void     ImGui_ImplSoftware_DestroyTexture(ImTextureID tex_id);
+
+// [BETA] Selected render state data shared with callbacks.
+// This is temporarily stored in GetPlatformIO().Renderer_RenderState during the ImGui_ImplSoftware_RenderDrawData() call.
+// (Please open an issue if you feel you need access to more data)
+// Everything submitted before the callback has been drawn when it is called.
+struct ImGui_ImplSoftware_RenderState
+{
+    unsigned char*      Pixels;
+    int                 Width;
+    int                 Height;
+    int                 Stride;
+};
+
+#endif // #ifndef IMGUI_DISABLE
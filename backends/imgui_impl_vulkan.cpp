@@ -0,0 +1,1022 @@
+// dear imgui: Renderer Backend for Vulkan
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..)
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'VkDescriptorSet' as texture identifier. Call ImGui_ImplVulkan_AddTexture() to register one. Read the FAQ about ImTextureID/ImTextureRef!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Multiple frames in flight: vertices/indices go to persistently mapped host-visible buffers, one set per frame in flight.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+// How it works:
+// - Every frame in flight owns a vertex and an index buffer, persistently mapped and grown on demand. The application
+//   waited for the fence of that frame before recording it, so the buffers are free: no copy, no extra synchronization.
+// - All draw lists of a frame are copied back to back and drawn with vertex/index offsets, one bind per frame.
+// - ImTextureID is the VkDescriptorSet of the texture. Consecutive commands using the same one do not rebind it.
+// - Texture uploads are recorded in the frame's command buffer, before its render pass, from a staging ring of that frame:
+//   nothing is submitted or waited for here, the fence the application waits for before reusing the frame also frees the ring.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_vulkan.h"
+#include <stddef.h>     // offsetof
+#include <string.h>     // memcpy, memset
+
+// SPIR-V compiled at build time from backends/vulkan/glsl_shader.{vert,frag}, see imgui_impl_vulkan.h
+static const uint32_t __glsl_shader_vert_spv[] =
+#include "glsl_shader.vert.inc"
+;
+static const uint32_t __glsl_shader_frag_spv[] =
+#include "glsl_shader.frag.inc"
+;
+
+// Texture owned by the backend: font atlas and ImGui_ImplVulkan_CreateTexture()
+struct ImGui_ImplVulkan_Texture
+{
+    VkDeviceMemory      Memory;
+    VkImage             Image;
+    VkImageView         ImageView;
+    VkDescriptorSet     DescriptorSet;
+    int                 Width;
+    int                 Height;
+    bool                Initialized;    // Image has left VK_IMAGE_LAYOUT_UNDEFINED, in the order uploads are recorded
+    unsigned char*      PendingPixels;  // ImGui_ImplVulkan_CreateTexture() pixels waiting for the next recorded frame
+
+    ImGui_ImplVulkan_Texture() { memset((void*)this, 0, sizeof(*this)); }
+};
+
+// Vertex, index and staging buffers of one frame in flight
+struct ImGui_ImplVulkan_FrameRenderBuffers
+{
+    VkDeviceMemory      VertexBufferMemory;
+    VkDeviceMemory      IndexBufferMemory;
+    VkDeviceMemory      UploadBufferMemory;
+    VkDeviceSize        VertexBufferSize;
+    VkDeviceSize        IndexBufferSize;
+    VkDeviceSize        UploadBufferSize;
+    VkDeviceSize        UploadBufferUsed;   // Staging bytes recorded since the frame was reused
+    VkBuffer            VertexBuffer;
+    VkBuffer            IndexBuffer;
+    VkBuffer            UploadBuffer;
+    void*               VertexMapped;
+    void*               IndexMapped;
+    void*               UploadMapped;
+    bool                VertexCoherent;
+    bool                IndexCoherent;
+    bool                UploadCoherent;
+    int                 UploadFrameCount;   // ImGui::GetFrameCount() when the staging ring was last reset
+};
+
+// Staging buffer outgrown while copies from it were already recorded, freed when its frame comes around again
+struct ImGui_ImplVulkan_RetiredBuffer
+{
+    VkBuffer            Buffer;
+    VkDeviceMemory      Memory;
+    uint32_t            FrameIndex;
+};
+
+// Descriptor set registered with ImGui_ImplVulkan_AddTexture()
+struct ImGui_ImplVulkan_CachedDescriptor
+{
+    VkSampler           Sampler;
+    VkImageView         ImageView;
+    VkImageLayout       ImageLayout;
+    VkDescriptorSet     DescriptorSet;
+};
+
+// Vulkan data
+struct ImGui_ImplVulkan_Data
+{
+    ImGui_ImplVulkan_InitInfo   VulkanInitInfo;
+    VkDeviceSize                BufferMemoryAlignment;
+    VkPhysicalDeviceMemoryProperties MemoryProperties;
+    VkDescriptorSetLayout       DescriptorSetLayout;
+    VkPipelineLayout            PipelineLayout;
+    VkPipeline                  Pipeline;
+    VkShaderModule              ShaderModuleVert;
+    VkShaderModule              ShaderModuleFrag;
+    VkDescriptorPool            DescriptorPool;
+    VkSampler                   TexSampler;
+
+    ImVector<ImGui_ImplVulkan_FrameRenderBuffers>   FrameRenderBuffers;     // [FramesInFlight]
+    ImVector<ImGui_ImplVulkan_RetiredBuffer>        RetiredUploadBuffers;
+    ImVector<ImGui_ImplVulkan_CachedDescriptor>     Descriptors;
+    ImVector<ImGui_ImplVulkan_Texture*>             UserTextures;
+    int                                             PendingUserTextures;    // UserTextures[] with PendingPixels
+
+    ImGui_ImplVulkan_Data() { memset((void*)this, 0, sizeof(*this)); BufferMemoryAlignment = 256; }
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+// It is STRONGLY preferred that you use docking branch with multi-viewports (== single Dear ImGui context + multiple windows) instead of multiple Dear ImGui contexts.
+static ImGui_ImplVulkan_Data* ImGui_ImplVulkan_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplVulkan_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+static void check_vk_result(VkResult err)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    if (!bd)
+        return;
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (v->CheckVkResultFn)
+        v->CheckVkResultFn(err);
+}
+
+static uint32_t ImGui_ImplVulkan_MemoryType(VkMemoryPropertyFlags properties, uint32_t type_bits)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    for (uint32_t i = 0; i < bd->MemoryProperties.memoryTypeCount; i++)
+        if ((bd->MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties && (type_bits & (1u << i)))
+            return i;
+    return 0xFFFFFFFF; // Unable to find memoryType
+}
+
+static VkDeviceSize ImGui_ImplVulkan_AlignBufferSize(VkDeviceSize size, VkDeviceSize alignment)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Create a persistently mapped host-visible buffer, preferring coherent memory
+static void ImGui_ImplVulkan_CreateOrResizeBuffer(VkBuffer& buffer, VkDeviceMemory& buffer_memory, void*& mapped, bool& coherent, VkDeviceSize& buffer_size, VkDeviceSize new_size, VkBufferUsageFlagBits usage)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    VkResult err;
+    if (buffer != VK_NULL_HANDLE)
+        vkDestroyBuffer(v->Device, buffer, v->Allocator);
+    if (buffer_memory != VK_NULL_HANDLE)
+    {
+        vkUnmapMemory(v->Device, buffer_memory);
+        vkFreeMemory(v->Device, buffer_memory, v->Allocator);
+    }
+    mapped = nullptr;
+
+    VkDeviceSize buffer_size_aligned = ImGui_ImplVulkan_AlignBufferSize(new_size > bd->BufferMemoryAlignment ? new_size : bd->BufferMemoryAlignment, bd->BufferMemoryAlignment);
+    VkBufferCreateInfo buffer_info = {};
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.size = buffer_size_aligned;
+    buffer_info.usage = usage;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    err = vkCreateBuffer(v->Device, &buffer_info, v->Allocator, &buffer);
+    check_vk_result(err);
+
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(v->Device, buffer, &req);
+    bd->BufferMemoryAlignment = (bd->BufferMemoryAlignment > req.alignment) ? bd->BufferMemoryAlignment : req.alignment;
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = req.size;
+    alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, req.memoryTypeBits);
+    coherent = alloc_info.memoryTypeIndex != 0xFFFFFFFF;
+    if (!coherent)
+        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, req.memoryTypeBits);
+    err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &buffer_memory);
+    check_vk_result(err);
+
+    err = vkBindBufferMemory(v->Device, buffer, buffer_memory, 0);
+    check_vk_result(err);
+    err = vkMapMemory(v->Device, buffer_memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+    check_vk_result(err);
+    buffer_size = buffer_size_aligned;
+}
+
+static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline pipeline, VkCommandBuffer command_buffer, ImGui_ImplVulkan_FrameRenderBuffers* rb, int fb_width, int fb_height)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+
+    // Bind pipeline:
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+    // Bind Vertex And Index Buffer:
+    if (draw_data->TotalVtxCount > 0)
+    {
+        VkBuffer vertex_buffers[1] = { rb->VertexBuffer };
+        VkDeviceSize vertex_offset[1] = { 0 };
+        vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffers, vertex_offset);
+        vkCmdBindIndexBuffer(command_buffer, rb->IndexBuffer, 0, sizeof(ImDrawIdx) == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+    }
+
+    // Setup viewport:
+    VkViewport viewport;
+    viewport.x = 0;
+    viewport.y = 0;
+    viewport.width = (float)fb_width;
+    viewport.height = (float)fb_height;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+
+    // Setup scale and translation:
+    // Our visible imgui space lies from draw_data->DisplayPps (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
+    float scale[2];
+    scale[0] = 2.0f / draw_data->DisplaySize.x;
+    scale[1] = 2.0f / draw_data->DisplaySize.y;
+    float translate[2];
+    translate[0] = -1.0f - draw_data->DisplayPos.x * scale[0];
+    translate[1] = -1.0f - draw_data->DisplayPos.y * scale[1];
+    vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
+    vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
+}
+
+// Render function
+void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, uint32_t frame_index)
+{
+    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    IM_ASSERT(frame_index < v->FramesInFlight && "Frame index out of range, see ImGui_ImplVulkan_InitInfo::FramesInFlight.");
+
+    // Copies cannot be recorded inside a render pass: ImGui_ImplVulkan_RecordTextureUploads() did them before it began
+#ifndef NDEBUG
+    if (draw_data->Textures != nullptr)
+        for (ImTextureData* tex : *draw_data->Textures)
+            IM_ASSERT(tex->Status != ImTextureStatus_WantCreate && tex->Status != ImTextureStatus_WantUpdates && "Call ImGui_ImplVulkan_RecordTextureUploads() before the render pass!");
+#endif
+    IM_ASSERT(bd->PendingUserTextures == 0 && "Call ImGui_ImplVulkan_RecordTextureUploads() before the render pass!");
+
+    // The application waited for the fence of this frame, its buffers are no longer read by the GPU
+    ImGui_ImplVulkan_FrameRenderBuffers* rb = &bd->FrameRenderBuffers[frame_index];
+    if (draw_data->TotalVtxCount > 0)
+    {
+        // Create or resize the vertex/index buffers, with some headroom so a growing UI does not reallocate every frame
+        VkDeviceSize vertex_size = (VkDeviceSize)draw_data->TotalVtxCount * sizeof(ImDrawVert);
+        VkDeviceSize index_size = (VkDeviceSize)draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+        if (rb->VertexBuffer == VK_NULL_HANDLE || rb->VertexBufferSize < vertex_size)
+            ImGui_ImplVulkan_CreateOrResizeBuffer(rb->VertexBuffer, rb->VertexBufferMemory, rb->VertexMapped, rb->VertexCoherent, rb->VertexBufferSize, vertex_size + vertex_size / 2, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        if (rb->IndexBuffer == VK_NULL_HANDLE || rb->IndexBufferSize < index_size)
+            ImGui_ImplVulkan_CreateOrResizeBuffer(rb->IndexBuffer, rb->IndexBufferMemory, rb->IndexMapped, rb->IndexCoherent, rb->IndexBufferSize, index_size + index_size / 2, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+
+        // Copy all draw lists back to back
+        ImDrawVert* vtx_dst = (ImDrawVert*)rb->VertexMapped;
+        ImDrawIdx* idx_dst = (ImDrawIdx*)rb->IndexMapped;
+        for (const ImDrawList* draw_list : draw_data->CmdLists)
+        {
+            memcpy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+            memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            vtx_dst += draw_list->VtxBuffer.Size;
+            idx_dst += draw_list->IdxBuffer.Size;
+        }
+        VkMappedMemoryRange ranges[2] = {};
+        uint32_t range_count = 0;
+        if (!rb->VertexCoherent)
+        {
+            ranges[range_count].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            ranges[range_count].memory = rb->VertexBufferMemory;
+            ranges[range_count].size = VK_WHOLE_SIZE;
+            range_count++;
+        }
+        if (!rb->IndexCoherent)
+        {
+            ranges[range_count].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            ranges[range_count].memory = rb->IndexBufferMemory;
+            ranges[range_count].size = VK_WHOLE_SIZE;
+            range_count++;
+        }
+        if (range_count > 0)
+        {
+            VkResult err = vkFlushMappedMemoryRanges(v->Device, range_count, ranges);
+            check_vk_result(err);
+        }
+    }
+
+    // Setup desired Vulkan state
+    ImGui_ImplVulkan_SetupRenderState(draw_data, bd->Pipeline, command_buffer, rb, fb_width, fb_height);
+
+    // Setup render state structure (for callbacks and custom texture bindings)
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+    ImGui_ImplVulkan_RenderState render_state;
+    render_state.CommandBuffer = command_buffer;
+    render_state.Pipeline = bd->Pipeline;
+    render_state.PipelineLayout = bd->PipelineLayout;
+    platform_io.Renderer_RenderState = &render_state;
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    // Render command lists
+    // (Because we merged all buffers into a single one, we maintain our own offset into them)
+    VkDescriptorSet last_desc_set = VK_NULL_HANDLE;
+    int global_vtx_offset = 0;
+    int global_idx_offset = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                    ImGui_ImplVulkan_SetupRenderState(draw_data, bd->Pipeline, command_buffer, rb, fb_width, fb_height);
+                else
+                    pcmd->UserCallback(draw_list, pcmd);
+                last_desc_set = VK_NULL_HANDLE;
+            }
+            else
+            {
+                // Project scissor/clipping rectangles into framebuffer space
+                ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+                ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+
+                // Clamp to viewport as vkCmdSetScissor() won't accept values that are off bounds
+                if (clip_min.x < 0.0f) { clip_min.x = 0.0f; }
+                if (clip_min.y < 0.0f) { clip_min.y = 0.0f; }
+                if (clip_max.x > fb_width) { clip_max.x = (float)fb_width; }
+                if (clip_max.y > fb_height) { clip_max.y = (float)fb_height; }
+                if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                    continue;
+
+                // Apply scissor/clipping rectangle
+                VkRect2D scissor;
+                scissor.offset.x = (int32_t)(clip_min.x);
+                scissor.offset.y = (int32_t)(clip_min.y);
+                scissor.extent.width = (uint32_t)(clip_max.x - clip_min.x);
+                scissor.extent.height = (uint32_t)(clip_max.y - clip_min.y);
+                vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+                // Bind DescriptorSet with font or user texture, unless the previous command already did
+                VkDescriptorSet desc_set = (VkDescriptorSet)pcmd->GetTexID();
+                if (desc_set != last_desc_set)
+                {
+                    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bd->PipelineLayout, 0, 1, &desc_set, 0, nullptr);
+                    last_desc_set = desc_set;
+                }
+
+                // Draw
+                vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
+            }
+        }
+        global_idx_offset += draw_list->IdxBuffer.Size;
+        global_vtx_offset += draw_list->VtxBuffer.Size;
+    }
+    platform_io.Renderer_RenderState = nullptr;
+
+    // Note: at this point both vkCmdSetViewport() and vkCmdSetScissor() have been called.
+    // Our last values will leak into user/application rendering IF:
+    // - Your app uses a pipeline with VK_DYNAMIC_STATE_VIEWPORT or VK_DYNAMIC_STATE_SCISSOR dynamic state
+    // - And you forgot to call vkCmdSetViewport() and vkCmdSetScissor() yourself to explicitly set that state.
+    // If you use VK_DYNAMIC_STATE_VIEWPORT or VK_DYNAMIC_STATE_SCISSOR you are responsible for setting the values before rendering.
+    // In theory we should aim to backup/restore those values but I am not sure this is possible.
+    // We perform a call to vkCmdSetScissor() to set back a full viewport which is likely to fix things for 99% users but technically this is not perfect. (See github #4644)
+    VkRect2D scissor = { { 0, 0 }, { (uint32_t)fb_width, (uint32_t)fb_height } };
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+}
+
+//-----------------------------------------------------------------------------
+// Textures
+//-----------------------------------------------------------------------------
+
+static ImGui_ImplVulkan_Texture* ImGui_ImplVulkan_CreateTextureImage(int width, int height)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    ImGui_ImplVulkan_Texture* backend_tex = IM_NEW(ImGui_ImplVulkan_Texture)();
+    backend_tex->Width = width;
+    backend_tex->Height = height;
+    VkResult err;
+
+    // Create the Image:
+    {
+        VkImageCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        info.imageType = VK_IMAGE_TYPE_2D;
+        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.extent.width = (uint32_t)width;
+        info.extent.height = (uint32_t)height;
+        info.extent.depth = 1;
+        info.mipLevels = 1;
+        info.arrayLayers = 1;
+        info.samples = VK_SAMPLE_COUNT_1_BIT;
+        info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        err = vkCreateImage(v->Device, &info, v->Allocator, &backend_tex->Image);
+        check_vk_result(err);
+        VkMemoryRequirements req;
+        vkGetImageMemoryRequirements(v->Device, backend_tex->Image, &req);
+        VkMemoryAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = req.size;
+        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, req.memoryTypeBits);
+        if (alloc_info.memoryTypeIndex == 0xFFFFFFFF)
+            alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(0, req.memoryTypeBits);
+        err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &backend_tex->Memory);
+        check_vk_result(err);
+        err = vkBindImageMemory(v->Device, backend_tex->Image, backend_tex->Memory, 0);
+        check_vk_result(err);
+    }
+
+    // Create the Image View:
+    {
+        VkImageViewCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        info.image = backend_tex->Image;
+        info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        info.subresourceRange.levelCount = 1;
+        info.subresourceRange.layerCount = 1;
+        err = vkCreateImageView(v->Device, &info, v->Allocator, &backend_tex->ImageView);
+        check_vk_result(err);
+    }
+
+    // Create the Descriptor Set
+    backend_tex->DescriptorSet = ImGui_ImplVulkan_AddTexture(bd->TexSampler, backend_tex->ImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    return backend_tex;
+}
+
+static void ImGui_ImplVulkan_DestroyTextureImage(ImGui_ImplVulkan_Texture* backend_tex)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    if (backend_tex->PendingPixels != nullptr)
+    {
+        IM_FREE(backend_tex->PendingPixels);
+        bd->PendingUserTextures--;
+    }
+    ImGui_ImplVulkan_RemoveTexture(backend_tex->DescriptorSet);
+    vkDestroyImageView(v->Device, backend_tex->ImageView, v->Allocator);
+    vkDestroyImage(v->Device, backend_tex->Image, v->Allocator);
+    vkFreeMemory(v->Device, backend_tex->Memory, v->Allocator);
+    IM_DELETE(backend_tex);
+}
+
+// Reserve 'size' bytes of the staging ring of a frame in flight.
+// The application waited for the fence of the frame before recording it again, so the ring restarts from zero on its first use in an ImGui frame.
+// Outgrowing it retires the buffer instead of freeing it: copies from it are already recorded in the command buffer.
+static unsigned char* ImGui_ImplVulkan_AllocUpload(uint32_t frame_index, VkDeviceSize size, VkBuffer* buffer, VkDeviceSize* offset)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    ImGui_ImplVulkan_FrameRenderBuffers* rb = &bd->FrameRenderBuffers[frame_index];
+    if (rb->UploadFrameCount != ImGui::GetFrameCount())
+    {
+        rb->UploadFrameCount = ImGui::GetFrameCount();
+        rb->UploadBufferUsed = 0;
+        for (int n = 0; n < bd->RetiredUploadBuffers.Size; n++)
+            if (bd->RetiredUploadBuffers[n].FrameIndex == frame_index)
+            {
+                ImGui_ImplVulkan_RetiredBuffer& retired = bd->RetiredUploadBuffers[n];
+                vkDestroyBuffer(v->Device, retired.Buffer, v->Allocator);
+                vkUnmapMemory(v->Device, retired.Memory);
+                vkFreeMemory(v->Device, retired.Memory, v->Allocator);
+                bd->RetiredUploadBuffers.erase(bd->RetiredUploadBuffers.Data + n--);
+            }
+    }
+
+    if (rb->UploadBuffer == VK_NULL_HANDLE || rb->UploadBufferUsed + size > rb->UploadBufferSize)
+    {
+        if (rb->UploadBuffer != VK_NULL_HANDLE && rb->UploadBufferUsed > 0)
+        {
+            ImGui_ImplVulkan_RetiredBuffer retired = { rb->UploadBuffer, rb->UploadBufferMemory, frame_index };
+            bd->RetiredUploadBuffers.push_back(retired);
+            rb->UploadBuffer = VK_NULL_HANDLE;
+            rb->UploadBufferMemory = VK_NULL_HANDLE;
+        }
+        VkDeviceSize new_size = rb->UploadBufferSize * 2 > size ? rb->UploadBufferSize * 2 : size;
+        ImGui_ImplVulkan_CreateOrResizeBuffer(rb->UploadBuffer, rb->UploadBufferMemory, rb->UploadMapped, rb->UploadCoherent, rb->UploadBufferSize, new_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        rb->UploadBufferUsed = 0;
+    }
+    *buffer = rb->UploadBuffer;
+    *offset = rb->UploadBufferUsed;
+    rb->UploadBufferUsed += size;
+    return (unsigned char*)rb->UploadMapped + *offset;
+}
+
+// Record copies of rectangles of 'pixels' (RGBA8, 'pitch' bytes per row) into the texture, through the staging ring of the frame
+static void ImGui_ImplVulkan_UploadTextureRects(ImGui_ImplVulkan_Texture* backend_tex, const unsigned char* pixels, int pitch, const ImTextureRect* rects, int rect_count, VkCommandBuffer command_buffer, uint32_t frame_index)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    IM_ASSERT(frame_index < v->FramesInFlight && "Frame index out of range, see ImGui_ImplVulkan_InitInfo::FramesInFlight.");
+
+    VkDeviceSize upload_size = 0;
+    for (int n = 0; n < rect_count; n++)
+        upload_size += (VkDeviceSize)rects[n].w * rects[n].h * 4;
+    if (upload_size == 0)
+        return;
+
+    // Upload to the staging ring:
+    VkBuffer upload_buffer;
+    VkDeviceSize upload_offset;
+    unsigned char* map = ImGui_ImplVulkan_AllocUpload(frame_index, upload_size, &upload_buffer, &upload_offset);
+    ImVector<VkBufferImageCopy> regions;
+    regions.resize(rect_count);
+    VkDeviceSize offset = 0;
+    for (int n = 0; n < rect_count; n++)
+    {
+        const ImTextureRect& r = rects[n];
+        for (int y = 0; y < r.h; y++)
+            memcpy(map + offset + (VkDeviceSize)y * r.w * 4, pixels + (size_t)(r.y + y) * pitch + (size_t)r.x * 4, (size_t)r.w * 4);
+        VkBufferImageCopy& region = regions[n];
+        memset(&region, 0, sizeof(region));
+        region.bufferOffset = upload_offset + offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset.x = r.x;
+        region.imageOffset.y = r.y;
+        region.imageExtent.width = r.w;
+        region.imageExtent.height = r.h;
+        region.imageExtent.depth = 1;
+        offset += (VkDeviceSize)r.w * r.h * 4;
+    }
+    ImGui_ImplVulkan_FrameRenderBuffers* rb = &bd->FrameRenderBuffers[frame_index];
+    if (!rb->UploadCoherent)
+    {
+        VkMappedMemoryRange range = {};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = rb->UploadBufferMemory;
+        range.size = VK_WHOLE_SIZE;
+        VkResult err = vkFlushMappedMemoryRanges(v->Device, 1, &range);
+        check_vk_result(err);
+    }
+
+    // Record: previous frames may still sample the image, the first barrier waits for them (same queue, earlier submissions)
+    VkImageMemoryBarrier copy_barrier = {};
+    copy_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    copy_barrier.srcAccessMask = backend_tex->Initialized ? VK_ACCESS_SHADER_READ_BIT : 0;
+    copy_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    copy_barrier.oldLayout = backend_tex->Initialized ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+    copy_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    copy_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    copy_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    copy_barrier.image = backend_tex->Image;
+    copy_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    copy_barrier.subresourceRange.levelCount = 1;
+    copy_barrier.subresourceRange.layerCount = 1;
+    vkCmdPipelineBarrier(command_buffer, backend_tex->Initialized ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &copy_barrier);
+
+    vkCmdCopyBufferToImage(command_buffer, upload_buffer, backend_tex->Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)regions.Size, regions.Data);
+
+    VkImageMemoryBarrier use_barrier = copy_barrier;
+    use_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    use_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    use_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    use_barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &use_barrier);
+    backend_tex->Initialized = true;
+}
+
+void ImGui_ImplVulkan_UpdateTexture(ImTextureData* tex, VkCommandBuffer command_buffer, uint32_t frame_index)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    if (tex->Status == ImTextureStatus_WantCreate)
+    {
+        // Create and upload new texture to graphics system
+        //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
+        IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        ImGui_ImplVulkan_Texture* backend_tex = ImGui_ImplVulkan_CreateTextureImage(tex->Width, tex->Height);
+        ImTextureRect rect = { 0, 0, (unsigned short)tex->Width, (unsigned short)tex->Height };
+        ImGui_ImplVulkan_UploadTextureRects(backend_tex, (const unsigned char*)tex->GetPixels(), tex->GetPitch(), &rect, 1, command_buffer, frame_index);
+
+        // Store identifiers
+        tex->SetTexID((ImTextureID)backend_tex->DescriptorSet);
+        tex->BackendUserData = backend_tex;
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantUpdates)
+    {
+        ImGui_ImplVulkan_Texture* backend_tex = (ImGui_ImplVulkan_Texture*)tex->BackendUserData;
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        ImGui_ImplVulkan_UploadTextureRects(backend_tex, (const unsigned char*)tex->GetPixels(), tex->GetPitch(), tex->Updates.Data, tex->Updates.Size, command_buffer, frame_index);
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantDestroy)
+    {
+        // Frames in flight may still sample it: wait until it has been unused for long enough
+        if (tex->UnusedFrames < (int)bd->VulkanInitInfo.FramesInFlight)
+            return;
+        ImGui_ImplVulkan_Texture* backend_tex = (ImGui_ImplVulkan_Texture*)tex->BackendUserData;
+        if (backend_tex != nullptr)
+            ImGui_ImplVulkan_DestroyTextureImage(backend_tex);
+
+        // Clear identifiers and mark as destroyed (in order to allow e.g. calling InvalidateDeviceObjects while running)
+        tex->SetTexID(ImTextureID_Invalid);
+        tex->BackendUserData = nullptr;
+        tex->SetStatus(ImTextureStatus_Destroyed);
+    }
+}
+
+void ImGui_ImplVulkan_RecordTextureUploads(ImDrawData* draw_data, VkCommandBuffer command_buffer, uint32_t frame_index)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+
+    // Catch up with texture updates. Most of the times, the list will have 1 element with an OK status, aka nothing to do.
+    // (This almost always points to ImGui::GetPlatformIO().Textures[] but is part of ImDrawData to allow overriding or disabling texture updates).
+    if (draw_data->Textures != nullptr)
+        for (ImTextureData* tex : *draw_data->Textures)
+            if (tex->Status != ImTextureStatus_OK)
+                ImGui_ImplVulkan_UpdateTexture(tex, command_buffer, frame_index);
+
+    // Textures created by ImGui_ImplVulkan_CreateTexture() since the previous frame
+    if (bd->PendingUserTextures == 0)
+        return;
+    for (ImGui_ImplVulkan_Texture* backend_tex : bd->UserTextures)
+        if (backend_tex->PendingPixels != nullptr)
+        {
+            ImTextureRect rect = { 0, 0, (unsigned short)backend_tex->Width, (unsigned short)backend_tex->Height };
+            ImGui_ImplVulkan_UploadTextureRects(backend_tex, backend_tex->PendingPixels, backend_tex->Width * 4, &rect, 1, command_buffer, frame_index);
+            IM_FREE(backend_tex->PendingPixels);
+            backend_tex->PendingPixels = nullptr;
+        }
+    bd->PendingUserTextures = 0;
+}
+
+VkDescriptorSet ImGui_ImplVulkan_AddTexture(VkSampler sampler, VkImageView image_view, VkImageLayout image_layout)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    for (const ImGui_ImplVulkan_CachedDescriptor& cached : bd->Descriptors)
+        if (cached.Sampler == sampler && cached.ImageView == image_view && cached.ImageLayout == image_layout)
+            return cached.DescriptorSet;
+
+    // Create Descriptor Set:
+    VkDescriptorSet descriptor_set;
+    {
+        VkDescriptorSetAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        alloc_info.descriptorPool = bd->DescriptorPool;
+        alloc_info.descriptorSetCount = 1;
+        alloc_info.pSetLayouts = &bd->DescriptorSetLayout;
+        VkResult err = vkAllocateDescriptorSets(v->Device, &alloc_info, &descriptor_set);
+        check_vk_result(err);
+    }
+
+    // Update the Descriptor Set:
+    {
+        VkDescriptorImageInfo desc_image[1] = {};
+        desc_image[0].sampler = sampler;
+        desc_image[0].imageView = image_view;
+        desc_image[0].imageLayout = image_layout;
+        VkWriteDescriptorSet write_desc[1] = {};
+        write_desc[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_desc[0].dstSet = descriptor_set;
+        write_desc[0].descriptorCount = 1;
+        write_desc[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write_desc[0].pImageInfo = desc_image;
+        vkUpdateDescriptorSets(v->Device, 1, write_desc, 0, nullptr);
+    }
+    ImGui_ImplVulkan_CachedDescriptor cached = { sampler, image_view, image_layout, descriptor_set };
+    bd->Descriptors.push_back(cached);
+    return descriptor_set;
+}
+
+void ImGui_ImplVulkan_RemoveTexture(VkDescriptorSet descriptor_set)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    for (int n = 0; n < bd->Descriptors.Size; n++)
+        if (bd->Descriptors[n].DescriptorSet == descriptor_set)
+        {
+            bd->Descriptors.erase(bd->Descriptors.Data + n);
+            break;
+        }
+    vkFreeDescriptorSets(v->Device, bd->DescriptorPool, 1, &descriptor_set);
+}
+
+ImTextureID ImGui_ImplVulkan_CreateTexture(const void* pixels, int width, int height)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_Texture* backend_tex = ImGui_ImplVulkan_CreateTextureImage(width, height);
+
+    // Keep a copy until ImGui_ImplVulkan_RecordTextureUploads() has a command buffer to record the upload in
+    size_t size = (size_t)width * height * 4;
+    backend_tex->PendingPixels = (unsigned char*)IM_ALLOC(size);
+    memcpy(backend_tex->PendingPixels, pixels, size);
+    bd->PendingUserTextures++;
+    bd->UserTextures.push_back(backend_tex);
+    return (ImTextureID)backend_tex->DescriptorSet;
+}
+
+void ImGui_ImplVulkan_DestroyTexture(ImTextureID tex_id)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    for (int n = 0; n < bd->UserTextures.Size; n++)
+        if ((ImTextureID)bd->UserTextures[n]->DescriptorSet == tex_id)
+        {
+            VkResult err = vkDeviceWaitIdle(bd->VulkanInitInfo.Device);
+            check_vk_result(err);
+            ImGui_ImplVulkan_DestroyTextureImage(bd->UserTextures[n]);
+            bd->UserTextures.erase(bd->UserTextures.Data + n);
+            return;
+        }
+}
+
+//-----------------------------------------------------------------------------
+// Device objects
+//-----------------------------------------------------------------------------
+
+static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkRenderPass render_pass, VkSampleCountFlagBits msaa_samples, uint32_t subpass, VkPipeline* pipeline)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+
+    VkPipelineShaderStageCreateInfo stage[2] = {};
+    stage[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stage[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stage[0].module = bd->ShaderModuleVert;
+    stage[0].pName = "main";
+    stage[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stage[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stage[1].module = bd->ShaderModuleFrag;
+    stage[1].pName = "main";
+
+    VkVertexInputBindingDescription binding_desc[1] = {};
+    binding_desc[0].stride = sizeof(ImDrawVert);
+    binding_desc[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    VkVertexInputAttributeDescription attribute_desc[3] = {};
+    attribute_desc[0].location = 0;
+    attribute_desc[0].binding = binding_desc[0].binding;
+    attribute_desc[0].format = VK_FORMAT_R32G32_SFLOAT;
+    attribute_desc[0].offset = offsetof(ImDrawVert, pos);
+    attribute_desc[1].location = 1;
+    attribute_desc[1].binding = binding_desc[0].binding;
+    attribute_desc[1].format = VK_FORMAT_R32G32_SFLOAT;
+    attribute_desc[1].offset = offsetof(ImDrawVert, uv);
+    attribute_desc[2].location = 2;
+    attribute_desc[2].binding = binding_desc[0].binding;
+    attribute_desc[2].format = VK_FORMAT_R8G8B8A8_UNORM;
+    attribute_desc[2].offset = offsetof(ImDrawVert, col);
+
+    VkPipelineVertexInputStateCreateInfo vertex_info = {};
+    vertex_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertex_info.vertexBindingDescriptionCount = 1;
+    vertex_info.pVertexBindingDescriptions = binding_desc;
+    vertex_info.vertexAttributeDescriptionCount = 3;
+    vertex_info.pVertexAttributeDescriptions = attribute_desc;
+
+    VkPipelineInputAssemblyStateCreateInfo ia_info = {};
+    ia_info.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    ia_info.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewport_info = {};
+    viewport_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport_info.viewportCount = 1;
+    viewport_info.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo raster_info = {};
+    raster_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    raster_info.polygonMode = VK_POLYGON_MODE_FILL;
+    raster_info.cullMode = VK_CULL_MODE_NONE;
+    raster_info.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    raster_info.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo ms_info = {};
+    ms_info.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    ms_info.rasterizationSamples = (msaa_samples != 0) ? msaa_samples : VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState color_attachment[1] = {};
+    color_attachment[0].blendEnable = VK_TRUE;
+    color_attachment[0].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    color_attachment[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    color_attachment[0].colorBlendOp = VK_BLEND_OP_ADD;
+    color_attachment[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    color_attachment[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    color_attachment[0].alphaBlendOp = VK_BLEND_OP_ADD;
+    color_attachment[0].colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depth_info = {};
+    depth_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+
+    VkPipelineColorBlendStateCreateInfo blend_info = {};
+    blend_info.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    blend_info.attachmentCount = 1;
+    blend_info.pAttachments = color_attachment;
+
+    VkDynamicState dynamic_states[2] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    VkPipelineDynamicStateCreateInfo dynamic_state = {};
+    dynamic_state.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic_state.dynamicStateCount = (uint32_t)IM_ARRAYSIZE(dynamic_states);
+    dynamic_state.pDynamicStates = dynamic_states;
+
+    VkGraphicsPipelineCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    info.stageCount = 2;
+    info.pStages = stage;
+    info.pVertexInputState = &vertex_info;
+    info.pInputAssemblyState = &ia_info;
+    info.pViewportState = &viewport_info;
+    info.pRasterizationState = &raster_info;
+    info.pMultisampleState = &ms_info;
+    info.pDepthStencilState = &depth_info;
+    info.pColorBlendState = &blend_info;
+    info.pDynamicState = &dynamic_state;
+    info.layout = bd->PipelineLayout;
+    info.renderPass = render_pass;
+    info.subpass = subpass;
+    VkResult err = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &info, allocator, pipeline);
+    check_vk_result(err);
+}
+
+static bool ImGui_ImplVulkan_CreateDeviceObjects()
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    VkResult err;
+
+    vkGetPhysicalDeviceMemoryProperties(v->PhysicalDevice, &bd->MemoryProperties);
+
+    // Shader modules
+    {
+        VkShaderModuleCreateInfo vert_info = {};
+        vert_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        vert_info.codeSize = sizeof(__glsl_shader_vert_spv);
+        vert_info.pCode = (uint32_t*)__glsl_shader_vert_spv;
+        err = vkCreateShaderModule(v->Device, &vert_info, v->Allocator, &bd->ShaderModuleVert);
+        check_vk_result(err);
+        VkShaderModuleCreateInfo frag_info = {};
+        frag_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        frag_info.codeSize = sizeof(__glsl_shader_frag_spv);
+        frag_info.pCode = (uint32_t*)__glsl_shader_frag_spv;
+        err = vkCreateShaderModule(v->Device, &frag_info, v->Allocator, &bd->ShaderModuleFrag);
+        check_vk_result(err);
+    }
+
+    // Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling.
+    {
+        VkSamplerCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        info.magFilter = VK_FILTER_LINEAR;
+        info.minFilter = VK_FILTER_LINEAR;
+        info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.minLod = -1000;
+        info.maxLod = 1000;
+        info.maxAnisotropy = 1.0f;
+        err = vkCreateSampler(v->Device, &info, v->Allocator, &bd->TexSampler);
+        check_vk_result(err);
+    }
+
+    // One combined image sampler per texture
+    {
+        VkDescriptorSetLayoutBinding binding[1] = {};
+        binding[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding[0].descriptorCount = 1;
+        binding[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        VkDescriptorSetLayoutCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        info.bindingCount = 1;
+        info.pBindings = binding;
+        err = vkCreateDescriptorSetLayout(v->Device, &info, v->Allocator, &bd->DescriptorSetLayout);
+        check_vk_result(err);
+    }
+    {
+        VkDescriptorPoolSize pool_size = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 256 };
+        VkDescriptorPoolCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        info.maxSets = pool_size.descriptorCount;
+        info.poolSizeCount = 1;
+        info.pPoolSizes = &pool_size;
+        err = vkCreateDescriptorPool(v->Device, &info, v->Allocator, &bd->DescriptorPool);
+        check_vk_result(err);
+    }
+
+    // Constants: we are using 'vec2 offset' and 'vec2 scale' instead of a full 3d projection matrix
+    {
+        VkPushConstantRange push_constants[1] = {};
+        push_constants[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        push_constants[0].offset = sizeof(float) * 0;
+        push_constants[0].size = sizeof(float) * 4;
+        VkDescriptorSetLayout set_layout[1] = { bd->DescriptorSetLayout };
+        VkPipelineLayoutCreateInfo layout_info = {};
+        layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_info.setLayoutCount = 1;
+        layout_info.pSetLayouts = set_layout;
+        layout_info.pushConstantRangeCount = 1;
+        layout_info.pPushConstantRanges = push_constants;
+        err = vkCreatePipelineLayout(v->Device, &layout_info, v->Allocator, &bd->PipelineLayout);
+        check_vk_result(err);
+    }
+
+    ImGui_ImplVulkan_CreatePipeline(v->Device, v->Allocator, v->RenderPass, v->MSAASamples, v->Subpass, &bd->Pipeline);
+
+    bd->FrameRenderBuffers.resize((int)v->FramesInFlight);
+    memset((void*)bd->FrameRenderBuffers.Data, 0, bd->FrameRenderBuffers.size_in_bytes());
+    for (ImGui_ImplVulkan_FrameRenderBuffers& rb : bd->FrameRenderBuffers)
+        rb.UploadFrameCount = -1;
+    return true;
+}
+
+static void ImGui_ImplVulkan_DestroyDeviceObjects()
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+
+    // Destroy all textures
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+        if (tex->RefCount == 1 && tex->BackendUserData != nullptr)
+        {
+            ImGui_ImplVulkan_DestroyTextureImage((ImGui_ImplVulkan_Texture*)tex->BackendUserData);
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->BackendUserData = nullptr;
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+    for (ImGui_ImplVulkan_Texture* backend_tex : bd->UserTextures)
+        ImGui_ImplVulkan_DestroyTextureImage(backend_tex);
+    bd->UserTextures.clear();
+
+    for (ImGui_ImplVulkan_FrameRenderBuffers& rb : bd->FrameRenderBuffers)
+    {
+        if (rb.VertexBuffer)         { vkDestroyBuffer(v->Device, rb.VertexBuffer, v->Allocator); }
+        if (rb.VertexBufferMemory)   { vkUnmapMemory(v->Device, rb.VertexBufferMemory); vkFreeMemory(v->Device, rb.VertexBufferMemory, v->Allocator); }
+        if (rb.IndexBuffer)          { vkDestroyBuffer(v->Device, rb.IndexBuffer, v->Allocator); }
+        if (rb.IndexBufferMemory)    { vkUnmapMemory(v->Device, rb.IndexBufferMemory); vkFreeMemory(v->Device, rb.IndexBufferMemory, v->Allocator); }
+        if (rb.UploadBuffer)         { vkDestroyBuffer(v->Device, rb.UploadBuffer, v->Allocator); }
+        if (rb.UploadBufferMemory)   { vkUnmapMemory(v->Device, rb.UploadBufferMemory); vkFreeMemory(v->Device, rb.UploadBufferMemory, v->Allocator); }
+    }
+    bd->FrameRenderBuffers.clear();
+    for (ImGui_ImplVulkan_RetiredBuffer& retired : bd->RetiredUploadBuffers)
+    {
+        vkDestroyBuffer(v->Device, retired.Buffer, v->Allocator);
+        vkUnmapMemory(v->Device, retired.Memory);
+        vkFreeMemory(v->Device, retired.Memory, v->Allocator);
+    }
+    bd->RetiredUploadBuffers.clear();
+
+    if (bd->ShaderModuleVert)     { vkDestroyShaderModule(v->Device, bd->ShaderModuleVert, v->Allocator); bd->ShaderModuleVert = VK_NULL_HANDLE; }
+    if (bd->ShaderModuleFrag)     { vkDestroyShaderModule(v->Device, bd->ShaderModuleFrag, v->Allocator); bd->ShaderModuleFrag = VK_NULL_HANDLE; }
+    if (bd->TexSampler)           { vkDestroySampler(v->Device, bd->TexSampler, v->Allocator); bd->TexSampler = VK_NULL_HANDLE; }
+    if (bd->DescriptorSetLayout)  { vkDestroyDescriptorSetLayout(v->Device, bd->DescriptorSetLayout, v->Allocator); bd->DescriptorSetLayout = VK_NULL_HANDLE; }
+    if (bd->PipelineLayout)       { vkDestroyPipelineLayout(v->Device, bd->PipelineLayout, v->Allocator); bd->PipelineLayout = VK_NULL_HANDLE; }
+    if (bd->Pipeline)             { vkDestroyPipeline(v->Device, bd->Pipeline, v->Allocator); bd->Pipeline = VK_NULL_HANDLE; }
+    if (bd->DescriptorPool)       { vkDestroyDescriptorPool(v->Device, bd->DescriptorPool, v->Allocator); bd->DescriptorPool = VK_NULL_HANDLE; }
+    bd->Descriptors.clear();
+}
+
+bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    IM_ASSERT(info->Instance != VK_NULL_HANDLE);
+    IM_ASSERT(info->PhysicalDevice != VK_NULL_HANDLE);
+    IM_ASSERT(info->Device != VK_NULL_HANDLE);
+    IM_ASSERT(info->Queue != VK_NULL_HANDLE);
+    IM_ASSERT(info->RenderPass != VK_NULL_HANDLE);
+    IM_ASSERT(info->FramesInFlight >= 1);
+
+    // Setup backend capabilities flags
+    ImGui_ImplVulkan_Data* bd = IM_NEW(ImGui_ImplVulkan_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_vulkan";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;   // We can honor ImGuiPlatformIO::Textures[] requests during render.
+
+    bd->VulkanInitInfo = *info;
+    if (!ImGui_ImplVulkan_CreateDeviceObjects())
+        IM_ASSERT(0 && "ImGui_ImplVulkan_CreateDeviceObjects() failed!"); // <- Can't be hit yet.
+
+    return true;
+}
+
+void ImGui_ImplVulkan_Shutdown()
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+
+    // Frames in flight may still use our buffers and textures
+    VkResult err = vkQueueWaitIdle(bd->VulkanInitInfo.Queue);
+    check_vk_result(err);
+    ImGui_ImplVulkan_DestroyDeviceObjects();
+
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+    platform_io.ClearRendererHandlers();
+    IM_DELETE(bd);
+}
+
+void ImGui_ImplVulkan_NewFrame()
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplVulkan_Init()?");
+    IM_UNUSED(bd);
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,84 @@
+// dear imgui: Renderer Backend for Vulkan
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..)
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'VkDescriptorSet' as texture identifier. Call ImGui_ImplVulkan_AddTexture() to register one. Read the FAQ about ImTextureID/ImTextureRef!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Multiple frames in flight: vertices/indices go to persistently mapped host-visible buffers, one set per frame in flight.
+
+// The application owns the instance, device, queue, render pass and command buffers. It must:
+// - record ImGui_ImplVulkan_RecordTextureUploads() in the command buffer of the frame before its render pass begins,
+// - record ImGui_ImplVulkan_RenderDrawData() inside the render pass given at init, in the same command buffer,
+// - pass the index of the frame in flight being recorded, and have waited for the fence of its previous use,
+// - submit the command buffers in the order they were recorded: the backend never submits nor waits for the GPU.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+// About shaders:
+// - The SPIR-V shaders are compiled from backends/vulkan/glsl_shader.{vert,frag} at build time with glslc:
+//     glslc -mfmt=c -o glsl_shader.vert.inc glsl_shader.vert
+//     glslc -mfmt=c -o glsl_shader.frag.inc glsl_shader.frag
+//   and the output directory must be in the include path of imgui_impl_vulkan.cpp.
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+#include <vulkan/vulkan.h>
+
+// Initialization data, for ImGui_ImplVulkan_Init()
+struct ImGui_ImplVulkan_InitInfo
+{
+    VkInstance                      Instance;
+    VkPhysicalDevice                PhysicalDevice;
+    VkDevice                        Device;
+    uint32_t                        QueueFamily;
+    VkQueue                         Queue;
+    VkRenderPass                    RenderPass;         // Render pass RenderDrawData() is recorded in
+    uint32_t                        Subpass;
+    VkSampleCountFlagBits           MSAASamples;        // 0 defaults to VK_SAMPLE_COUNT_1_BIT
+    uint32_t                        FramesInFlight;     // Frames the application records before reusing one, >= 1 (typically 2 or 3)
+
+    // (Optional)
+    const VkAllocationCallbacks*    Allocator;
+    void                            (*CheckVkResultFn)(VkResult err);
+};
+
+// Follow "Getting Started" link and check examples/ folder to learn about using backends!
+IMGUI_IMPL_API bool     ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info);
+IMGUI_IMPL_API void     ImGui_ImplVulkan_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplVulkan_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplVulkan_RecordTextureUploads(ImDrawData* draw_data, VkCommandBuffer command_buffer, uint32_t frame_index);
+IMGUI_IMPL_API void     ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, uint32_t frame_index);
+
+// (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = nullptr to handle this manually.
+// Records outside of any render pass, staging through the buffers of 'frame_index'. Destruction is deferred until the texture has been unused for 'FramesInFlight' frames.
+IMGUI_IMPL_API void     ImGui_ImplVulkan_UpdateTexture(ImTextureData* tex, VkCommandBuffer command_buffer, uint32_t frame_index);
+
+// Register a texture for use as ImTextureID. Descriptor sets are cached: the same sampler/view/layout returns the same set.
+// Descriptor sets must stay alive until the frames using them have completed.
+IMGUI_IMPL_API VkDescriptorSet ImGui_ImplVulkan_AddTexture(VkSampler sampler, VkImageView image_view, VkImageLayout image_layout);
+IMGUI_IMPL_API void     ImGui_ImplVulkan_RemoveTexture(VkDescriptorSet descriptor_set);
+
+// Upload RGBA8 pixels into a texture owned by the backend. The pixels are copied, the upload is recorded by the next ImGui_ImplVulkan_RecordTextureUploads().
+// Waits for the device to be idle on destruction.
+IMGUI_IMPL_API ImTextureID ImGui_ImplVulkan_CreateTexture(const void* pixels, int width, int height);
+IMGUI_IMPL_API void     ImGui_ImplVulkan_DestroyTexture(ImTextureID tex_id);
+
+// [BETA] Selected render state data shared with callbacks.
+// This is temporarily stored in GetPlatformIO().Renderer_RenderState during the ImGui_ImplVulkan_RenderDrawData() call.
+// (Please open an issue if you feel you need access to more data)
+struct ImGui_ImplVulkan_RenderState
+{
+    VkCommandBuffer     CommandBuffer;
+    VkPipeline          Pipeline;
+    VkPipelineLayout    PipelineLayout;
+};
+
+#endif // #ifndef IMGUI_DISABLE
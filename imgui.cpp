@@ -33,24 +33,91 @@
 #include <imgui_stdlib.h>
 #include <imgui_internal.h>
 
+// Renderer options only exist where the implementation has them, so scripts fail loudly instead of getting nothing
 #if defined(IMGUI_IMPL_SDL2)
 #include <imgui_sdl_impl.hpp>
+// Render driver and batching are SDL_Renderer hints
+#define IMGUI_CS_RENDER_DRIVER
+#define IMGUI_CS_RENDER_SCALE
 #elif defined(IMGUI_IMPL_DX9)
 #include <imgui_dx9_impl.hpp>
 #elif defined(IMGUI_IMPL_WIN32)
 #include <imgui_dx11_impl.hpp>
 #elif defined(IMGUI_IMPL_GL2)
 #include <imgui_gl2_impl.hpp>
+// Buffer objects instead of client-side arrays
+#define IMGUI_CS_VERTEX_BUFFERS
+#elif defined(IMGUI_IMPL_SOFTWARE)
+#include <imgui_software_impl.hpp>
+#elif defined(IMGUI_IMPL_VULKAN)
+#include <imgui_vulkan_impl.hpp>
 #else
 #include <imgui_gl3_impl.hpp>
+// Upload modes and merged uploads of vertices and indices
+#define IMGUI_CS_UPLOAD_MODES
+#define IMGUI_CS_RENDER_SCALE
+// Shape batches are drawn instanced by the OpenGL 3 backend, other implementations tessellate them
+#define IMGUI_CS_INSTANCED_SHAPES
+// So is SDF text, other implementations bake SDF fonts per size like any other font
+#define IMGUI_CS_SDF_TEXT
 #endif
 
+#include <imgui_font_budget.hpp>
+#include <imgui_font_cache.hpp>
+#include <imgui_font_data.hpp>
+#include <imgui_font_growth.hpp>
+#include <imgui_font_prewarm.hpp>
+#include <imgui_font_sdf.hpp>
+#include <imgui_profiler.hpp>
+#include <imgui_quality_governor.hpp>
+#include <imgui_simulation.hpp>
+#include <imgui_text_cache.hpp>
+#include <imgui_wrapped_text.hpp>
+
+// Route every CNI(...) registration through the binding profiler,
+// so call counts and wall time can be collected at runtime.
+// Bindings given by value go through CNI_PROFILED_V(...) instead of CNI_V(...).
+// Constants and visitors are not profiled.
+#undef CNI
+#define CNI(name) CNI_V(name, (imgui_cs::profiled<decltype(&name), &name>::bind(cni_profile_namespace, #name)))
+#define CNI_PROFILED_V(name, func) CNI_V(name, (imgui_cs::profile_value([] {}, func, cni_profile_namespace, #name)))
+// Names the CovScript namespace in the profiles of the bindings registered after it, first in every CNI_NAMESPACE
+#define CNI_PROFILE_NAMESPACE(name) constexpr const char *cni_profile_namespace = #name;
+
+namespace imgui_cs {
+	ImFont *load_font(const font &f, float size)
+	{
+		return load_font(f, size, ImFontConfig());
+	}
+
+	ImFont *load_font(const font &f, float size, const ImFontConfig &font_cfg_template)
+	{
+		ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+		ImFontConfig font_cfg = font_cfg_template;
+		ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "%s, %.0fpx", f.name, (float) size);
+		if (f.bytes == nullptr)
+			return font_data_pool::get().add_embedded(f.data, size, font_cfg, [&](ImFontConfig &cfg) {
+				return atlas->AddFontFromMemoryCompressedBase85TTF(f.data, size, &cfg);
+			});
+		if (f.compressed)
+			return font_data_pool::get().add_embedded(f.bytes, size, font_cfg, [&](ImFontConfig &cfg) {
+				return atlas->AddFontFromMemoryCompressedTTF(f.bytes, static_cast<int>(f.size), size, &cfg);
+			});
+		// The array lives in the read-only data of the module, stb_truetype never writes to it
+		font_cfg.FontDataOwnedByAtlas = false;
+		return atlas->AddFontFromMemoryTTF(const_cast<unsigned char *>(f.bytes), static_cast<int>(f.size), size,
+		                                   &font_cfg);
+	}
+}
 
 CNI_ROOT_NAMESPACE {
+	constexpr const char *cni_profile_namespace = nullptr;
 	using namespace cs;
 	using namespace imgui_cs;
 	using application_t = std::shared_ptr<application>;
 	using image_t = std::shared_ptr<image>;
+	using simulation_t = std::shared_ptr<simulation>;
+	using wrapped_text_t = std::shared_ptr<wrapped_text>;
 
 	CNI(get_monitor_count)
 
@@ -58,6 +125,12 @@ CNI_ROOT_NAMESPACE {
 
 	CNI(get_monitor_height)
 
+#ifdef IMGUI_CS_RENDER_DRIVER
+	CNI(set_render_driver)
+
+	CNI(set_render_batching)
+#endif
+
 // ImGui Application
 	application_t fullscreen_application(std::size_t monitor_id, const string &title)
 	{
@@ -73,8 +146,19 @@ CNI_ROOT_NAMESPACE {
 
 	CNI(window_application)
 
+#ifdef IMGUI_IMPL_SOFTWARE
+	application_t software_application(std::size_t width, std::size_t height)
+	{
+		return std::make_shared<application>(width, height, "");
+	}
+
+	CNI(software_application)
+#endif
+
 	CNI_NAMESPACE(application)
 	{
+		CNI_PROFILE_NAMESPACE(application)
+
 		int get_window_width(application_t &app) {
 			return app->get_window_width();
 		}
@@ -112,7 +196,13 @@ CNI_ROOT_NAMESPACE {
 		CNI(is_closed)
 
 		void prepare(application_t &app) {
+			binding_profiler::get().next_frame();
+			quality_governor::get().next_frame();
+			font_atlas_budget::get().next_frame();
+			font_atlas_growth::get().next_frame();
+			text_size_cache::get().next_frame();
 			app->prepare();
+			simulation::publish_all();
 		}
 
 		CNI(prepare)
@@ -122,6 +212,203 @@ CNI_ROOT_NAMESPACE {
 		}
 
 		CNI(render)
+
+		void set_threaded_render(application_t &app, bool enabled) {
+			app->set_threaded_render(enabled);
+		}
+
+		CNI(set_threaded_render)
+
+		bool is_threaded_render(application_t &app) {
+			return app->is_threaded_render();
+		}
+
+		CNI(is_threaded_render)
+
+#ifdef IMGUI_CS_UPLOAD_MODES
+		int set_upload_mode(application_t &app, int mode) {
+			return app->set_upload_mode(mode);
+		}
+
+		CNI(set_upload_mode)
+
+		int get_upload_mode(application_t &app) {
+			return app->get_upload_mode();
+		}
+
+		CNI(get_upload_mode)
+
+		bool set_merged_upload(application_t &app, bool enabled) {
+			return app->set_merged_upload(enabled);
+		}
+
+		CNI(set_merged_upload)
+
+		bool is_merged_upload(application_t &app) {
+			return app->is_merged_upload();
+		}
+
+		CNI(is_merged_upload)
+#endif
+#ifdef IMGUI_CS_VERTEX_BUFFERS
+
+		bool set_vertex_buffers(application_t &app, bool enabled) {
+			return app->set_vertex_buffers(enabled);
+		}
+
+		CNI(set_vertex_buffers)
+
+		bool is_vertex_buffers(application_t &app) {
+			return app->is_vertex_buffers();
+		}
+
+		CNI(is_vertex_buffers)
+#endif
+
+		string get_render_driver(application_t &app) {
+			return app->get_render_driver();
+		}
+
+		CNI(get_render_driver)
+#ifdef IMGUI_CS_RENDER_SCALE
+
+		float set_render_scale(application_t &app, float scale) {
+			return app->set_render_scale(scale);
+		}
+
+		CNI(set_render_scale)
+
+		float get_render_scale(application_t &app) {
+			return app->get_render_scale();
+		}
+
+		CNI(get_render_scale)
+
+		void set_render_budget(application_t &app, float budget_ms) {
+			app->set_render_budget(budget_ms);
+		}
+
+		CNI(set_render_budget)
+#endif
+#ifdef IMGUI_IMPL_SOFTWARE
+
+		void save_framebuffer(application_t &app, const string &path) {
+			app->save_framebuffer(path);
+		}
+
+		CNI(save_framebuffer)
+
+		void set_framebuffer_stream(application_t &app, const string &path) {
+			app->set_framebuffer_stream(path);
+		}
+
+		CNI(set_framebuffer_stream)
+#endif
+	}
+
+// Simulation
+	// The update function is called as update(sim) at tick_rate Hz, from application.prepare() on the script
+	// thread: the ticks due since the previous frame run as the frame begins, so it must not draw.
+	// Between frames, the script may write the slots the next tick reads, e.g. to pass input on.
+	simulation_t start_simulation(const var &update, std::size_t slots, double tick_rate)
+	{
+		simulation_t sim = std::make_shared<simulation>(slots, tick_rate);
+		sim->start_stepped([update](const simulation_t &self) {
+			cs::invoke(update, var::make<simulation_t>(self));
+		});
+		return sim;
+	}
+
+	CNI(start_simulation)
+
+	CNI_NAMESPACE(simulation)
+	{
+		CNI_PROFILE_NAMESPACE(simulation)
+
+		void stop(simulation_t &sim) {
+			sim->stop();
+		}
+
+		CNI(stop)
+
+		bool is_running(simulation_t &sim) {
+			sim->check_error();
+			return sim->is_running();
+		}
+
+		CNI(is_running)
+
+		std::size_t get_ticks(simulation_t &sim) {
+			return static_cast<std::size_t>(sim->get_ticks());
+		}
+
+		CNI(get_ticks)
+
+		std::size_t get_slot_count(simulation_t &sim) {
+			return sim->get_slot_count();
+		}
+
+		CNI(get_slot_count)
+
+		double get_delta_time(simulation_t &sim) {
+			return sim->get_delta_time();
+		}
+
+		CNI(get_delta_time)
+
+		double get(simulation_t &sim, std::size_t slot) {
+			return sim->get(slot);
+		}
+
+		CNI(get)
+
+		void set(simulation_t &sim, std::size_t slot, double value) {
+			sim->set(slot, value);
+		}
+
+		CNI(set)
+
+		double get_time(simulation_t &sim) {
+			return sim->get_time();
+		}
+
+		CNI(get_time)
+
+		ImVec2 get_mouse_pos(simulation_t &sim) {
+			return sim->get_mouse_pos();
+		}
+
+		CNI(get_mouse_pos)
+
+		ImVec2 get_display_size(simulation_t &sim) {
+			return sim->get_display_size();
+		}
+
+		CNI(get_display_size)
+
+		bool is_mouse_down(simulation_t &sim, int button) {
+			return sim->is_mouse_down(button);
+		}
+
+		CNI(is_mouse_down)
+
+		bool is_mouse_clicked(simulation_t &sim, int button) {
+			return sim->is_mouse_clicked(button);
+		}
+
+		CNI(is_mouse_clicked)
+
+		bool is_key_down(simulation_t &sim, ImGuiKey key) {
+			return sim->is_key_down(key);
+		}
+
+		CNI(is_key_down)
+
+		bool is_key_pressed(simulation_t &sim, ImGuiKey key) {
+			return sim->is_key_pressed(key);
+		}
+
+		CNI(is_key_pressed)
 	}
 
 // ImGui Image
@@ -134,6 +421,8 @@ CNI_ROOT_NAMESPACE {
 
 	CNI_NAMESPACE(image_type)
 	{
+		CNI_PROFILE_NAMESPACE(image_type)
+
 		int get_width(const image_t &image) {
 			return image->get_width();
 		}
@@ -149,7 +438,7 @@ CNI_ROOT_NAMESPACE {
 
 // ImGui Functions
 
-	CNI_V(get_time, ImGui::GetTime)
+	CNI_PROFILED_V(get_time, ImGui::GetTime)
 
 	ImVec2 vec2(float a, float b)
 	{
@@ -198,10 +487,68 @@ CNI_ROOT_NAMESPACE {
 
 	CNI(get_framerate)
 
+	// Bytes of vertices and indices of the last rendered frame, 12 bytes per vertex in imgui_compact and 20 otherwise
+	int get_draw_data_size()
+	{
+		ImDrawData *draw_data = ImGui::GetDrawData();
+		if (draw_data == nullptr)
+			return 0;
+		return draw_data->TotalVtxCount * sizeof(ImDrawVert) + draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+	}
+
+	CNI(get_draw_data_size)
+
+// Profiling
+	void enable_binding_profile(bool enabled)
+	{
+		binding_profiler::get().set_enabled(enabled);
+	}
+
+	CNI(enable_binding_profile)
+
+	void reset_binding_profile()
+	{
+		binding_profiler::get().reset();
+	}
+
+	CNI(reset_binding_profile)
+
+	string dump_binding_profile(std::size_t frames, std::size_t top)
+	{
+		return binding_profiler::get().dump(frames, top);
+	}
+
+	CNI(dump_binding_profile)
+
+// Quality Governor
+	// Lowers anti-aliasing, circle tessellation and the update rate of throttled widgets while frames take longer than budget_ms
+	void set_quality_budget(float budget_ms)
+	{
+		quality_governor::get().set_budget(budget_ms);
+	}
+
+	CNI(set_quality_budget)
+
+	int get_quality_level()
+	{
+		return quality_governor::get().get_level();
+	}
+
+	CNI(get_quality_level)
+
+	// Throttled widgets only refresh their content when this is true, i.e. every frame at full quality
+	bool is_update_frame()
+	{
+		return ImGui::GetFrameCount() % quality_governor::get().get_update_interval() == 0;
+	}
+
+	CNI(is_update_frame)
+
 // Styles and Fonts
+	// The file is mapped and shared with every other font added from the same file or content
 	ImFont *add_font(const string &str, float size)
 	{
-		return ImGui::GetIO().Fonts->AddFontFromFileTTF(str.c_str(), size);
+		return font_data_pool::get().add_font(str, size);
 	}
 
 	CNI(add_font)
@@ -210,7 +557,7 @@ CNI_ROOT_NAMESPACE {
 	{
 		// v1.92.0+: glyphs are dynamically rasterized on first use (requires RendererHasTextures backend).
 		// CJK characters render correctly, though first use may cause a brief rasterization delay.
-		// For heavy CJK usage, pass GetGlyphRangesChineseSimplifiedCommon() explicitly for pre-baking.
+		// For heavy CJK usage, prewarm_font(font, size, "chinese_simplified_common") rasterizes them in the background.
 		return add_font(str, size);
 	}
 
@@ -218,19 +565,14 @@ CNI_ROOT_NAMESPACE {
 
 	ImFont *add_font_default(float size)
 	{
-		ImFontConfig font_cfg = ImFontConfig();
-		ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "DefaultFont, %.0fpx", (float) size);
-		return ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(get_default_font_data(), size,
-		        &font_cfg);
+		return load_font(get_default_font(), size);
 	}
 
 	CNI(add_font_default)
 
 	ImFont *add_font_extend(const font &f, float size)
 	{
-		ImFontConfig font_cfg = ImFontConfig();
-		ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "%s, %.0fpx", f.name, (float) size);
-		return ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(f.data, size, &font_cfg);
+		return load_font(f, size);
 	}
 
 	CNI(add_font_extend)
@@ -239,12 +581,95 @@ CNI_ROOT_NAMESPACE {
 	{
 		// v1.92.0+: glyphs are dynamically rasterized on first use (requires RendererHasTextures backend).
 		// CJK characters render correctly, though first use may cause a brief rasterization delay.
-		// For heavy CJK usage, pass GetGlyphRangesChineseSimplifiedCommon() explicitly for pre-baking.
+		// For heavy CJK usage, prewarm_font(font, size, "chinese_simplified_common") rasterizes them in the background.
 		return add_font_extend(f, size);
 	}
 
 	CNI(add_font_extend_cn)
 
+	// Fonts baked once as signed distance fields, which add_text() draws at any size without baking it.
+	// Widgets draw them blurry, push regular fonts for those. Without SDF text support in the renderer,
+	// these are regular fonts baked per size.
+	ImFont *add_font_sdf(const string &str, float size)
+	{
+#ifdef IMGUI_CS_SDF_TEXT
+		if (ImGui_ImplOpenGL3_HasSdfText())
+			return sdf_font_loader::bake(font_data_pool::get().add_font(str, size, sdf_font_loader::get().config()));
+#endif
+		return add_font(str, size);
+	}
+
+	CNI(add_font_sdf)
+
+	ImFont *add_font_default_sdf(float size)
+	{
+#ifdef IMGUI_CS_SDF_TEXT
+		if (ImGui_ImplOpenGL3_HasSdfText())
+			return sdf_font_loader::bake(load_font(get_default_font(), size, sdf_font_loader::get().config()));
+#endif
+		return add_font_default(size);
+	}
+
+	CNI(add_font_default_sdf)
+
+	bool is_font_sdf(ImFont *font)
+	{
+		return sdf_font_loader::get().is_sdf(font);
+	}
+
+	CNI(is_font_sdf)
+
+	// Rasterize a named set of glyph ranges on a worker thread, committed to the atlas a slice per frame.
+	// Returns the number of glyphs queued, glyphs already in the atlas are not counted.
+	int prewarm_font(ImFont *font, float size, const string &ranges)
+	{
+		static const std::pair<const char *, const ImWchar *(ImFontAtlas::*)()> named_ranges[] = {
+			{"default", &ImFontAtlas::GetGlyphRangesDefault},
+			{"greek", &ImFontAtlas::GetGlyphRangesGreek},
+			{"korean", &ImFontAtlas::GetGlyphRangesKorean},
+			{"japanese", &ImFontAtlas::GetGlyphRangesJapanese},
+			{"chinese_full", &ImFontAtlas::GetGlyphRangesChineseFull},
+			{"chinese_simplified_common", &ImFontAtlas::GetGlyphRangesChineseSimplifiedCommon},
+			{"cyrillic", &ImFontAtlas::GetGlyphRangesCyrillic},
+			{"thai", &ImFontAtlas::GetGlyphRangesThai},
+			{"vietnamese", &ImFontAtlas::GetGlyphRangesVietnamese}
+		};
+		for (const auto &named : named_ranges)
+			if (ranges == named.first)
+				return static_cast<int>(font_prewarmer::get().prewarm(font, size, (ImGui::GetIO().Fonts->*named.second)()));
+		throw cs::lang_error("Unknown glyph ranges \"" + ranges + "\".");
+	}
+
+	CNI(prewarm_font)
+
+	// Same as prewarm_font with the characters of a UTF-8 text, e.g. the strings of a script
+	int prewarm_font_text(ImFont *font, float size, const string &text)
+	{
+		ImFontGlyphRangesBuilder builder;
+		builder.AddText(text.c_str(), text.c_str() + text.size());
+		ImVector<ImWchar> ranges;
+		builder.BuildRanges(&ranges);
+		return static_cast<int>(font_prewarmer::get().prewarm(font, size, ranges.Data));
+	}
+
+	CNI(prewarm_font_text)
+
+	// Glyphs queued by prewarm_font which are not in the atlas yet
+	int get_prewarm_pending()
+	{
+		return static_cast<int>(font_prewarmer::get().get_pending());
+	}
+
+	CNI(get_prewarm_pending)
+
+	// At most count prewarmed glyphs are added to the atlas per frame, 64 by default
+	void set_prewarm_slice(int count)
+	{
+		font_prewarmer::get().set_slice(count);
+	}
+
+	CNI(set_prewarm_slice)
+
 	void push_font(ImFont *font)
 	{
 		ImGui::PushFont(font, font ? font->LegacySize : 0.0f);
@@ -280,6 +705,130 @@ CNI_ROOT_NAMESPACE {
 
 	CNI(set_font_scale)
 
+	// Bytes of pixels of the current font atlas texture, 1 per texel when it is Alpha8 and 4 when RGBA32
+	int get_font_atlas_memory()
+	{
+		ImTextureData *tex = ImGui::GetIO().Fonts->TexData;
+		return tex != nullptr ? tex->GetSizeInBytes() : 0;
+	}
+
+	CNI(get_font_atlas_memory)
+
+	int get_font_atlas_width()
+	{
+		ImTextureData *tex = ImGui::GetIO().Fonts->TexData;
+		return tex != nullptr ? tex->Width : 0;
+	}
+
+	CNI(get_font_atlas_width)
+
+	int get_font_atlas_height()
+	{
+		ImTextureData *tex = ImGui::GetIO().Fonts->TexData;
+		return tex != nullptr ? tex->Height : 0;
+	}
+
+	CNI(get_font_atlas_height)
+
+	// Texels of the atlas taken by glyphs, the rest of the texture is free for new ones
+	int get_font_atlas_used_area()
+	{
+		return font_atlas_budget::get_used_area(ImGui::GetIO().Fonts);
+	}
+
+	CNI(get_font_atlas_used_area)
+
+	int get_font_atlas_glyph_count()
+	{
+		return font_atlas_budget::get_glyph_count(ImGui::GetIO().Fonts);
+	}
+
+	CNI(get_font_atlas_glyph_count)
+
+	int get_font_atlas_repack_count()
+	{
+		return font_atlas_budget::get_repack_count(ImGui::GetIO().Fonts);
+	}
+
+	CNI(get_font_atlas_repack_count)
+
+	// Texture size, usage and the baked sizes of every font, as text
+	string dump_font_atlas()
+	{
+		return font_atlas_budget::get().dump(ImGui::GetIO().Fonts);
+	}
+
+	CNI(dump_font_atlas)
+
+	// Keep the atlas texture below bytes by discarding the sizes drawn least recently, 0 disables the budget
+	void set_font_atlas_budget(int bytes)
+	{
+		if (bytes < 0)
+			throw cs::lang_error("Invalid font atlas budget.");
+		font_atlas_budget::get().set_budget(bytes);
+	}
+
+	CNI(set_font_atlas_budget)
+
+	int get_font_atlas_budget()
+	{
+		return static_cast<int>(font_atlas_budget::get().get_budget());
+	}
+
+	CNI(get_font_atlas_budget)
+
+	// Discard every size not drawn in the last frame and shrink the atlas before the next frame
+	void compact_font_atlas()
+	{
+		font_atlas_budget::get().request_compact();
+	}
+
+	CNI(compact_font_atlas)
+
+	// Grow the atlas between frames, keeping glyphs in place, whenever less than this share of it is free.
+	// Avoids repacking every glyph in the middle of a frame when the atlas fills, 0 disables it.
+	void set_font_atlas_headroom(float headroom)
+	{
+		font_atlas_growth::get().set_headroom(headroom);
+	}
+
+	CNI(set_font_atlas_headroom)
+
+	// Make the atlas texture at least width x height, so that new glyphs never need a larger texture
+	void reserve_font_atlas(int width, int height)
+	{
+		font_atlas_growth::get().reserve(width, height);
+	}
+
+	CNI(reserve_font_atlas)
+
+	int get_font_atlas_growth_count()
+	{
+		return font_atlas_growth::get().get_growth_count();
+	}
+
+	CNI(get_font_atlas_growth_count)
+
+	// Keep rasterized glyphs in a file and map them back in on the next start, call it before the first frame.
+	// Returns whether an existing cache was loaded. New glyphs are written back when the application closes.
+	bool enable_font_cache(const string &path)
+	{
+		ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+		if (atlas->Locked)
+			throw cs::lang_error("Font cache can only be enabled outside of a frame.");
+		atlas->SetFontLoader(font_cache::get().open(path));
+		return font_cache::get().is_loaded();
+	}
+
+	CNI(enable_font_cache)
+
+	void save_font_cache()
+	{
+		font_cache::get().save();
+	}
+
+	CNI(save_font_cache)
+
 	void style_color_classic()
 	{
 		ImGui::StyleColorsClassic();
@@ -301,11 +850,11 @@ CNI_ROOT_NAMESPACE {
 
 	CNI(style_color_dark)
 
-	CNI_V(push_item_width, &ImGui::PushItemWidth)
+	CNI_PROFILED_V(push_item_width, &ImGui::PushItemWidth)
 
-	CNI_V(pop_item_width, &ImGui::PopItemWidth)
+	CNI_PROFILED_V(pop_item_width, &ImGui::PopItemWidth)
 
-	CNI_V(set_next_item_width, &ImGui::SetNextItemWidth)
+	CNI_PROFILED_V(set_next_item_width, &ImGui::SetNextItemWidth)
 
 	float get_item_width()
 	{
@@ -314,16 +863,53 @@ CNI_ROOT_NAMESPACE {
 
 	CNI(get_item_width)
 
+	// Sizes of texts are cached across frames, see text_size_cache
 	ImVec2 calc_text_size(const string &text)
 	{
-		const char* txt_beg = text.c_str();
-		const char* txt_end = txt_beg + text.size();
-		return ImGui::CalcTextSize(txt_beg, txt_end, true);
+		return text_size_cache::get().measure(ImGui::GetFont(), ImGui::GetFontSize(), text);
 	}
 
 	CNI(calc_text_size)
 
-	CNI_V(get_window_content_region_width, []()
+	// Size of text drawn with the current font at size, e.g. by add_text()
+	ImVec2 calc_text_size_at(const string &text, float size)
+	{
+		if (!(size > 0))
+			throw cs::lang_error("Invalid font size.");
+		return text_size_cache::get().measure(ImGui::GetFont(), size, text);
+	}
+
+	CNI(calc_text_size_at)
+
+	int get_text_cache_size()
+	{
+		return static_cast<int>(text_size_cache::get().get_size());
+	}
+
+	CNI(get_text_cache_size)
+
+	int get_text_cache_hits()
+	{
+		return text_size_cache::get().get_hits();
+	}
+
+	CNI(get_text_cache_hits)
+
+	int get_text_cache_misses()
+	{
+		return text_size_cache::get().get_misses();
+	}
+
+	CNI(get_text_cache_misses)
+
+	void clear_text_cache()
+	{
+		text_size_cache::get().clear();
+	}
+
+	CNI(clear_text_cache)
+
+	CNI_PROFILED_V(get_window_content_region_width, []()
 	{
 		return ImGui::GetWindowContentRegionMax().x - ImGui::GetWindowContentRegionMin().x;
 	})
@@ -573,34 +1159,94 @@ CNI_ROOT_NAMESPACE {
 	CNI(pop_id)
 
 // Widgets
+	// Texts are drawn unformatted: no printf-style pass, no strlen
 	void text(const string &str)
 	{
-		ImGui::TextUnformatted(str.c_str());
+		ImGui::TextUnformatted(str.c_str(), str.c_str() + str.size());
 	}
 
 	CNI(text)
 
 	void text_colored(const ImVec4 &col, const string &str)
 	{
-		ImGui::TextColored(col, "%s", str.c_str());
+		ImGui::PushStyleColor(ImGuiCol_Text, col);
+		ImGui::TextUnformatted(str.c_str(), str.c_str() + str.size());
+		ImGui::PopStyleColor();
 	}
 
 	CNI(text_colored)
 
 	void text_disabled(const string &str)
 	{
-		ImGui::TextDisabled("%s", str.c_str());
+		ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyle().Colors[ImGuiCol_TextDisabled]);
+		ImGui::TextUnformatted(str.c_str(), str.c_str() + str.size());
+		ImGui::PopStyleColor();
 	}
 
 	CNI(text_disabled)
 
 	void text_wrappered(const string &str)
 	{
-		ImGui::TextWrapped("%s", str.c_str());
+		// Same as ImGui::TextWrapped(), which keeps a wrap position pushed by the caller
+		const bool need_backup = ImGui::GetCurrentWindow()->DC.TextWrapPos < 0.0f;
+		if (need_backup)
+			ImGui::PushTextWrapPos(0.0f);
+		ImGui::TextUnformatted(str.c_str(), str.c_str() + str.size());
+		if (need_backup)
+			ImGui::PopTextWrapPos();
 	}
 
 	CNI(text_wrappered)
 
+	// Wrapped text keeping its line breaks between frames, see imgui_cs::wrapped_text
+	wrapped_text_t wrapped_text(const string &str)
+	{
+		return std::make_shared<imgui_cs::wrapped_text>(str);
+	}
+
+	CNI(wrapped_text)
+
+	CNI_NAMESPACE(wrapped_text_type)
+	{
+		CNI_PROFILE_NAMESPACE(wrapped_text_type)
+
+		void draw(wrapped_text_t &text) {
+			text->draw();
+		}
+
+		CNI(draw)
+
+		void set_text(wrapped_text_t &text, const string &str) {
+			text->set_text(str);
+		}
+
+		CNI(set_text)
+
+		void append(wrapped_text_t &text, const string &str) {
+			text->append(str);
+		}
+
+		CNI(append)
+
+		string get_text(const wrapped_text_t &text) {
+			return text->get_text();
+		}
+
+		CNI(get_text)
+
+		int get_line_count(const wrapped_text_t &text) {
+			return text->get_line_count();
+		}
+
+		CNI(get_line_count)
+
+		int get_layout_count(const wrapped_text_t &text) {
+			return text->get_layout_count();
+		}
+
+		CNI(get_layout_count)
+	}
+
 	void label_text(const string &label, const string &str)
 	{
 		ImGui::LabelText(label.c_str(), "%s", str.c_str());
@@ -1139,7 +1785,7 @@ CNI_ROOT_NAMESPACE {
 	CNI(is_any_item_focused)
 
 // Inputs
-	CNI_V(get_key_index, [](const var& key)
+	CNI_PROFILED_V(get_key_index, [](const var& key)
 	{
 		// Obsoleted, use is_key_pressed(key) directly.
 		return key;
@@ -1251,6 +1897,42 @@ CNI_ROOT_NAMESPACE {
 	CNI(set_clipboard_text)
 
 // Canvas
+	// Analytic shapes replace the tessellation of round shapes, see set_sdf_shapes()
+	static bool sdf_shapes = false;
+
+	bool set_sdf_shapes(bool enabled)
+	{
+#ifdef IMGUI_CS_INSTANCED_SHAPES
+		sdf_shapes = enabled && ImGui_ImplOpenGL3_HasInstancing();
+#endif
+		return sdf_shapes;
+	}
+
+	CNI(set_sdf_shapes)
+
+	// Returns false when the shape has to be tessellated
+	static bool add_sdf_shape(const ImVec2 &centre, const ImVec2 &size, const ImVec2 &axis, float rounding, float thickness, const ImVec4 &color)
+	{
+#ifdef IMGUI_CS_INSTANCED_SHAPES
+		if (sdf_shapes && size.x > 0 && size.y > 0)
+			return ImGui_ImplOpenGL3_AddSdfShape(ImGui::GetWindowDrawList(), {centre, size, axis, rounding, thickness, ImColor(color)});
+#endif
+		return false;
+	}
+
+	// Circles with fewer segments than automatically chosen are polygons, which are still tessellated
+	static bool is_round(float radius, float seg)
+	{
+		return seg <= 0 || seg >= ImGui::GetWindowDrawList()->_CalcCircleAutoSegmentCount(radius);
+	}
+
+	// Explicit segment counts are capped by the quality governor, automatic ones follow the style
+	static int clamp_segments(float seg)
+	{
+		const int max_segments = quality_governor::get().get_max_segments();
+		return max_segments > 0 && seg > max_segments ? max_segments : static_cast<int>(seg);
+	}
+
 	void add_line(const ImVec2 &a, const ImVec2 &b, const ImVec4 &color, float thickness)
 	{
 		ImGui::GetWindowDrawList()->AddLine(a, b, ImColor(color), thickness);
@@ -1260,6 +1942,9 @@ CNI_ROOT_NAMESPACE {
 
 	void add_rect(const ImVec2 &a, const ImVec2 &b, const ImVec4 &color, float rounding, float thickness)
 	{
+		// ImDrawList strokes rectangles half a pixel inside
+		if (sdf_shapes && add_sdf_shape(ImVec2((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f), ImVec2(ImFabs(b.x - a.x) * 0.5f - 0.5f, ImFabs(b.y - a.y) * 0.5f - 0.5f), ImVec2(1, 0), rounding, thickness, color))
+			return;
 		// v1.92.8: thickness before flags (ImDrawFlags_RoundCornersAll is default)
 		ImGui::GetWindowDrawList()->AddRect(a, b, ImColor(color), rounding, thickness);
 	}
@@ -1268,6 +1953,8 @@ CNI_ROOT_NAMESPACE {
 
 	void add_rect_filled(const ImVec2 &a, const ImVec2 &b, const ImVec4 &color, float rounding)
 	{
+		if (sdf_shapes && add_sdf_shape(ImVec2((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f), ImVec2(ImFabs(b.x - a.x) * 0.5f, ImFabs(b.y - a.y) * 0.5f), ImVec2(1, 0), rounding, 0, color))
+			return;
 		ImGui::GetWindowDrawList()->AddRectFilled(a, b, ImColor(color), rounding, ImDrawFlags_RoundCornersAll);
 	}
 
@@ -1304,21 +1991,72 @@ CNI_ROOT_NAMESPACE {
 
 	void add_circle(const ImVec2 &centre, float radius, const ImVec4 &color, float seg, float thickness)
 	{
-		ImGui::GetWindowDrawList()->AddCircle(centre, radius, ImColor(color), seg, thickness);
+		// ImDrawList strokes circles half a pixel inside
+		if (sdf_shapes && is_round(radius, seg) && add_sdf_shape(centre, ImVec2(radius - 0.5f, radius - 0.5f), ImVec2(1, 0), radius, thickness, color))
+			return;
+		ImGui::GetWindowDrawList()->AddCircle(centre, radius, ImColor(color), clamp_segments(seg), thickness);
 	}
 
 	CNI(add_circle)
 
 	void add_circle_filled(const ImVec2 &centre, float radius, const ImVec4 &color, float seg)
 	{
-		ImGui::GetWindowDrawList()->AddCircleFilled(centre, radius, ImColor(color), seg);
+		if (sdf_shapes && is_round(radius, seg) && add_sdf_shape(centre, ImVec2(radius, radius), ImVec2(1, 0), radius, 0, color))
+			return;
+		ImGui::GetWindowDrawList()->AddCircleFilled(centre, radius, ImColor(color), clamp_segments(seg));
 	}
 
 	CNI(add_circle_filled)
 
+	// Capsule: segment from a to b with round caps, i.e. every point within radius of the segment
+	static void path_capsule(ImDrawList *draw_list, const ImVec2 &a, const ImVec2 &b, float radius)
+	{
+		const float angle = ImAtan2(b.y - a.y, b.x - a.x);
+		draw_list->PathArcTo(b, radius, angle - IM_PI * 0.5f, angle + IM_PI * 0.5f);
+		draw_list->PathArcTo(a, radius, angle + IM_PI * 0.5f, angle + IM_PI * 1.5f);
+	}
+
+	static bool add_sdf_capsule(const ImVec2 &a, const ImVec2 &b, float radius, float thickness, const ImVec4 &color)
+	{
+		const ImVec2 d(b.x - a.x, b.y - a.y);
+		const float length = ImSqrt(d.x * d.x + d.y * d.y);
+		const ImVec2 axis = length > 0 ? ImVec2(d.x / length, d.y / length) : ImVec2(1, 0);
+		return add_sdf_shape(ImVec2((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f), ImVec2(length * 0.5f + radius, radius), axis, radius, thickness, color);
+	}
+
+	void add_capsule(const ImVec2 &a, const ImVec2 &b, float radius, const ImVec4 &color, float thickness)
+	{
+		if (sdf_shapes && add_sdf_capsule(a, b, radius - 0.5f, thickness, color))
+			return;
+		ImDrawList *draw_list = ImGui::GetWindowDrawList();
+		path_capsule(draw_list, a, b, radius - 0.5f);
+		draw_list->PathStroke(ImColor(color), ImDrawFlags_Closed, thickness);
+	}
+
+	CNI(add_capsule)
+
+	void add_capsule_filled(const ImVec2 &a, const ImVec2 &b, float radius, const ImVec4 &color)
+	{
+		if (sdf_shapes && add_sdf_capsule(a, b, radius, 0, color))
+			return;
+		ImDrawList *draw_list = ImGui::GetWindowDrawList();
+		path_capsule(draw_list, a, b, radius);
+		draw_list->PathFillConvex(ImColor(color));
+	}
+
+	CNI(add_capsule_filled)
+
 	void add_text(ImFont *font, float size, const ImVec2 &pos, const ImVec4 &color, const string &text)
 	{
-		ImGui::GetWindowDrawList()->AddText(font, size, pos, ImColor(color), text.c_str());
+		ImDrawList *draw_list = ImGui::GetWindowDrawList();
+#ifdef IMGUI_CS_SDF_TEXT
+		if (sdf_font_loader::get().is_sdf(font) && ImGui_ImplOpenGL3_PushSdfText(draw_list)) {
+			draw_list->AddText(font, size, pos, ImColor(color), text.c_str());
+			ImGui_ImplOpenGL3_PopSdfText(draw_list);
+			return;
+		}
+#endif
+		draw_list->AddText(font, size, pos, ImColor(color), text.c_str());
 	}
 
 	CNI(add_text)
@@ -1330,6 +2068,68 @@ CNI_ROOT_NAMESPACE {
 
 	CNI(add_image)
 
+// Shape Batches
+	static int batch_shape = -1;
+	static ImTextureID batch_texture = ImTextureID_Invalid;
+#ifdef IMGUI_CS_INSTANCED_SHAPES
+	static ImVector<ImGui_ImplOpenGL3_ShapeInstance> batch_instances;
+#endif
+
+	void begin_shape_batch(int shape)
+	{
+		if (batch_shape != -1)
+			throw cs::lang_error("Shape batch already begun.");
+		if (shape != 0 && shape != 1)
+			throw cs::lang_error("Unknown shape.");
+		batch_shape = shape;
+		batch_texture = ImTextureID_Invalid;
+	}
+
+	CNI(begin_shape_batch)
+
+	void begin_image_batch(const image_t &image)
+	{
+		begin_shape_batch(0);
+		batch_texture = image->get_texture_id();
+	}
+
+	CNI(begin_image_batch)
+
+	// Size is the half extent, i.e. the radius of circles
+	void add_shape_instance(const ImVec2 &centre, const ImVec2 &size, const ImVec4 &color)
+	{
+		if (batch_shape == -1)
+			throw cs::lang_error("Shape batch not begun.");
+#ifdef IMGUI_CS_INSTANCED_SHAPES
+		batch_instances.push_back({centre, size, ImColor(color)});
+#else
+		ImDrawList *draw_list = ImGui::GetWindowDrawList();
+		const ImVec2 a(centre.x - size.x, centre.y - size.y), b(centre.x + size.x, centre.y + size.y);
+		if (batch_shape == 1)
+			draw_list->AddEllipseFilled(centre, size, ImColor(color));
+		else if (batch_texture != ImTextureID_Invalid)
+			draw_list->AddImage(batch_texture, a, b, ImVec2(0, 0), ImVec2(1, 1), ImColor(color));
+		else
+			draw_list->AddRectFilled(a, b, ImColor(color));
+#endif
+	}
+
+	CNI(add_shape_instance)
+
+	void end_shape_batch()
+	{
+		if (batch_shape == -1)
+			throw cs::lang_error("Shape batch not begun.");
+#ifdef IMGUI_CS_INSTANCED_SHAPES
+		ImGui_ImplOpenGL3_AddShapeInstances(ImGui::GetWindowDrawList(), static_cast<ImGui_ImplOpenGL3_Shape>(batch_shape),
+		                                    batch_instances.Data, batch_instances.Size, batch_texture);
+		batch_instances.resize(0);
+#endif
+		batch_shape = -1;
+	}
+
+	CNI(end_shape_batch)
+
 	CNI_NAMESPACE(keys)
 	{
 		CNI_VALUE_CONST_V(tab, ImGuiKey, ImGuiKey_Tab)
@@ -1374,6 +2174,21 @@ CNI_ROOT_NAMESPACE {
 		CNI_VALUE_CONST_V(left_ctrl, ImGuiKey, ImGuiKey_LeftCtrl)
 	}
 
+#ifdef IMGUI_CS_UPLOAD_MODES
+	CNI_NAMESPACE(upload_modes)
+	{
+		CNI_VALUE_CONST_V(buffer_data, int, 0)
+		CNI_VALUE_CONST_V(map_range, int, 1)
+		CNI_VALUE_CONST_V(persistent_ring, int, 2)
+	}
+#endif
+
+	CNI_NAMESPACE(shapes)
+	{
+		CNI_VALUE_CONST_V(rect, int, 0)
+		CNI_VALUE_CONST_V(circle, int, 1)
+	}
+
 	CNI_NAMESPACE(dirs)
 	{
 		CNI_VALUE_CONST_V(left, ImGuiDir, ImGuiDir_Left)
@@ -1403,5 +2218,7 @@ CNI_ROOT_NAMESPACE {
 
 CNI_ENABLE_TYPE_EXT_V(application, cni_root_namespace::application_t, cs::imgui::application)
 CNI_ENABLE_TYPE_EXT_V(image_type, cni_root_namespace::image_t, cs::imgui::image)
+CNI_ENABLE_TYPE_EXT_V(simulation, cni_root_namespace::simulation_t, cs::imgui::simulation)
 CNI_ENABLE_TYPE_EXT_V(vec2_type, ImVec2, cs::imgui::vec2)
-CNI_ENABLE_TYPE_EXT_V(vec4_type, ImVec4, cs::imgui::vec4)
\ No newline at end of file
+CNI_ENABLE_TYPE_EXT_V(vec4_type, ImVec4, cs::imgui::vec4)
+CNI_ENABLE_TYPE_EXT_V(wrapped_text_type, cni_root_namespace::wrapped_text_t, cs::imgui::wrapped_text)
\ No newline at end of file
@@ -25,13 +25,39 @@
 #include <covscript/dll.hpp>
 #include <covscript/cni.hpp>
 
+struct ImFont;
+struct ImFontConfig;
+
 namespace imgui_cs {
+	// Font embedded in a module, generated by res/binary_to_compressed_c.cpp.
+	// Base85 strings (-base85) are decoded and decompressed into a heap copy when loaded,
+	// byte arrays (-bytes) are decompressed only when stb compressed,
+	// raw byte arrays (-bytes -nocompress) are read in place by the atlas for as long as the module is loaded.
 	struct font {
 		const char *name;
-		const char *data;
+		const char *data = nullptr;
+		const unsigned char *bytes = nullptr;
+		unsigned int size = 0;
+		bool compressed = false;
 
 		font(const char *n, const char *d) : name(n), data(d) {}
+
+		font(const char *n, const unsigned char *b, unsigned int s, bool c = false) : name(n), bytes(b), size(s),
+			compressed(c) {}
 	};
 
-	const char *get_default_font_data();
+	const unsigned char *get_default_font_data();
+
+	unsigned int get_default_font_size();
+
+	inline font get_default_font()
+	{
+		return font("DefaultFont", get_default_font_data(), get_default_font_size());
+	}
+
+	// Adds an embedded font to the current atlas, named "<name>, <size>px"
+	ImFont *load_font(const font &f, float size);
+
+	// Same with the other settings of font_cfg, e.g. its font loader
+	ImFont *load_font(const font &f, float size, const ImFontConfig &font_cfg);
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Compact Vertex Layout
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+
+// Included by imgui.h through IMGUI_USER_CONFIG, see the IMGUI_COMPACT_VERTEX option in CMakeLists.txt.
+// ImDrawVert shrinks from 20 to 12 bytes:
+// - pos: signed 16-bit fixed point. The step is 1/8 pixel while twice the display size fits (displays below 2048 pixels),
+//   and doubles for each doubling of the display, down to whole pixels: ImDrawVertPosOne() is set from io.DisplaySize as
+//   every frame begins (see ImGui_ImplOpenGL3_Init()), renderers divide by ImDrawVertPosOneFor(draw_data->DisplaySize).
+// - uv: unsigned 16-bit normalized, i.e. clamped to [0, 1].
+// - col: unchanged.
+// Dear ImGui writes and reads the fields as floats and ImVec2 through the conversions below,
+// renderers have to declare the attributes accordingly (see ImGui_ImplOpenGL3_SetupVertexAttribs()).
+// Coordinates further than twice the display size are clamped, which distorts geometry reaching far outside the display.
+#define IMGUI_COMPACT_DRAWVERT
+#define IMGUI_COMPACT_DRAWVERT_POS_ONE_MAX  8
+#define IMGUI_COMPACT_DRAWVERT_UV_ONE       65535
+
+#define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT                                                                      \
+	inline int &ImDrawVertPosOne()                                                                                 \
+	{                                                                                                              \
+		static int one = IMGUI_COMPACT_DRAWVERT_POS_ONE_MAX;                                                       \
+		return one;                                                                                                \
+	}                                                                                                              \
+	inline int ImDrawVertPosOneFor(const ImVec2 &display_size)                                                     \
+	{                                                                                                              \
+		const float extent = 2.0f * (display_size.x > display_size.y ? display_size.x : display_size.y);           \
+		int one = IMGUI_COMPACT_DRAWVERT_POS_ONE_MAX;                                                              \
+		while (one > 1 && 32767.0f / one < extent)                                                                 \
+			one /= 2;                                                                                              \
+		return one;                                                                                                \
+	}                                                                                                              \
+	struct ImDrawVertPosStep {                                                                                     \
+		static float get()                                                                                         \
+		{                                                                                                          \
+			return static_cast<float>(ImDrawVertPosOne());                                                         \
+		}                                                                                                          \
+	};                                                                                                             \
+	struct ImDrawVertUVStep {                                                                                      \
+		static float get()                                                                                         \
+		{                                                                                                          \
+			return static_cast<float>(IMGUI_COMPACT_DRAWVERT_UV_ONE);                                              \
+		}                                                                                                          \
+	};                                                                                                             \
+	template<typename T, typename Step, int Min, int Max>                                                          \
+	struct ImDrawVertFixed {                                                                                       \
+		T value;                                                                                                   \
+		ImDrawVertFixed &operator=(float f)                                                                        \
+		{                                                                                                          \
+			const float v = f * Step::get() + (f < 0.0f ? -0.5f : 0.5f);                                           \
+			value = static_cast<T>(v <= Min ? Min : (v >= Max ? Max : v));                                         \
+			return *this;                                                                                          \
+		}                                                                                                          \
+		operator float() const                                                                                     \
+		{                                                                                                          \
+			return static_cast<float>(value) / Step::get();                                                        \
+		}                                                                                                          \
+	};                                                                                                             \
+	template<typename T, typename Step, int Min, int Max>                                                          \
+	struct ImDrawVertFixed2 {                                                                                      \
+		ImDrawVertFixed<T, Step, Min, Max> x, y;                                                                   \
+		ImDrawVertFixed2 &operator=(const ImVec2 &v)                                                               \
+		{                                                                                                          \
+			x = v.x;                                                                                               \
+			y = v.y;                                                                                               \
+			return *this;                                                                                          \
+		}                                                                                                          \
+		operator ImVec2() const                                                                                    \
+		{                                                                                                          \
+			return ImVec2(x, y);                                                                                   \
+		}                                                                                                          \
+	};                                                                                                             \
+	struct ImDrawVert {                                                                                            \
+		ImDrawVertFixed2<signed short, ImDrawVertPosStep, -32768, 32767> pos;                                      \
+		ImDrawVertFixed2<unsigned short, ImDrawVertUVStep, 0, 65535> uv;                                           \
+		ImU32 col;                                                                                                 \
+	}
@@ -111,10 +111,7 @@ namespace imgui_cs {
 				CleanupDeviceD3D();
 				throw cs::lang_error("Failed to init DX11 renderer backend!");
 			}
-			ImFontConfig font_cfg = ImFontConfig();
-			ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "DefaultFont, 14px");
-			ImFont *font = ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(
-			                   get_default_font_data(), 14, &font_cfg);
+			ImFont *font = load_font(get_default_font(), 14);
 			if (font == nullptr) {
 				ImGui_ImplDX11_Shutdown();
 				ImGui_ImplWin32_Shutdown();
@@ -206,6 +203,23 @@ namespace imgui_cs {
 			bg_color = color;
 		}
 
+		// Presentation is tied to the window message loop thread.
+		void set_threaded_render(bool enabled)
+		{
+			if (enabled)
+				throw cs::lang_error("Threaded rendering is not supported by DirectX 11 implementation.");
+		}
+
+		bool is_threaded_render() const
+		{
+			return false;
+		}
+
+		std::string get_render_driver() const
+		{
+			return ImGui::GetIO().BackendRendererName;
+		}
+
 		bool is_closed()
 		{
 			bool done = false;
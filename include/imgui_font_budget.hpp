@@ -0,0 +1,215 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Font Atlas Budget
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace imgui_cs {
+	// Keeps the dynamic font atlas texture below a size in bytes.
+	// Every size a font is drawn at gets its own baked glyphs. ImGui only drops unused sizes once the texture
+	// is full and never shrinks it, so a burst of text at many sizes keeps its peak size for as long as the
+	// application runs. Once the texture exceeds the budget, the sizes drawn least recently are discarded until
+	// the packed glyphs fit the budget again, then the atlas is repacked into a smaller texture. Sizes drawn in
+	// the last frame are never discarded, and fonts with ImFontFlags_LockBakedSizes are left alone: when those
+	// alone exceed the budget, compaction backs off instead of repacking every frame.
+	// Discarded sizes are rasterized again when they are drawn again.
+	class font_atlas_budget final {
+		static constexpr int min_backoff_frames = 60;
+		static constexpr int max_backoff_frames = 1920;
+		// Share of a texture the packer reliably fills, a repack into a texture the glyphs would fill
+		// completely mostly ends up growing it again
+		static constexpr float pack_fill = 0.75f;
+
+		std::size_t m_budget = 0;
+		int m_backoff_frames = min_backoff_frames;
+		int m_wait_frames = 0;
+		bool m_compact_requested = false;
+		int m_compactions = 0;
+		int m_discarded = 0;
+
+		font_atlas_budget() = default;
+
+		// Discard least recently drawn sizes until the packed glyphs fit bytes, then repack.
+		// Returns whether the texture changed.
+		bool compact(ImFontAtlas *atlas, std::size_t bytes)
+		{
+			const float texels = pack_fill * bytes / atlas->TexData->BytesPerPixel;
+			ImFontAtlasBuilder *builder = atlas->Builder;
+			std::vector<ImFontBaked *> candidates;
+			for (int n = 0; n < builder->BakedPool.Size; ++n) {
+				ImFontBaked *baked = &builder->BakedPool[n];
+				if (baked->WantDestroy || (baked->OwnerFont->Flags & ImFontFlags_LockBakedSizes) || baked->LastUsedFrame >= builder->FrameCount)
+					continue;
+				candidates.push_back(baked);
+			}
+			std::sort(candidates.begin(), candidates.end(), [](const ImFontBaked *a, const ImFontBaked *b) {
+				return a->LastUsedFrame < b->LastUsedFrame;
+			});
+			for (ImFontBaked *baked : candidates) {
+				if (bytes != 0 && get_used_area(atlas) <= texels)
+					break;
+				ImFontAtlasBakedDiscard(atlas, baked->OwnerFont, baked);
+				++m_discarded;
+			}
+			const ImVec2i size = ImFontAtlasTextureGetSizeEstimate(atlas);
+			if (builder->RectsDiscardedCount == 0 && size.x == atlas->TexData->Width && size.y == atlas->TexData->Height)
+				return false;
+			ImFontAtlasTextureRepack(atlas, size.x, size.y);
+			++m_compactions;
+			return true;
+		}
+
+	public:
+		font_atlas_budget(const font_atlas_budget &) = delete;
+
+		font_atlas_budget(font_atlas_budget &&) noexcept = delete;
+
+		static font_atlas_budget &get()
+		{
+			static font_atlas_budget budget;
+			return budget;
+		}
+
+		// Budget of the atlas texture in bytes, 0 lets the atlas grow without bound.
+		void set_budget(std::size_t bytes)
+		{
+			m_budget = bytes;
+			m_backoff_frames = min_backoff_frames;
+			m_wait_frames = 0;
+		}
+
+		std::size_t get_budget() const
+		{
+			return m_budget;
+		}
+
+		// Compact the atlas before the next frame, discarding every size not drawn in the last frame
+		void request_compact()
+		{
+			m_compact_requested = true;
+		}
+
+		// Number of compactions done and of baked sizes discarded by them
+		int get_compaction_count() const
+		{
+			return m_compactions;
+		}
+
+		int get_discarded_count() const
+		{
+			return m_discarded;
+		}
+
+		// Called once per frame from application.prepare() before the new frame starts, while the atlas is unlocked.
+		void next_frame()
+		{
+			ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+			if (atlas->Builder == nullptr || atlas->TexData == nullptr || atlas->Locked)
+				return;
+			if (m_compact_requested) {
+				m_compact_requested = false;
+				compact(atlas, 0);
+				return;
+			}
+			if (m_budget == 0 || static_cast<std::size_t>(atlas->TexData->GetSizeInBytes()) <= m_budget)
+				return;
+			if (m_wait_frames > 0) {
+				--m_wait_frames;
+				return;
+			}
+			compact(atlas, m_budget);
+			if (static_cast<std::size_t>(atlas->TexData->GetSizeInBytes()) > m_budget) {
+				// The sizes in use do not fit, wait for some of them to fall out of use
+				m_wait_frames = m_backoff_frames;
+				if (m_backoff_frames < max_backoff_frames)
+					m_backoff_frames *= 2;
+			}
+			else
+				m_backoff_frames = min_backoff_frames;
+		}
+
+		// Texels taken by the glyphs and custom rectangles packed in the atlas
+		static int get_used_area(ImFontAtlas *atlas)
+		{
+			return atlas->Builder != nullptr ? atlas->Builder->RectsPackedSurface - atlas->Builder->RectsDiscardedSurface : 0;
+		}
+
+		static int get_glyph_count(ImFontAtlas *atlas)
+		{
+			int count = 0;
+			if (atlas->Builder != nullptr)
+				for (int n = 0; n < atlas->Builder->BakedPool.Size; ++n)
+					if (!atlas->Builder->BakedPool[n].WantDestroy)
+						count += atlas->Builder->BakedPool[n].Glyphs.Size;
+			return count;
+		}
+
+		// Number of times the atlas texture was replaced by a grown or repacked one
+		static int get_repack_count(ImFontAtlas *atlas)
+		{
+			return atlas->TexNextUniqueID > 2 ? atlas->TexNextUniqueID - 2 : 0;
+		}
+
+		// Texture and every baked size of every font of the atlas, least recently drawn last
+		std::string dump(ImFontAtlas *atlas) const
+		{
+			char line[256];
+			std::string result;
+			const ImTextureData *tex = atlas->TexData;
+			std::snprintf(line, sizeof(line), "Font atlas %dx%d, %d bytes, budget %zu bytes, %d texels used, %d glyphs\n",
+			              tex != nullptr ? tex->Width : 0, tex != nullptr ? tex->Height : 0, tex != nullptr ? tex->GetSizeInBytes() : 0,
+			              m_budget, get_used_area(atlas), get_glyph_count(atlas));
+			result += line;
+			std::snprintf(line, sizeof(line), "Repacks: %d, compactions: %d, sizes discarded: %d\n", get_repack_count(atlas),
+			              m_compactions, m_discarded);
+			result += line;
+			if (atlas->Builder == nullptr)
+				return result;
+			const int frame = atlas->Builder->FrameCount;
+			for (ImFont *font : atlas->Fonts) {
+				std::vector<const ImFontBaked *> bakeds;
+				for (int n = 0; n < atlas->Builder->BakedPool.Size; ++n) {
+					const ImFontBaked *baked = &atlas->Builder->BakedPool[n];
+					if (baked->OwnerFont == font && !baked->WantDestroy)
+						bakeds.push_back(baked);
+				}
+				std::sort(bakeds.begin(), bakeds.end(), [](const ImFontBaked *a, const ImFontBaked *b) {
+					return a->LastUsedFrame > b->LastUsedFrame;
+				});
+				std::snprintf(line, sizeof(line), "%s: %zu size(s)%s\n", font->GetDebugName(), bakeds.size(),
+				              (font->Flags & ImFontFlags_LockBakedSizes) ? ", locked" : "");
+				result += line;
+				for (const ImFontBaked *baked : bakeds) {
+					std::snprintf(line, sizeof(line), "  %8.2fpx x%.2f %6d glyph(s), drawn %d frame(s) ago\n", baked->Size,
+					              baked->RasterizerDensity, baked->Glyphs.Size, frame - baked->LastUsedFrame);
+					result += line;
+				}
+			}
+			return result;
+		}
+	};
+}
@@ -0,0 +1,464 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Font Cache
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace imgui_cs {
+	// Read-only memory mapping of a whole file, empty when the file does not exist.
+	class mapped_file final {
+		const unsigned char *m_data = nullptr;
+		std::size_t m_size = 0;
+#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+#endif
+
+	public:
+		mapped_file() = default;
+
+		mapped_file(const mapped_file &) = delete;
+
+		~mapped_file()
+		{
+			close();
+		}
+
+		bool open(const std::string &path)
+		{
+			close();
+#ifdef _WIN32
+			m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE)
+				return false;
+			LARGE_INTEGER size;
+			if (GetFileSizeEx(m_file, &size) && size.QuadPart > 0)
+				m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping != nullptr)
+				m_data = static_cast<const unsigned char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (m_data == nullptr) {
+				close();
+				return false;
+			}
+			m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+			int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return false;
+			struct stat st;
+			if (fstat(fd, &st) == 0 && st.st_size > 0) {
+				void *data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+				if (data != MAP_FAILED) {
+					m_data = static_cast<const unsigned char *>(data);
+					m_size = static_cast<std::size_t>(st.st_size);
+				}
+			}
+			::close(fd);
+			if (m_data == nullptr)
+				return false;
+#endif
+			return true;
+		}
+
+		void close()
+		{
+#ifdef _WIN32
+			if (m_data != nullptr)
+				UnmapViewOfFile(m_data);
+			if (m_mapping != nullptr)
+				CloseHandle(m_mapping);
+			if (m_file != INVALID_HANDLE_VALUE)
+				CloseHandle(m_file);
+			m_mapping = nullptr;
+			m_file = INVALID_HANDLE_VALUE;
+#else
+			if (m_data != nullptr)
+				munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		// Size of the file at path without opening it, false when it does not exist
+		static bool stat_size(const std::string &path, std::size_t &size)
+		{
+#ifdef _WIN32
+			WIN32_FILE_ATTRIBUTE_DATA attributes;
+			if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes))
+				return false;
+			size = static_cast<std::size_t>(static_cast<std::uint64_t>(attributes.nFileSizeHigh) << 32 | attributes.nFileSizeLow);
+#else
+			struct stat st;
+			if (::stat(path.c_str(), &st) != 0)
+				return false;
+			size = static_cast<std::size_t>(st.st_size);
+#endif
+			return true;
+		}
+
+		const unsigned char *data() const
+		{
+			return m_data;
+		}
+
+		std::size_t size() const
+		{
+			return m_size;
+		}
+	};
+
+	// Bytes hashed at each end of font data
+	constexpr std::size_t font_hashed_bytes = 64 * 1024;
+
+	// Hash of the size and of both ends of font data, which tells fonts apart without paging in the whole
+	// file. Equal hashes do not prove equal data: callers compare the bytes when that matters.
+	inline ImGuiID font_data_hash(const void *data, std::size_t size)
+	{
+		const ImGuiID head = ImHashData(data, size < font_hashed_bytes ? size : font_hashed_bytes, static_cast<ImGuiID>(size));
+		if (size <= font_hashed_bytes)
+			return head;
+		return ImHashData(static_cast<const unsigned char *>(data) + size - font_hashed_bytes, font_hashed_bytes, head);
+	}
+
+	// Persistent cache of rasterized glyphs, installed as the font loader of the atlas.
+	// The stb_truetype loader still parses the fonts and computes their metrics, but glyphs found in the cache
+	// are copied into the atlas instead of being rasterized. Glyphs it has to rasterize are recorded and
+	// written back when the loader shuts down (i.e. when the application closes) or on save().
+	// Glyphs are keyed by font_data_hash() of the font data and by a hash of everything the bitmap depends on:
+	// size, rasterizer density, oversampling, glyph offset, merge scale and the Dear ImGui version.
+	// A font file edited in its middle without changing size keeps its key: delete the cache file after such edits.
+	// The file is native endian and only meant to be read back on the machine that wrote it.
+	class font_cache final {
+		static constexpr std::uint32_t magic = 0x43465343; // "CSFC"
+		static constexpr std::uint32_t format_version = 2;
+
+		struct header {
+			std::uint32_t magic;
+			std::uint32_t format_version;
+			std::uint32_t imgui_version;
+			std::uint32_t record_count;
+			std::uint32_t pixel_bytes;
+			std::uint32_t reserved; // Keeps the records 8 byte aligned in the mapping
+		};
+
+		// Sorted by (face, codepoint) in the file
+		struct record {
+			std::uint64_t face;
+			std::uint32_t codepoint;
+			std::uint16_t width;
+			std::uint16_t height;
+			float advance_x;
+			float x0, y0, x1, y1;
+			std::uint32_t pixels;
+		};
+
+		using key_t = std::pair<std::uint64_t, std::uint32_t>;
+
+		ImFontLoader m_loader;
+		const ImFontLoader *m_inner = nullptr;
+		std::string m_path;
+		mapped_file m_file;
+		const record *m_records = nullptr;
+		std::size_t m_record_count = 0;
+		const unsigned char *m_pixels = nullptr;
+		// Glyphs rasterized in this session
+		std::map<key_t, record> m_new_records;
+		std::vector<unsigned char> m_new_pixels;
+		struct font_hash {
+			ImGuiID hash;
+			const void *data;
+			std::size_t size;
+		};
+		// Hash of the font data of each source, by the loader data the inner loader attached to it
+		std::unordered_map<const void *, font_hash> m_font_hashes;
+		std::size_t m_hits = 0;
+		std::size_t m_misses = 0;
+
+		font_cache()
+		{
+			m_inner = ImFontAtlasGetFontLoaderForStbTruetype();
+			m_loader = *m_inner;
+			m_loader.Name = "stb_truetype (cached)";
+			m_loader.LoaderShutdown = loader_shutdown;
+			m_loader.FontSrcInit = font_src_init;
+			m_loader.FontSrcDestroy = font_src_destroy;
+			m_loader.FontBakedLoadGlyph = font_baked_load_glyph;
+		}
+
+		std::uint64_t face_key(ImFontConfig *src, ImFontBaked *baked) const
+		{
+			struct {
+				float size, density, ascent, ref_size, src_size, extra_scale, offset_x, offset_y;
+				int oversample_h, oversample_v, font_no, merge, version;
+			} params;
+			std::memset(&params, 0, sizeof(params));
+			ImFontAtlasBuildGetOversampleFactors(src, baked, &params.oversample_h, &params.oversample_v);
+			params.size = baked->Size;
+			params.density = src->RasterizerDensity * baked->RasterizerDensity;
+			params.ascent = baked->Ascent;
+			params.ref_size = baked->OwnerFont->Sources[0]->SizePixels;
+			params.src_size = src->SizePixels;
+			params.extra_scale = src->ExtraSizeScale;
+			params.offset_x = src->GlyphOffset.x;
+			params.offset_y = src->GlyphOffset.y;
+			params.font_no = src->FontNo;
+			params.merge = src->MergeMode;
+			params.version = IMGUI_VERSION_NUM;
+			auto it = m_font_hashes.find(src->FontLoaderData);
+			const std::uint64_t font_hash = it != m_font_hashes.end() ? it->second.hash : 0;
+			return font_hash << 32 | ImHashData(&params, sizeof(params));
+		}
+
+		const record *find(const key_t &key) const
+		{
+			const record *end = m_records + m_record_count;
+			const record *it = std::lower_bound(m_records, end, key, [](const record &r, const key_t &k) {
+				return key_t(r.face, r.codepoint) < k;
+			});
+			if (it != end && it->face == key.first && it->codepoint == key.second)
+				return it;
+			auto found = m_new_records.find(key);
+			return found != m_new_records.end() ? &found->second : nullptr;
+		}
+
+		const unsigned char *pixels_of(const record *r) const
+		{
+			if (r >= m_records && r < m_records + m_record_count)
+				return m_pixels + r->pixels;
+			return m_new_pixels.data() + r->pixels;
+		}
+
+		static void loader_shutdown(ImFontAtlas *)
+		{
+			get().save();
+		}
+
+		static bool font_src_init(ImFontAtlas *atlas, ImFontConfig *src)
+		{
+			font_cache &cache = get();
+			if (!cache.m_inner->FontSrcInit(atlas, src))
+				return false;
+			const std::size_t size = static_cast<std::size_t>(src->FontDataSize);
+			font_hash entry = {font_data_hash(src->FontData, size), src->FontData, size};
+			// Another font of this session with the same hash has to hold the same bytes, a different one is
+			// told apart by a hash of all of its data
+			for (const auto &other : cache.m_font_hashes) {
+				const font_hash &h = other.second;
+				if (h.hash == entry.hash && h.data != entry.data && (h.size != size || std::memcmp(h.data, entry.data, size) != 0)) {
+					entry.hash = ImHashData(entry.data, size, entry.hash);
+					break;
+				}
+			}
+			cache.m_font_hashes[src->FontLoaderData] = entry;
+			return true;
+		}
+
+		static void font_src_destroy(ImFontAtlas *atlas, ImFontConfig *src)
+		{
+			get().m_font_hashes.erase(src->FontLoaderData);
+			get().m_inner->FontSrcDestroy(atlas, src);
+		}
+
+		static bool font_baked_load_glyph(ImFontAtlas *atlas, ImFontConfig *src, ImFontBaked *baked, void *loader_data, ImWchar codepoint, ImFontGlyph *out_glyph, float *out_advance_x)
+		{
+			font_cache &cache = get();
+			const key_t key(cache.face_key(src, baked), codepoint);
+			if (const record *r = cache.find(key)) {
+				++cache.m_hits;
+				if (out_advance_x != nullptr) {
+					*out_advance_x = r->advance_x;
+					return true;
+				}
+				out_glyph->Codepoint = codepoint;
+				out_glyph->AdvanceX = r->advance_x;
+				if (r->width == 0)
+					return true;
+				ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, r->width, r->height);
+				if (pack_id == ImFontAtlasRectId_Invalid)
+					return false;
+				out_glyph->X0 = r->x0;
+				out_glyph->Y0 = r->y0;
+				out_glyph->X1 = r->x1;
+				out_glyph->Y1 = r->y1;
+				out_glyph->Visible = true;
+				out_glyph->PackId = pack_id;
+				ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, ImFontAtlasPackGetRect(atlas, pack_id), cache.pixels_of(r), ImTextureFormat_Alpha8, r->width);
+				return true;
+			}
+			++cache.m_misses;
+			if (!cache.m_inner->FontBakedLoadGlyph(atlas, src, baked, loader_data, codepoint, out_glyph, out_advance_x))
+				return false;
+			// Advance only requests (huge sizes) are not worth keeping
+			if (out_advance_x != nullptr)
+				return true;
+			record r;
+			std::memset(&r, 0, sizeof(r));
+			r.face = key.first;
+			r.codepoint = key.second;
+			r.advance_x = out_glyph->AdvanceX;
+			if (out_glyph->Visible) {
+				// Read the bitmap back from the atlas, it holds coverage in either format
+				const ImTextureRect *rect = ImFontAtlasPackGetRect(atlas, out_glyph->PackId);
+				ImTextureData *tex = atlas->TexData;
+				r.width = rect->w;
+				r.height = rect->h;
+				r.x0 = out_glyph->X0;
+				r.y0 = out_glyph->Y0;
+				r.x1 = out_glyph->X1;
+				r.y1 = out_glyph->Y1;
+				r.pixels = static_cast<std::uint32_t>(cache.m_new_pixels.size());
+				for (int y = 0; y < rect->h; ++y) {
+					const unsigned char *row = static_cast<const unsigned char *>(tex->GetPixelsAt(rect->x, rect->y + y));
+					if (tex->Format == ImTextureFormat_Alpha8)
+						cache.m_new_pixels.insert(cache.m_new_pixels.end(), row, row + rect->w);
+					else
+						for (int x = 0; x < rect->w; ++x)
+							cache.m_new_pixels.push_back(row[x * 4 + 3]);
+				}
+			}
+			cache.m_new_records[key] = r;
+			return true;
+		}
+
+	public:
+		font_cache(const font_cache &) = delete;
+
+		font_cache(font_cache &&) noexcept = delete;
+
+		static font_cache &get()
+		{
+			static font_cache cache;
+			return cache;
+		}
+
+		// Map the cache file at path (which may not exist yet) and return the loader to install.
+		const ImFontLoader *open(const std::string &path)
+		{
+			if (!m_path.empty() && m_path != path)
+				save();
+			m_path = path;
+			m_file.close();
+			m_records = nullptr;
+			m_record_count = 0;
+			m_pixels = nullptr;
+			if (m_file.open(path) && m_file.size() >= sizeof(header)) {
+				header h;
+				std::memcpy(&h, m_file.data(), sizeof(h));
+				const std::size_t expected = sizeof(header) + std::size_t(h.record_count) * sizeof(record) + h.pixel_bytes;
+				// Anything else than an intact file of this version is ignored and rewritten on save
+				if (h.magic == magic && h.format_version == format_version && h.imgui_version == IMGUI_VERSION_NUM && m_file.size() == expected) {
+					m_records = reinterpret_cast<const record *>(m_file.data() + sizeof(header));
+					m_record_count = h.record_count;
+					m_pixels = m_file.data() + sizeof(header) + std::size_t(h.record_count) * sizeof(record);
+				}
+			}
+			if (m_records == nullptr)
+				m_file.close();
+			return &m_loader;
+		}
+
+		bool is_loaded() const
+		{
+			return m_record_count > 0;
+		}
+
+		std::size_t get_hits() const
+		{
+			return m_hits;
+		}
+
+		std::size_t get_misses() const
+		{
+			return m_misses;
+		}
+
+		// Merge the glyphs rasterized in this session into the file, nothing to do when every glyph was a hit.
+		void save()
+		{
+			if (m_path.empty() || m_new_records.empty())
+				return;
+			std::vector<record> records;
+			std::vector<unsigned char> pixels;
+			records.reserve(m_record_count + m_new_records.size());
+			auto append = [&](const record &r) {
+				record copy = r;
+				copy.pixels = static_cast<std::uint32_t>(pixels.size());
+				const unsigned char *src = pixels_of(&r);
+				pixels.insert(pixels.end(), src, src + std::size_t(r.width) * r.height);
+				records.push_back(copy);
+			};
+			// Both sequences are sorted, merge them
+			const record *it = m_records, *end = m_records + m_record_count;
+			for (const auto &entry : m_new_records) {
+				for (; it != end && key_t(it->face, it->codepoint) < entry.first; ++it)
+					append(*it);
+				append(entry.second);
+			}
+			for (; it != end; ++it)
+				append(*it);
+			// Release the mapping first, a mapped file cannot be replaced on Windows
+			m_file.close();
+			m_records = nullptr;
+			m_record_count = 0;
+			m_pixels = nullptr;
+			m_new_records.clear();
+			m_new_pixels.clear();
+			header h = {magic, format_version, IMGUI_VERSION_NUM, static_cast<std::uint32_t>(records.size()), static_cast<std::uint32_t>(pixels.size()), 0};
+			std::FILE *file = std::fopen(m_path.c_str(), "wb");
+			if (file == nullptr)
+				return;
+			bool ok = std::fwrite(&h, sizeof(h), 1, file) == 1;
+			if (ok && !records.empty())
+				ok = std::fwrite(records.data(), sizeof(record), records.size(), file) == records.size();
+			if (ok && !pixels.empty())
+				ok = std::fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+			std::fclose(file);
+			// Serve the glyphs from the new file from now on, a partially written one is rejected by open()
+			if (ok)
+				open(m_path);
+			else
+				std::remove(m_path.c_str());
+		}
+	};
+}
@@ -0,0 +1,243 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Font Data Sharing
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_font_cache.hpp>
+
+namespace imgui_cs {
+	// Font files mapped read-only and shared by every font added from them, instead of one heap copy per
+	// AddFontFromFileTTF() call. Mappings are found by path, then by size and content hash (verified byte by
+	// byte), so the same face added at several sizes, from another path or by another application costs one
+	// mapping. Only both ends of a file are hashed: the rest of a font is only paged in when glyphs need it.
+	// Each ImGui context holds a reference to the mappings its atlas reads, released when the context
+	// shuts down; a mapping is closed once nothing references it anymore.
+	// Embedded fonts which have to be decompressed are decompressed once per atlas: the pool takes the copy
+	// over from the first font, fonts added at other sizes read it and it is released with the mappings.
+	class font_data_pool final {
+		struct content {
+			std::size_t size;
+			ImGuiID hash;
+			std::weak_ptr<mapped_file> file;
+		};
+
+		struct decoded_font {
+			std::shared_ptr<void> data;
+			int size;
+		};
+
+		std::unordered_map<std::string, std::weak_ptr<mapped_file>> m_paths;
+		std::vector<content> m_contents;
+		struct context_data {
+			std::vector<std::shared_ptr<mapped_file>> files;
+			// Decompressed font data, by embedded data
+			std::unordered_map<const void *, decoded_font> decoded;
+		};
+
+		std::unordered_map<ImGuiContext *, context_data> m_contexts;
+
+		font_data_pool() = default;
+
+		static ImGuiID hook_owner()
+		{
+			return ImHashStr("imgui_cs::font_data_pool");
+		}
+
+		static void shutdown_hook(ImGuiContext *ctx, ImGuiContextHook *hook)
+		{
+			static_cast<font_data_pool *>(hook->UserData)->m_contexts.erase(ctx);
+		}
+
+		// Data of the current context, registers its release on shutdown on first use
+		context_data &current()
+		{
+			ImGuiContext *ctx = ImGui::GetCurrentContext();
+			for (const ImGuiContextHook &hook : ctx->Hooks)
+				if (hook.Owner == hook_owner() && hook.Type == ImGuiContextHookType_Shutdown)
+					return m_contexts[ctx];
+			// A context at the address of a destroyed one which never reached its shutdown hook
+			m_contexts.erase(ctx);
+			ImGuiContextHook hook;
+			hook.Type = ImGuiContextHookType_Shutdown;
+			hook.Owner = hook_owner();
+			hook.Callback = shutdown_hook;
+			hook.UserData = this;
+			ImGui::AddContextHook(ctx, &hook);
+			return m_contexts[ctx];
+		}
+
+		std::shared_ptr<mapped_file> find_content(const mapped_file &file, ImGuiID hash)
+		{
+			for (const content &c : m_contents) {
+				if (c.size != file.size() || c.hash != hash)
+					continue;
+				std::shared_ptr<mapped_file> shared = c.file.lock();
+				if (shared && shared->size() == file.size() && std::memcmp(shared->data(), file.data(), file.size()) == 0)
+					return shared;
+			}
+			return nullptr;
+		}
+
+		void prune()
+		{
+			for (auto it = m_paths.begin(); it != m_paths.end();) {
+				if (it->second.expired())
+					it = m_paths.erase(it);
+				else
+					++it;
+			}
+			for (std::size_t i = 0; i < m_contents.size();) {
+				if (m_contents[i].file.expired()) {
+					m_contents[i] = m_contents.back();
+					m_contents.pop_back();
+				}
+				else
+					++i;
+			}
+		}
+
+	public:
+		font_data_pool(const font_data_pool &) = delete;
+
+		font_data_pool(font_data_pool &&) noexcept = delete;
+
+		static font_data_pool &get()
+		{
+			static font_data_pool pool;
+			return pool;
+		}
+
+		// Shared mapping of the file at path, nullptr when it cannot be mapped.
+		std::shared_ptr<mapped_file> acquire(const std::string &path)
+		{
+			auto known = m_paths.find(path);
+			if (known != m_paths.end()) {
+				std::shared_ptr<mapped_file> shared = known->second.lock();
+				std::size_t size = 0;
+				// Same path and size: the file is still the one mapped, no need to map it again
+				if (shared && mapped_file::stat_size(path, size) && size == shared->size())
+					return shared;
+			}
+			std::shared_ptr<mapped_file> file = std::make_shared<mapped_file>();
+			if (!file->open(path))
+				return nullptr;
+			prune();
+			const ImGuiID hash = font_data_hash(file->data(), file->size());
+			std::shared_ptr<mapped_file> shared = find_content(*file, hash);
+			if (!shared) {
+				shared = file;
+				m_contents.push_back({file->size(), hash, shared});
+			}
+			m_paths[path] = shared;
+			return shared;
+		}
+
+		// Add the font file at path to the current atlas, reading it in place from a shared mapping.
+		// Falls back to AddFontFromFileTTF() when the file cannot be mapped.
+		ImFont *add_font(const std::string &path, float size, ImFontConfig font_cfg = ImFontConfig())
+		{
+			ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+			std::shared_ptr<mapped_file> file = acquire(path);
+			if (!file)
+				return atlas->AddFontFromFileTTF(path.c_str(), size, &font_cfg);
+			const char *name = path.c_str() + path.size();
+			while (name > path.c_str() && name[-1] != '/' && name[-1] != '\\')
+				--name;
+			ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "%s", name);
+			font_cfg.FontDataOwnedByAtlas = false;
+			ImFont *font = atlas->AddFontFromMemoryTTF(const_cast<unsigned char *>(file->data()), static_cast<int>(file->size()), size, &font_cfg);
+			if (font != nullptr)
+				current().files.push_back(std::move(file));
+			return font;
+		}
+
+		// Add an embedded font that decode(font_cfg) decompresses into the atlas, unless an earlier font of
+		// this atlas already holds the decompressed copy of embedded.
+		template<typename decode_t>
+		ImFont *add_embedded(const void *embedded, float size, ImFontConfig font_cfg, decode_t decode)
+		{
+			ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+			context_data &data = current();
+			auto it = data.decoded.find(embedded);
+			if (it != data.decoded.end()) {
+				font_cfg.FontDataOwnedByAtlas = false;
+				return atlas->AddFontFromMemoryTTF(it->second.data.get(), it->second.size, size, &font_cfg);
+			}
+			ImFont *font = decode(font_cfg);
+			if (font == nullptr)
+				return nullptr;
+			// The copy may outlive the context in retain() results, it is freed without going through it
+			ImFontConfig *src = font->Sources.back();
+			ImGuiMemAllocFunc alloc_func;
+			ImGuiMemFreeFunc free_func;
+			void *user_data;
+			ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+			src->FontDataOwnedByAtlas = false;
+			data.decoded[embedded] = {std::shared_ptr<void>(src->FontData, [free_func, user_data](void *ptr) {
+				free_func(ptr, user_data);
+			}), src->FontDataSize};
+			return font;
+		}
+
+		// Keeps the mapping or decompressed copy holding data alive for as long as the result,
+		// empty when data is not pooled
+		std::shared_ptr<const void> retain(const void *data)
+		{
+			for (const content &c : m_contents) {
+				std::shared_ptr<mapped_file> shared = c.file.lock();
+				if (shared && data >= shared->data() && data < shared->data() + shared->size())
+					return std::shared_ptr<const void>(shared, data);
+			}
+			for (const auto &ctx : m_contexts) {
+				for (const auto &decoded : ctx.second.decoded) {
+					const unsigned char *begin = static_cast<const unsigned char *>(decoded.second.data.get());
+					if (data >= begin && data < begin + decoded.second.size)
+						return std::shared_ptr<const void>(decoded.second.data, data);
+				}
+			}
+			return nullptr;
+		}
+
+		// Number of distinct font files mapped and their total size
+		std::size_t get_file_count()
+		{
+			prune();
+			return m_contents.size();
+		}
+
+		std::size_t get_mapped_bytes()
+		{
+			prune();
+			std::size_t bytes = 0;
+			for (const content &c : m_contents)
+				if (std::shared_ptr<mapped_file> shared = c.file.lock())
+					bytes += shared->size();
+			return bytes;
+		}
+	};
+}
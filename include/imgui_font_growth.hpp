@@ -0,0 +1,168 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Font Atlas Growth
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_font_budget.hpp>
+#include <imgui_font_stb.hpp>
+
+namespace imgui_cs {
+	// Grows the font atlas ahead of time without repacking it.
+	// When new glyphs do not fit, ImGui repacks every glyph into a larger texture in the middle of the frame
+	// which needed them: with tens of thousands of CJK glyphs that takes tens of milliseconds. With headroom
+	// set, the atlas is grown before the frame whenever less than that share of it is left free. Every glyph
+	// keeps its place in the larger texture: the pixels are copied as one block, texture coordinates are
+	// rescaled and the packer carries on where it stopped, with the new area empty. Growth stays within the
+	// font atlas budget and TexMaxWidth/TexMaxHeight, past them ImGui makes space the usual way.
+	// The new texture is still uploaded whole once. Reserving the expected size up front avoids even that:
+	// new glyphs then only reach the renderer as region updates.
+	class font_atlas_growth final {
+		float m_headroom = 0.0f;
+		int m_reserved_width = 0;
+		int m_reserved_height = 0;
+		int m_growths = 0;
+
+		font_atlas_growth() = default;
+
+		// Share of the texture above the skyline of the packer, where new rectangles go
+		static float free_share(ImFontAtlas *atlas)
+		{
+			const stbrp_context *ctx = reinterpret_cast<const stbrp_context *>(&atlas->Builder->PackContext);
+			double free = 0;
+			for (const stbrp_node *node = ctx->active_head; node->next != nullptr; node = node->next)
+				free += static_cast<double>(node->next->x - node->x) * (ctx->height - node->y);
+			return static_cast<float>(free / (static_cast<double>(ctx->width) * ctx->height));
+		}
+
+		// Move the atlas to a texture of w x h, keeping every packed rectangle in place
+		void grow(ImFontAtlas *atlas, int w, int h)
+		{
+			ImFontAtlasBuilder *builder = atlas->Builder;
+			stbrp_context *ctx = reinterpret_cast<stbrp_context *>(&builder->PackContext);
+			// The skyline of the packer, the nodes holding it are reallocated for a wider texture
+			std::vector<stbrp_node> skyline;
+			for (const stbrp_node *node = ctx->active_head; node->next != nullptr; node = node->next)
+				skyline.push_back(*node);
+			ImTextureData *old_tex = atlas->TexData;
+			const ImVec2 uv_scale(static_cast<float>(old_tex->Width) / w, static_cast<float>(old_tex->Height) / h);
+			ImTextureData *new_tex = ImFontAtlasTextureAdd(atlas, w, h);
+			new_tex->UseColors = old_tex->UseColors;
+			new_tex->UsedRect = old_tex->UsedRect;
+			ImFontAtlasTextureBlockCopy(old_tex, 0, 0, new_tex, 0, 0, old_tex->Width, old_tex->Height);
+			// Same skyline, with the new columns empty
+			if (w != old_tex->Width)
+				skyline.push_back(stbrp_node{old_tex->Width, 0, nullptr});
+			builder->PackNodes.resize(w / 2);
+			stbrp_init_target(ctx, w, h, builder->PackNodes.Data, builder->PackNodes.Size);
+			stbrp_node **link = &ctx->active_head;
+			for (const stbrp_node &point : skyline) {
+				stbrp_node *node = ctx->free_head;
+				ctx->free_head = node->next;
+				node->x = point.x;
+				node->y = point.y;
+				*link = node;
+				link = &node->next;
+			}
+			*link = &ctx->extra[1];
+			// Sizes double, so scaled coordinates are exactly the ones ImGui computes for the new texture
+			for (int n = 0; n < builder->BakedPool.Size; ++n) {
+				for (ImFontGlyph &glyph : builder->BakedPool[n].Glyphs) {
+					glyph.U0 *= uv_scale.x;
+					glyph.U1 *= uv_scale.x;
+					glyph.V0 *= uv_scale.y;
+					glyph.V1 *= uv_scale.y;
+				}
+			}
+			for (ImVec4 &uv : atlas->TexUvLines)
+				uv = ImVec4(uv.x * uv_scale.x, uv.y * uv_scale.y, uv.z * uv_scale.x, uv.w * uv_scale.y);
+			atlas->TexUvWhitePixel = ImVec2(atlas->TexUvWhitePixel.x * uv_scale.x, atlas->TexUvWhitePixel.y * uv_scale.y);
+			ImFontAtlasUpdateDrawListsSharedData(atlas);
+			++m_growths;
+		}
+
+	public:
+		font_atlas_growth(const font_atlas_growth &) = delete;
+
+		font_atlas_growth(font_atlas_growth &&) noexcept = delete;
+
+		static font_atlas_growth &get()
+		{
+			static font_atlas_growth growth;
+			return growth;
+		}
+
+		// Share of the atlas to keep free for new glyphs, 0 leaves growing to ImGui.
+		void set_headroom(float headroom)
+		{
+			if (!(headroom >= 0.0f && headroom < 1.0f))
+				throw cs::lang_error("Invalid font atlas headroom.");
+			m_headroom = headroom;
+		}
+
+		float get_headroom() const
+		{
+			return m_headroom;
+		}
+
+		// Smallest atlas texture, rounded up to powers of two. A smaller texture is repacked once before the next frame.
+		void reserve(int width, int height)
+		{
+			ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+			if (width <= 0 || height <= 0 || width > atlas->TexMaxWidth || height > atlas->TexMaxHeight)
+				throw cs::lang_error("Invalid font atlas size.");
+			m_reserved_width = ImUpperPowerOfTwo(width);
+			m_reserved_height = ImUpperPowerOfTwo(height);
+			atlas->TexMinWidth = ImMax(atlas->TexMinWidth, m_reserved_width);
+			atlas->TexMinHeight = ImMax(atlas->TexMinHeight, m_reserved_height);
+		}
+
+		// Number of times the atlas was grown in place
+		int get_growth_count() const
+		{
+			return m_growths;
+		}
+
+		// Called once per frame from application.prepare() before the new frame starts, while the atlas is unlocked.
+		void next_frame()
+		{
+			ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+			ImTextureData *tex = atlas->TexData;
+			if (atlas->Builder == nullptr || tex == nullptr || tex->Pixels == nullptr || atlas->Locked)
+				return;
+			if (tex->Width < m_reserved_width || tex->Height < m_reserved_height) {
+				ImFontAtlasTextureRepack(atlas, ImMax(tex->Width, m_reserved_width), ImMax(tex->Height, m_reserved_height));
+				return;
+			}
+			if (m_headroom <= 0.0f || free_share(atlas) >= m_headroom)
+				return;
+			// Height before width, like ImGui grows the atlas
+			const int w = tex->Height <= tex->Width ? tex->Width : tex->Width * 2;
+			const int h = tex->Height <= tex->Width ? tex->Height * 2 : tex->Height;
+			const std::size_t budget = font_atlas_budget::get().get_budget();
+			if (w > atlas->TexMaxWidth || h > atlas->TexMaxHeight || (budget != 0 && static_cast<std::size_t>(tex->GetSizeInBytes()) * 2 > budget))
+				return;
+			grow(atlas, w, h);
+		}
+	};
+}
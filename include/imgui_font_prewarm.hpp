@@ -0,0 +1,415 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Font Prewarming
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_font_data.hpp>
+#include <imgui_font_stb.hpp>
+
+namespace imgui_cs {
+	// Rasterizes glyph ranges of a font on a worker thread ahead of their first use.
+	// prewarm() snapshots everything the stb_truetype loader of the atlas would use for the glyphs of one
+	// baked size, the worker renders them into staging bitmaps with the same math, and the start of every
+	// frame moves at most get_slice() of them into the atlas. Glyphs the frame already needed are loaded
+	// lazily as usual and skipped here. Prewarmed glyphs bypass the font cache, they are cheap anyway.
+	class font_prewarmer final {
+		struct source {
+			// The worker must not depend on the atlas staying alive: data pooled by font_data_pool is
+			// retained, anything else is copied
+			std::vector<unsigned char> owned_data;
+			std::shared_ptr<const void> shared_data;
+			const unsigned char *data = nullptr;
+			int font_no = 0;
+			bool merge = false;
+			float src_size = 0.0f;
+			float extra_scale = 1.0f;
+			float density = 1.0f;
+			int oversample_h = 1;
+			int oversample_v = 1;
+			float offset_x = 0.0f;
+			float offset_y = 0.0f;
+			std::vector<ImWchar> exclude;
+		};
+
+		struct job {
+			ImFont *font = nullptr;
+			float size = 0.0f;
+			float density = 1.0f;
+			float ascent = 0.0f;
+			float ref_size = 0.0f;
+			std::vector<source> sources;
+			std::vector<ImWchar> codepoints;
+		};
+
+		struct glyph {
+			ImFont *font;
+			float size;
+			float density;
+			int source_index;
+			ImWchar codepoint;
+			float advance_x;
+			float x0, y0, x1, y1;
+			int width;
+			int height;
+			std::vector<unsigned char> pixels;
+		};
+
+		// Glyphs rendered between two checks for cancellation and between two handovers to the main thread
+		static constexpr std::size_t batch_size = 32;
+		static constexpr int default_slice = 64;
+
+		std::mutex m_mutex;
+		std::condition_variable m_wakeup;
+		std::thread m_worker;
+		std::deque<job> m_jobs;
+		std::deque<glyph> m_staged;
+		// Bumped to drop the jobs of a destroyed context, batches of an older generation are discarded
+		std::size_t m_generation = 0;
+		std::size_t m_pending = 0;
+		bool m_stop = false;
+		int m_slice = default_slice;
+		ImGuiID m_hook_id = 0;
+
+		font_prewarmer() = default;
+
+		~font_prewarmer()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_wakeup.notify_all();
+			if (m_worker.joinable())
+				m_worker.join();
+		}
+
+		static ImGuiID hook_owner()
+		{
+			return ImHashStr("imgui_cs::font_prewarmer");
+		}
+
+		// The hook lives in the context, a missing hook means the context the jobs belong to is gone
+		bool is_hooked(ImGuiContext *ctx) const
+		{
+			for (const ImGuiContextHook &hook : ctx->Hooks)
+				if (hook.HookId == m_hook_id && hook.Owner == hook_owner() && hook.Type == ImGuiContextHookType_NewFramePre)
+					return true;
+			return false;
+		}
+
+		static void new_frame_hook(ImGuiContext *, ImGuiContextHook *hook)
+		{
+			static_cast<font_prewarmer *>(hook->UserData)->commit();
+		}
+
+		static bool accepts(const source &src, ImWchar codepoint)
+		{
+			for (std::size_t i = 0; i + 1 < src.exclude.size(); i += 2)
+				if (codepoint >= src.exclude[i] && codepoint <= src.exclude[i + 1])
+					return false;
+			return true;
+		}
+
+		// Mirrors ImGui_ImplStbTrueType_FontBakedLoadGlyph(), except that packing is left to commit()
+		static bool render(const job &j, const std::vector<stbtt_fontinfo> &infos, const std::vector<float> &scales, ImWchar codepoint, glyph &out)
+		{
+			for (std::size_t n = 0; n < j.sources.size(); ++n) {
+				const source &src = j.sources[n];
+				// A zero scale marks a source the worker failed to parse
+				if (scales[n] == 0.0f || !accepts(src, codepoint))
+					continue;
+				const stbtt_fontinfo *info = &infos[n];
+				const int glyph_index = stbtt_FindGlyphIndex(info, (int) codepoint);
+				if (glyph_index == 0)
+					continue;
+				const float scale_for_layout = scales[n] * j.size;
+				const float rasterizer_density = src.density;
+				const float scale_for_raster_x = scales[n] * j.size * rasterizer_density * src.oversample_h;
+				const float scale_for_raster_y = scales[n] * j.size * rasterizer_density * src.oversample_v;
+				int x0, y0, x1, y1;
+				int advance, lsb;
+				stbtt_GetGlyphBitmapBoxSubpixel(info, glyph_index, scale_for_raster_x, scale_for_raster_y, 0, 0, &x0, &y0, &x1, &y1);
+				stbtt_GetGlyphHMetrics(info, glyph_index, &advance, &lsb);
+				out.font = j.font;
+				out.size = j.size;
+				out.density = j.density;
+				out.source_index = static_cast<int>(n);
+				out.codepoint = codepoint;
+				out.advance_x = advance * scale_for_layout;
+				out.width = out.height = 0;
+				out.pixels.clear();
+				if (x0 == x1 || y0 == y1)
+					return true;
+				const int w = x1 - x0 + src.oversample_h - 1;
+				const int h = y1 - y0 + src.oversample_v - 1;
+				stbtt_GetGlyphBitmapBox(info, glyph_index, scale_for_raster_x, scale_for_raster_y, &x0, &y0, &x1, &y1);
+				out.pixels.assign(static_cast<std::size_t>(w) * h, 0);
+				float sub_x, sub_y;
+				stbtt_MakeGlyphBitmapSubpixelPrefilter(info, out.pixels.data(), w, h, w,
+				                                       scale_for_raster_x, scale_for_raster_y, 0, 0, src.oversample_h, src.oversample_v, &sub_x, &sub_y, glyph_index);
+				const float offsets_scale = (j.ref_size != 0.0f) ? (j.size / j.ref_size) : 1.0f;
+				float font_off_x = ImFloor(src.offset_x * offsets_scale + 0.5f);
+				float font_off_y = ImFloor(src.offset_y * offsets_scale + 0.5f);
+				font_off_x += sub_x;
+				font_off_y += sub_y + IM_ROUND(j.ascent);
+				const float recip_h = 1.0f / (src.oversample_h * rasterizer_density);
+				const float recip_v = 1.0f / (src.oversample_v * rasterizer_density);
+				out.width = w;
+				out.height = h;
+				out.x0 = x0 * recip_h + font_off_x;
+				out.y0 = y0 * recip_v + font_off_y;
+				out.x1 = (x0 + w) * recip_h + font_off_x;
+				out.y1 = (y0 + h) * recip_v + font_off_y;
+				return true;
+			}
+			return false;
+		}
+
+		void worker_main()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			for (;;) {
+				m_wakeup.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+				if (m_stop)
+					return;
+				job j = std::move(m_jobs.front());
+				m_jobs.pop_front();
+				const std::size_t generation = m_generation;
+				lock.unlock();
+				std::vector<stbtt_fontinfo> infos(j.sources.size());
+				std::vector<float> scales(j.sources.size(), 0.0f);
+				for (std::size_t n = 0; n < j.sources.size(); ++n) {
+					const source &src = j.sources[n];
+					const int offset = stbtt_GetFontOffsetForIndex(src.data, src.font_no);
+					if (offset < 0 || !stbtt_InitFont(&infos[n], src.data, offset))
+						continue;
+					// Same sequence of operations as ImGui_ImplStbTrueType_FontSrcInit()
+					float scale = stbtt_ScaleForPixelHeight(&infos[n], 1.0f);
+					if (src.merge && src.src_size != 0.0f && j.ref_size != 0.0f)
+						scale *= src.src_size / j.ref_size;
+					scale *= src.extra_scale;
+					scales[n] = scale;
+				}
+				std::vector<glyph> batch;
+				std::size_t missing = 0;
+				for (std::size_t i = 0; i < j.codepoints.size(); ++i) {
+					glyph g;
+					if (render(j, infos, scales, j.codepoints[i], g))
+						batch.push_back(std::move(g));
+					else
+						++missing;
+					if (batch.size() + missing < batch_size && i + 1 < j.codepoints.size())
+						continue;
+					lock.lock();
+					if (m_stop)
+						return;
+					if (m_generation != generation) {
+						lock.unlock();
+						break;
+					}
+					for (glyph &staged : batch)
+						m_staged.push_back(std::move(staged));
+					m_pending -= missing;
+					lock.unlock();
+					batch.clear();
+					missing = 0;
+				}
+				lock.lock();
+			}
+		}
+
+		void commit()
+		{
+			std::vector<glyph> slice;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				const std::size_t count = std::min(m_staged.size(), static_cast<std::size_t>(m_slice));
+				for (std::size_t i = 0; i < count; ++i) {
+					slice.push_back(std::move(m_staged.front()));
+					m_staged.pop_front();
+				}
+				m_pending -= count;
+			}
+			for (glyph &g : slice) {
+				ImFontAtlas *atlas = g.font->OwnerAtlas;
+				ImFontBaked *baked = g.font->GetFontBaked(g.size, g.density);
+				if (baked == nullptr || baked->IsGlyphLoaded(g.codepoint) || g.source_index >= g.font->Sources.Size)
+					continue;
+				ImFontConfig *src = g.font->Sources[g.source_index];
+				ImFontGlyph glyph_buf;
+				glyph_buf.Codepoint = g.codepoint;
+				glyph_buf.AdvanceX = g.advance_x;
+				if (g.width > 0) {
+					ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, g.width, g.height);
+					if (pack_id == ImFontAtlasRectId_Invalid)
+						continue;
+					ImTextureRect *r = ImFontAtlasPackGetRect(atlas, pack_id);
+					glyph_buf.X0 = g.x0;
+					glyph_buf.Y0 = g.y0;
+					glyph_buf.X1 = g.x1;
+					glyph_buf.Y1 = g.y1;
+					glyph_buf.Visible = true;
+					glyph_buf.PackId = pack_id;
+					ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, &glyph_buf, r, g.pixels.data(), ImTextureFormat_Alpha8, g.width);
+				}
+				glyph_buf.SourceIdx = g.source_index;
+				ImFontAtlasBakedAddFontGlyph(atlas, baked, src, &glyph_buf);
+			}
+		}
+
+	public:
+		font_prewarmer(const font_prewarmer &) = delete;
+
+		font_prewarmer(font_prewarmer &&) noexcept = delete;
+
+		static font_prewarmer &get()
+		{
+			static font_prewarmer prewarmer;
+			return prewarmer;
+		}
+
+		// Queue the glyphs of ranges (zero terminated pairs) which are not loaded yet at this size.
+		// Returns the number of glyphs queued.
+		std::size_t prewarm(ImFont *font, float size, const ImWchar *ranges)
+		{
+			if (font == nullptr)
+				throw cs::lang_error("Invalid font.");
+			if (!(size > 0.0f))
+				throw cs::lang_error("Invalid font size.");
+			ImGuiContext *ctx = ImGui::GetCurrentContext();
+			if (ctx == nullptr || font->OwnerAtlas == nullptr)
+				throw cs::lang_error("No ImGui context.");
+			if (!(ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasTextures))
+				throw cs::lang_error("Font prewarming requires a renderer with dynamic font atlas support.");
+			ImFontAtlas *atlas = font->OwnerAtlas;
+			const char *loader_name = atlas->FontLoader ? atlas->FontLoader->Name : nullptr;
+			if (loader_name == nullptr || std::strncmp(loader_name, "stb_truetype", 12) != 0 || (font->Flags & ImFontFlags_NoLoadGlyphs))
+				return 0;
+			if (!is_hooked(ctx)) {
+				// First use in this context, whatever was queued for a previous one is stale
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					++m_generation;
+					m_jobs.clear();
+					m_staged.clear();
+					m_pending = 0;
+				}
+				ImGuiContextHook hook;
+				hook.Type = ImGuiContextHookType_NewFramePre;
+				hook.Owner = hook_owner();
+				hook.Callback = new_frame_hook;
+				hook.UserData = this;
+				m_hook_id = ImGui::AddContextHook(ctx, &hook);
+			}
+			ImFontBaked *baked = font->GetFontBaked(size);
+			if (baked == nullptr)
+				return 0;
+			job j;
+			j.font = font;
+			j.size = baked->Size;
+			j.density = baked->RasterizerDensity;
+			j.ascent = baked->Ascent;
+			j.ref_size = font->Sources[0]->SizePixels;
+			for (ImFontConfig *src : font->Sources) {
+				if ((src->FontLoader != nullptr && src->FontLoader != atlas->FontLoader) || src->FontData == nullptr)
+					return 0;
+				source s;
+				const unsigned char *data = static_cast<const unsigned char *>(src->FontData);
+				if (!src->FontDataOwnedByAtlas)
+					s.shared_data = font_data_pool::get().retain(data);
+				if (s.shared_data)
+					s.data = data;
+				else {
+					s.owned_data.assign(data, data + src->FontDataSize);
+					s.data = s.owned_data.data();
+				}
+				s.font_no = src->FontNo;
+				s.merge = src->MergeMode;
+				s.src_size = src->SizePixels;
+				s.extra_scale = src->ExtraSizeScale;
+				s.density = src->RasterizerDensity * baked->RasterizerDensity;
+				ImFontAtlasBuildGetOversampleFactors(src, baked, &s.oversample_h, &s.oversample_v);
+				s.offset_x = src->GlyphOffset.x;
+				s.offset_y = src->GlyphOffset.y;
+				if (src->GlyphExcludeRanges != nullptr)
+					for (const ImWchar *r = src->GlyphExcludeRanges; r[0] != 0; r += 2)
+						s.exclude.insert(s.exclude.end(), {r[0], r[1]});
+				j.sources.push_back(std::move(s));
+			}
+			for (const ImWchar *r = ranges; r[0] != 0; r += 2) {
+				for (unsigned int c = r[0]; c <= r[1] && c <= IM_UNICODE_CODEPOINT_MAX; ++c) {
+					const ImWchar codepoint = static_cast<ImWchar>(c);
+					if (font->EllipsisAutoBake && codepoint == font->EllipsisChar)
+						continue;
+					if (!baked->IsGlyphLoaded(codepoint))
+						j.codepoints.push_back(codepoint);
+				}
+			}
+			std::sort(j.codepoints.begin(), j.codepoints.end());
+			j.codepoints.erase(std::unique(j.codepoints.begin(), j.codepoints.end()), j.codepoints.end());
+			const std::size_t count = j.codepoints.size();
+			if (count == 0)
+				return 0;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_pending += count;
+				m_jobs.push_back(std::move(j));
+				if (!m_worker.joinable())
+					m_worker = std::thread(&font_prewarmer::worker_main, this);
+			}
+			m_wakeup.notify_one();
+			return count;
+		}
+
+		// Glyphs queued but not in the atlas yet
+		std::size_t get_pending()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_pending;
+		}
+
+		// Upper bound of glyphs moved into the atlas per frame
+		void set_slice(int count)
+		{
+			if (count <= 0)
+				throw cs::lang_error("Invalid prewarm slice.");
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_slice = count;
+		}
+
+		int get_slice()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_slice;
+		}
+	};
+}
@@ -0,0 +1,257 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension SDF Fonts
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_font_stb.hpp>
+
+namespace imgui_cs {
+	// Font loader baking every glyph once, as a signed distance field, instead of once per size drawn.
+	// Fonts added with it hold a single baked size, bake_size, and ImFontFlags_LockBakedSizes makes ImGui draw
+	// every other size from it, scaled. Drawn as coverage like other fonts they are blurry: text of these fonts
+	// must be drawn by a renderer thresholding the field, see ImGui_ImplOpenGL3_PushSdfText().
+	// Fields are computed from the outlines flattened into segments, like stbtt_GetGlyphSDF() which ignores the
+	// cubic curves of CFF fonts such as the default one. bake_size pixels with spread pixels of field around
+	// outlines keep edges sharp from about a third to three times bake_size.
+	class sdf_font_loader final {
+		struct source_data {
+			stbtt_fontinfo info;
+			float scale;
+		};
+
+		struct segment {
+			ImVec2 a, b;
+		};
+
+		ImFontLoader m_loader;
+
+		static float distance_sqr(const ImVec2 &a, const ImVec2 &b)
+		{
+			return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+		}
+
+		// Outline of a glyph in pixels, y down, curves flattened to within a tenth of a pixel or so
+		static void flatten(const stbtt_fontinfo *info, int glyph_index, float scale, std::vector<segment> &segments)
+		{
+			stbtt_vertex *vertices = nullptr;
+			const int count = stbtt_GetGlyphShape(info, glyph_index, &vertices);
+			ImVec2 start, last;
+			for (int n = 0; n < count; ++n) {
+				const stbtt_vertex &v = vertices[n];
+				const ImVec2 p(v.x * scale, -v.y * scale);
+				if (v.type == STBTT_vmove) {
+					if (last.x != start.x || last.y != start.y)
+						segments.push_back({last, start});
+					start = last = p;
+					continue;
+				}
+				const ImVec2 c0(v.cx * scale, -v.cy * scale), c1(v.cx1 * scale, -v.cy1 * scale);
+				int steps = 1;
+				if (v.type != STBTT_vline) {
+					const float hull = v.type == STBTT_vcubic ? ImSqrt(distance_sqr(last, c0)) + ImSqrt(distance_sqr(c0, c1)) + ImSqrt(distance_sqr(c1, p))
+					                                          : ImSqrt(distance_sqr(last, c0)) + ImSqrt(distance_sqr(c0, p));
+					steps = ImClamp(static_cast<int>(ImSqrt(hull) * 2.0f), 2, 32);
+				}
+				for (int i = 1; i <= steps; ++i) {
+					const float t = static_cast<float>(i) / steps;
+					const ImVec2 q = v.type == STBTT_vline ? p : v.type == STBTT_vcurve ? ImBezierQuadraticCalc(last, c0, p, t) : ImBezierCubicCalc(last, c0, c1, p, t);
+					segments.push_back({i == 1 ? last : segments.back().b, q});
+				}
+				last = p;
+			}
+			if (last.x != start.x || last.y != start.y)
+				segments.push_back({last, start});
+			stbtt_FreeShape(info, vertices);
+		}
+
+		// Field of a glyph into pixels, w x h with its top left corner at (x0, y0) from the origin of the glyph.
+		// Returns false for blank glyphs.
+		static bool render(const stbtt_fontinfo *info, int glyph_index, float scale, ImVector<unsigned char> &pixels, int &w, int &h, int &x0, int &y0)
+		{
+			int ix0 = 0, iy0 = 0, ix1 = 0, iy1 = 0;
+			stbtt_GetGlyphBitmapBox(info, glyph_index, scale, scale, &ix0, &iy0, &ix1, &iy1);
+			if (ix0 == ix1 || iy0 == iy1)
+				return false;
+			std::vector<segment> segments;
+			flatten(info, glyph_index, scale, segments);
+			x0 = ix0 - spread;
+			y0 = iy0 - spread;
+			w = ix1 - ix0 + 2 * spread;
+			h = iy1 - iy0 + 2 * spread;
+			pixels.resize(w * h);
+			const float value_scale = static_cast<float>(on_edge) / spread;
+			for (int y = 0; y < h; ++y) {
+				for (int x = 0; x < w; ++x) {
+					const ImVec2 p(x0 + x + 0.5f, y0 + y + 0.5f);
+					float dist_sq = static_cast<float>(spread * spread);
+					int winding = 0;
+					for (const segment &s : segments) {
+						dist_sq = ImMin(dist_sq, distance_sqr(ImLineClosestPoint(s.a, s.b, p), p));
+						// Non-zero winding of a ray towards +x
+						if ((s.a.y <= p.y) != (s.b.y <= p.y)) {
+							const float cross_x = s.a.x + (p.y - s.a.y) * (s.b.x - s.a.x) / (s.b.y - s.a.y);
+							if (cross_x > p.x)
+								winding += s.b.y > s.a.y ? 1 : -1;
+						}
+					}
+					const float dist = winding != 0 ? ImSqrt(dist_sq) : -ImSqrt(dist_sq);
+					pixels[y * w + x] = static_cast<unsigned char>(ImClamp(on_edge + dist * value_scale, 0.0f, 255.0f));
+				}
+			}
+			return true;
+		}
+
+		static bool src_init(ImFontAtlas *, ImFontConfig *src)
+		{
+			const int offset = stbtt_GetFontOffsetForIndex(static_cast<const unsigned char *>(src->FontData), src->FontNo);
+			source_data *data = IM_NEW(source_data);
+			if (offset < 0 || !stbtt_InitFont(&data->info, static_cast<const unsigned char *>(src->FontData), offset)) {
+				IM_DELETE(data);
+				return false;
+			}
+			// Same scale as the stb_truetype loader, so layouts match fonts baked per size
+			const float ref_size = src->DstFont->Sources[0]->SizePixels;
+			if (src->MergeMode && src->SizePixels == 0.0f)
+				src->SizePixels = ref_size;
+			data->scale = stbtt_ScaleForPixelHeight(&data->info, 1.0f) * src->ExtraSizeScale;
+			if (src->MergeMode && src->SizePixels != 0.0f && ref_size != 0.0f)
+				data->scale *= src->SizePixels / ref_size;
+			src->FontLoaderData = data;
+			return true;
+		}
+
+		static void src_destroy(ImFontAtlas *, ImFontConfig *src)
+		{
+			IM_DELETE(static_cast<source_data *>(src->FontLoaderData));
+			src->FontLoaderData = nullptr;
+		}
+
+		static bool src_contains_glyph(ImFontAtlas *, ImFontConfig *src, ImWchar codepoint)
+		{
+			return stbtt_FindGlyphIndex(&static_cast<source_data *>(src->FontLoaderData)->info, codepoint) != 0;
+		}
+
+		static bool baked_init(ImFontAtlas *, ImFontConfig *src, ImFontBaked *baked, void *)
+		{
+			if (src->MergeMode)
+				return true;
+			const source_data *data = static_cast<const source_data *>(src->FontLoaderData);
+			const float scale = data->scale * baked->Size / src->ExtraSizeScale;
+			int ascent = 0, descent = 0, line_gap = 0;
+			stbtt_GetFontVMetrics(&data->info, &ascent, &descent, &line_gap);
+			baked->Ascent = ImCeil(ascent * scale);
+			baked->Descent = ImFloor(descent * scale);
+			return true;
+		}
+
+		static bool baked_load_glyph(ImFontAtlas *atlas, ImFontConfig *src, ImFontBaked *baked, void *, ImWchar codepoint, ImFontGlyph *out_glyph, float *out_advance_x)
+		{
+			source_data *data = static_cast<source_data *>(src->FontLoaderData);
+			const int glyph_index = stbtt_FindGlyphIndex(&data->info, codepoint);
+			if (glyph_index == 0)
+				return false;
+			const float scale = data->scale * baked->Size;
+			int advance = 0, lsb = 0;
+			stbtt_GetGlyphHMetrics(&data->info, glyph_index, &advance, &lsb);
+			if (out_advance_x != nullptr) {
+				*out_advance_x = advance * scale;
+				return true;
+			}
+			out_glyph->Codepoint = codepoint;
+			out_glyph->AdvanceX = advance * scale;
+			// Oversampling and rasterizer density are pointless for a field drawn at any scale
+			ImVector<unsigned char> &field = atlas->Builder->TempBuffer;
+			int w = 0, h = 0, x0 = 0, y0 = 0;
+			if (!render(&data->info, glyph_index, scale, field, w, h, x0, y0))
+				return true;
+			const ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
+			if (pack_id == ImFontAtlasRectId_Invalid) {
+				IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+				return false;
+			}
+			ImTextureRect *r = ImFontAtlasPackGetRect(atlas, pack_id);
+			const float ref_size = baked->OwnerFont->Sources[0]->SizePixels;
+			const float offsets_scale = ref_size != 0.0f ? baked->Size / ref_size : 1.0f;
+			const float offset_x = ImFloor(src->GlyphOffset.x * offsets_scale + 0.5f);
+			const float offset_y = ImFloor(src->GlyphOffset.y * offsets_scale + 0.5f) + IM_ROUND(baked->Ascent);
+			out_glyph->X0 = x0 + offset_x;
+			out_glyph->Y0 = y0 + offset_y;
+			out_glyph->X1 = x0 + w + offset_x;
+			out_glyph->Y1 = y0 + h + offset_y;
+			out_glyph->Visible = true;
+			out_glyph->PackId = pack_id;
+			ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, field.Data, ImTextureFormat_Alpha8, w);
+			return true;
+		}
+
+		sdf_font_loader()
+		{
+			m_loader.Name = "imgui_cs_sdf";
+			m_loader.FontSrcInit = src_init;
+			m_loader.FontSrcDestroy = src_destroy;
+			m_loader.FontSrcContainsGlyph = src_contains_glyph;
+			m_loader.FontBakedInit = baked_init;
+			m_loader.FontBakedLoadGlyph = baked_load_glyph;
+		}
+
+	public:
+		// Size glyphs are baked at, in pixels
+		static constexpr float bake_size = 32.0f;
+		// Pixels of field on each side of outlines at bake_size, and value of the field on outlines
+		static constexpr int spread = 4;
+		static constexpr unsigned char on_edge = 128;
+
+		sdf_font_loader(const sdf_font_loader &) = delete;
+
+		sdf_font_loader(sdf_font_loader &&) noexcept = delete;
+
+		static sdf_font_loader &get()
+		{
+			static sdf_font_loader loader;
+			return loader;
+		}
+
+		// Font configuration of an SDF font, to pass to any ImFontAtlas::AddFont*() function
+		ImFontConfig config() const
+		{
+			ImFontConfig font_cfg = ImFontConfig();
+			font_cfg.FontLoader = &m_loader;
+			font_cfg.Flags |= ImFontFlags_LockBakedSizes;
+			return font_cfg;
+		}
+
+		// Bake the only size of a font added with config(), before anything asks for another one
+		static ImFont *bake(ImFont *font)
+		{
+			if (font != nullptr)
+				font->GetFontBaked(bake_size);
+			return font;
+		}
+
+		bool is_sdf(const ImFont *font) const
+		{
+			return font != nullptr && font->Sources.Size > 0 && font->Sources[0]->FontLoader == &m_loader;
+		}
+	};
+}
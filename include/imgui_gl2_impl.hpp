@@ -50,8 +50,15 @@ namespace imgui_cs {
 	};
 
 	class application final {
+		static void *get_proc_address(const char *name)
+		{
+			return reinterpret_cast<void *>(glfwGetProcAddress(name));
+		}
+
 		GLFWwindow *window = nullptr;
 		ImVec4 bg_color = {1.0f, 1.0f, 1.0f, 1.0f};
+		std::unique_ptr<render_thread> m_render_thread;
+		threaded_frames m_frames;
 
 		void init()
 		{
@@ -62,10 +69,11 @@ namespace imgui_cs {
 			ImGui::CreateContext();
 			ImGui_ImplGlfw_InitForOpenGL(window, true);
 			ImGui_ImplOpenGL2_Init();
-			ImFontConfig font_cfg = ImFontConfig();
-			ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "DefaultFont, 14px");
-			ImGui::GetIO().FontDefault = ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(
-			                                 get_default_font_data(), 14, &font_cfg);
+			// Fonts only need coverage, keep the atlas single channel (GL_ALPHA)
+			ImGui::GetIO().Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+			// Falls back to client-side arrays on contexts without buffer objects
+			ImGui_ImplOpenGL2_EnableVertexBuffers(get_proc_address);
+			ImGui::GetIO().FontDefault = load_font(get_default_font(), 14);
 		}
 
 	public:
@@ -94,7 +102,20 @@ namespace imgui_cs {
 
 		~application()
 		{
-			ImGui_ImplOpenGL2_Shutdown();
+			if (m_render_thread) {
+				try {
+					m_render_thread->run([] {
+						ImGui_ImplOpenGL2_Shutdown();
+						glfwMakeContextCurrent(nullptr);
+					});
+				}
+				catch (...) {
+				}
+				g_GLRenderThread = nullptr;
+				m_render_thread.reset();
+			}
+			else
+				ImGui_ImplOpenGL2_Shutdown();
 			ImGui_ImplGlfw_Shutdown();
 			ImGui::DestroyContext();
 			glfwDestroyWindow(window);
@@ -138,16 +159,77 @@ namespace imgui_cs {
 		void prepare()
 		{
 			glfwPollEvents();
-			ImGui_ImplOpenGL2_NewFrame();
+			// The render thread calls the renderer's NewFrame itself, it may need the GL context
+			if (!m_render_thread)
+				ImGui_ImplOpenGL2_NewFrame();
 			ImGui_ImplGlfw_NewFrame();
 			ImGui::NewFrame();
 		}
 
+		// Hand the GL context over to a dedicated render thread (or take it back).
+		// In threaded mode render() returns as soon as the frame is captured, the script builds
+		// frame N+1 while frame N is submitted and presented.
+		void set_threaded_render(bool enabled)
+		{
+			if (enabled == static_cast<bool>(m_render_thread))
+				return;
+			GLFWwindow *win = window;
+			if (enabled) {
+				glfwMakeContextCurrent(nullptr);
+				m_render_thread.reset(new render_thread);
+				m_render_thread->run([win] {
+					glfwMakeContextCurrent(win);
+				});
+				g_GLRenderThread = m_render_thread.get();
+			}
+			else {
+				m_render_thread->run([] {
+					glfwMakeContextCurrent(nullptr);
+				});
+				g_GLRenderThread = nullptr;
+				m_render_thread.reset();
+				glfwMakeContextCurrent(window);
+			}
+		}
+
+		bool is_threaded_render() const
+		{
+			return static_cast<bool>(m_render_thread);
+		}
+
+		// Stream vertices through buffer objects instead of client-side arrays.
+		// Returns whether buffer objects are actually used, the context may not support them.
+		bool set_vertex_buffers(bool enabled)
+		{
+			bool result = false;
+			gl_invoke([enabled, &result] {
+				if (enabled)
+					result = ImGui_ImplOpenGL2_GetVertexBuffers() || ImGui_ImplOpenGL2_EnableVertexBuffers(get_proc_address);
+				else
+					ImGui_ImplOpenGL2_DisableVertexBuffers();
+			});
+			return result;
+		}
+
+		bool is_vertex_buffers() const
+		{
+			return ImGui_ImplOpenGL2_GetVertexBuffers();
+		}
+
+		std::string get_render_driver() const
+		{
+			return ImGui::GetIO().BackendRendererName;
+		}
+
 		void render()
 		{
 			ImGui::Render();
 			int display_w, display_h;
 			glfwGetFramebufferSize(window, &display_w, &display_h);
+			if (m_render_thread) {
+				render_threaded(display_w, display_h);
+				return;
+			}
 			glViewport(0, 0, display_w, display_h);
 			glClearColor(bg_color.x, bg_color.y, bg_color.z, bg_color.w);
 			glClear(GL_COLOR_BUFFER_BIT);
@@ -155,8 +237,26 @@ namespace imgui_cs {
 			glfwMakeContextCurrent(window);
 			glfwSwapBuffers(window);
 		}
+
+	private:
+		void render_threaded(int display_w, int display_h)
+		{
+			GLFWwindow *win = window;
+			ImVec4 color = bg_color;
+			m_frames.submit(*m_render_thread, ImGui::GetDrawData(), ImGui_ImplOpenGL2_UpdateTexture, [win, color, display_w, display_h](ImDrawData *draw_data) {
+				ImGui_ImplOpenGL2_NewFrame();
+				glViewport(0, 0, display_w, display_h);
+				glClearColor(color.x, color.y, color.z, color.w);
+				glClear(GL_COLOR_BUFFER_BIT);
+				ImGui_ImplOpenGL2_RenderDrawData(draw_data);
+				glfwSwapBuffers(win);
+			});
+		}
 	};
 }
 
 // GLFW Instance
-static imgui_cs::glfw_instance glfw_instance;
\ No newline at end of file
+static imgui_cs::glfw_instance glfw_instance;
+
+// Render thread owning the GL context in threaded mode
+imgui_cs::render_thread *imgui_cs::g_GLRenderThread = nullptr;
\ No newline at end of file
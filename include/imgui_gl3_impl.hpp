@@ -23,6 +23,8 @@
 #include <imgui_glfw.hpp>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
+#include <imgui_resolution_scale.hpp>
+#include <chrono>
 
 namespace imgui_cs {
 	class glfw_instance final {
@@ -63,6 +65,14 @@ namespace imgui_cs {
 	class application final {
 		GLFWwindow *window = nullptr;
 		ImVec4 bg_color = {1.0f, 1.0f, 1.0f, 1.0f};
+		std::unique_ptr<render_thread> m_render_thread;
+		threaded_frames m_frames;
+		// Dynamic resolution, only touched on the thread owning the GL context
+		resolution_scaler m_scaler;
+		GLuint m_scaled_fbo = 0;
+		GLuint m_scaled_texture = 0;
+		int m_scaled_width = 0;
+		int m_scaled_height = 0;
 
 		void init()
 		{
@@ -81,10 +91,11 @@ namespace imgui_cs {
 			ImGui::CreateContext();
 			ImGui_ImplGlfw_InitForOpenGL(window, true);
 			ImGui_ImplOpenGL3_Init(glsl_version);
-			ImFontConfig font_cfg = ImFontConfig();
-			ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "DefaultFont, 14px");
-			ImGui::GetIO().FontDefault = ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(
-			                                 get_default_font_data(), 14, &font_cfg);
+			// We created the context and are its only user, no need to save and restore GL state every frame
+			ImGui_ImplOpenGL3_SetExclusiveContext(true);
+			// Fonts only need coverage, keep the atlas single channel (GL_R8 with GL 3.3+, expanded to RGBA otherwise)
+			ImGui::GetIO().Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+			ImGui::GetIO().FontDefault = load_font(get_default_font(), 14);
 		}
 
 	public:
@@ -113,7 +124,23 @@ namespace imgui_cs {
 
 		~application()
 		{
-			ImGui_ImplOpenGL3_Shutdown();
+			if (m_render_thread) {
+				try {
+					m_render_thread->run([this] {
+						release_scaled_target();
+						ImGui_ImplOpenGL3_Shutdown();
+						glfwMakeContextCurrent(nullptr);
+					});
+				}
+				catch (...) {
+				}
+				g_GLRenderThread = nullptr;
+				m_render_thread.reset();
+			}
+			else {
+				release_scaled_target();
+				ImGui_ImplOpenGL3_Shutdown();
+			}
 			ImGui_ImplGlfw_Shutdown();
 			ImGui::DestroyContext();
 			glfwDestroyWindow(window);
@@ -157,26 +184,206 @@ namespace imgui_cs {
 		void prepare()
 		{
 			glfwPollEvents();
-			ImGui_ImplOpenGL3_NewFrame();
+			// The render thread calls the renderer's NewFrame itself, it may need the GL context
+			if (!m_render_thread)
+				ImGui_ImplOpenGL3_NewFrame();
 			ImGui_ImplGlfw_NewFrame();
 			ImGui::NewFrame();
 		}
 
+		// Hand the GL context over to a dedicated render thread (or take it back).
+		// In threaded mode render() returns as soon as the frame is captured, the script builds
+		// frame N+1 while frame N is submitted and presented.
+		void set_threaded_render(bool enabled)
+		{
+			if (enabled == static_cast<bool>(m_render_thread))
+				return;
+			GLFWwindow *win = window;
+			if (enabled) {
+				glfwMakeContextCurrent(nullptr);
+				m_render_thread.reset(new render_thread);
+				m_render_thread->run([win] {
+					glfwMakeContextCurrent(win);
+				});
+				g_GLRenderThread = m_render_thread.get();
+			}
+			else {
+				m_render_thread->run([] {
+					glfwMakeContextCurrent(nullptr);
+				});
+				g_GLRenderThread = nullptr;
+				m_render_thread.reset();
+				glfwMakeContextCurrent(window);
+			}
+		}
+
+		bool is_threaded_render() const
+		{
+			return static_cast<bool>(m_render_thread);
+		}
+
+		// Select how vertices and indices reach the GPU, see ImGui_ImplOpenGL3_UploadMode.
+		// Returns the mode actually used, unsupported modes fall back to the next best one.
+		int set_upload_mode(int mode)
+		{
+			if (mode < ImGui_ImplOpenGL3_UploadMode_BufferData || mode > ImGui_ImplOpenGL3_UploadMode_PersistentRing)
+				throw cs::lang_error("Invalid upload mode.");
+			ImGui_ImplOpenGL3_UploadMode result;
+			gl_invoke([mode, &result] {
+				result = ImGui_ImplOpenGL3_SetUploadMode(static_cast<ImGui_ImplOpenGL3_UploadMode>(mode));
+			});
+			return result;
+		}
+
+		int get_upload_mode() const
+		{
+			return ImGui_ImplOpenGL3_GetUploadMode();
+		}
+
+		// Upload all draw lists of a frame with a single copy into one buffer, works with every upload mode.
+		bool set_merged_upload(bool enabled)
+		{
+			gl_invoke([enabled] {
+				ImGui_ImplOpenGL3_SetMergeDrawLists(enabled);
+			});
+			return enabled;
+		}
+
+		bool is_merged_upload() const
+		{
+			return ImGui_ImplOpenGL3_GetMergeDrawLists();
+		}
+
+		std::string get_render_driver() const
+		{
+			return ImGui::GetIO().BackendRendererName;
+		}
+
+		// Render at a fixed fraction of the framebuffer and upscale to the window, 1 renders directly.
+		// Returns the scale actually used, it is rounded to steps of 1/8 within [0.5, 1].
+		float set_render_scale(float scale)
+		{
+			float result = 1.0f;
+			gl_invoke([this, scale, &result] {
+				result = m_scaler.set_scale(scale);
+			});
+			return result;
+		}
+
+		float get_render_scale()
+		{
+			float result = 1.0f;
+			gl_invoke([this, &result] {
+				result = m_scaler.get_scale();
+			});
+			return result;
+		}
+
+		// Choose the render scale automatically from the GPU time of the frame, 0 goes back to full resolution.
+		void set_render_budget(float budget_ms)
+		{
+			gl_invoke([this, budget_ms] {
+				m_scaler.set_budget(budget_ms);
+			});
+		}
+
 		void render()
 		{
 			ImGui::Render();
 			int display_w, display_h;
-			glfwMakeContextCurrent(window);
 			glfwGetFramebufferSize(window, &display_w, &display_h);
-			glViewport(0, 0, display_w, display_h);
-			glClearColor(bg_color.x, bg_color.y, bg_color.z, bg_color.w);
-			glClear(GL_COLOR_BUFFER_BIT);
-			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			if (m_render_thread) {
+				render_threaded(display_w, display_h);
+				return;
+			}
+			glfwMakeContextCurrent(window);
+			draw_frame(ImGui::GetDrawData(), display_w, display_h, bg_color);
 			glfwMakeContextCurrent(window);
 			glfwSwapBuffers(window);
 		}
+
+	private:
+		// Called on the thread owning the GL context
+		void draw_frame(ImDrawData *draw_data, int display_w, int display_h, const ImVec4 &color)
+		{
+			// Timer queries are meaningless on software rasterizers (llvmpipe reports 0), which are the case this is for.
+			// Wait for the frame instead, the wall time then is the render time.
+			const bool timed = m_scaler.is_dynamic();
+			const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+			if (m_scaler.get_scale() >= 1.0f || display_w <= 0 || display_h <= 0) {
+				glViewport(0, 0, display_w, display_h);
+				glClearColor(color.x, color.y, color.z, color.w);
+				glClear(GL_COLOR_BUFFER_BIT);
+				ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+			}
+			else {
+				const int width = m_scaler.scaled(display_w);
+				const int height = m_scaler.scaled(display_h);
+				ensure_scaled_target(width, height);
+				glBindFramebuffer(GL_FRAMEBUFFER, m_scaled_fbo);
+				glViewport(0, 0, width, height);
+				glClearColor(color.x, color.y, color.z, color.w);
+				glClear(GL_COLOR_BUFFER_BIT);
+				// Only the framebuffer is smaller, positions and clip rects stay in window units
+				const ImVec2 fb_scale = draw_data->FramebufferScale;
+				draw_data->FramebufferScale = ImVec2(fb_scale.x * width / display_w, fb_scale.y * height / display_h);
+				ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+				draw_data->FramebufferScale = fb_scale;
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, m_scaled_fbo);
+				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+				glDisable(GL_SCISSOR_TEST);
+				glBlitFramebuffer(0, 0, width, height, 0, 0, display_w, display_h, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+				glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			}
+			if (timed) {
+				glFinish();
+				m_scaler.update(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count());
+			}
+		}
+
+		void ensure_scaled_target(int width, int height)
+		{
+			if (m_scaled_fbo != 0 && m_scaled_width == width && m_scaled_height == height)
+				return;
+			if (m_scaled_fbo == 0) {
+				glGenFramebuffers(1, &m_scaled_fbo);
+				glGenTextures(1, &m_scaled_texture);
+			}
+			glBindTexture(GL_TEXTURE_2D, m_scaled_texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			glBindFramebuffer(GL_FRAMEBUFFER, m_scaled_fbo);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_scaled_texture, 0);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			m_scaled_width = width;
+			m_scaled_height = height;
+		}
+
+		void release_scaled_target()
+		{
+			if (m_scaled_fbo != 0) {
+				glDeleteFramebuffers(1, &m_scaled_fbo);
+				glDeleteTextures(1, &m_scaled_texture);
+				m_scaled_fbo = m_scaled_texture = 0;
+			}
+		}
+
+		void render_threaded(int display_w, int display_h)
+		{
+			GLFWwindow *win = window;
+			ImVec4 color = bg_color;
+			m_frames.submit(*m_render_thread, ImGui::GetDrawData(), ImGui_ImplOpenGL3_UpdateTexture, [this, win, color, display_w, display_h](ImDrawData *draw_data) {
+				ImGui_ImplOpenGL3_NewFrame();
+				draw_frame(draw_data, display_w, display_h, color);
+				glfwSwapBuffers(win);
+			});
+		}
 	};
 }
 
 // GLFW Instance
-static imgui_cs::glfw_instance glfw_instance;
\ No newline at end of file
+static imgui_cs::glfw_instance glfw_instance;
+
+// Render thread owning the GL context in threaded mode
+imgui_cs::render_thread *imgui_cs::g_GLRenderThread = nullptr;
\ No newline at end of file
@@ -22,6 +22,7 @@
 */
 
 #include <imgui.hpp>
+#include <imgui_render_thread.hpp>
 
 // STB Image
 #define STB_IMAGE_IMPLEMENTATION
@@ -32,6 +33,19 @@
 #include <GLFW/glfw3.h>
 
 namespace imgui_cs {
+	// Render thread owning the GL context when application.set_threaded_render(true) is active, nullptr otherwise.
+	extern render_thread *g_GLRenderThread;
+
+	// Run GL work on the thread that currently owns the GL context.
+	template<typename T>
+	void gl_invoke(T &&job)
+	{
+		if (g_GLRenderThread != nullptr)
+			g_GLRenderThread->run(std::forward<T>(job));
+		else
+			job();
+	}
+
 	class image final {
 		int m_width;
 		int m_height;
@@ -46,11 +60,13 @@ namespace imgui_cs {
 			m_data = stbi_load(path.c_str(), &m_width, &m_height, nullptr, 4);
 			if (m_data == nullptr)
 				throw cs::lang_error("Open image error!");
-			glGenTextures(1, &m_textureID);
-			glBindTexture(GL_TEXTURE_2D, m_textureID);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_data);
+			gl_invoke([this] {
+				glGenTextures(1, &m_textureID);
+				glBindTexture(GL_TEXTURE_2D, m_textureID);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_data);
+			});
 			stbi_image_free(m_data);
 		}
 		~image() {}
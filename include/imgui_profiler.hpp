@@ -0,0 +1,296 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Binding Profiler
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace imgui_cs {
+	// Counts calls and accumulates wall time of every function registered through CNI(...) or CNI_PROFILED_V(...).
+	// Disabled by default; when disabled each binding call only pays for a thread check and one branch.
+	// Only calls made on the thread which created the profiler, the script thread, are recorded. Bindings called
+	// from other threads are not counted.
+	// Bindings are listed by their name qualified with their CovScript namespace, e.g. application.prepare.
+	class binding_profiler final {
+		using clock_t = std::chrono::steady_clock;
+
+		struct entry {
+			std::string name;
+			std::uint64_t calls = 0;
+			std::uint64_t nanos = 0;
+		};
+
+		struct sample {
+			std::size_t id;
+			std::uint64_t calls;
+			std::uint64_t nanos;
+		};
+
+		struct frame {
+			std::uint64_t nanos = 0;
+			std::vector<sample> samples;
+		};
+
+		static constexpr std::size_t max_frames = 1024;
+
+		std::vector<entry> m_entries;
+		std::vector<std::size_t> m_touched;
+		std::vector<frame> m_history;
+		std::size_t m_history_pos = 0;
+		std::size_t m_history_size = 0;
+		clock_t::time_point m_frame_begin;
+		bool m_enabled = false;
+		// Never changes, may be read from any thread
+		const std::thread::id m_owner = std::this_thread::get_id();
+
+		binding_profiler()
+		{
+			m_history.resize(max_frames);
+		}
+
+	public:
+		class scope final {
+			std::size_t m_id;
+			bool m_active;
+			clock_t::time_point m_begin;
+
+		public:
+			// Other threads never reach m_enabled or the counters
+			explicit scope(std::size_t id) : m_id(id), m_active(get().is_owner_thread() && get().m_enabled)
+			{
+				if (m_active)
+					m_begin = clock_t::now();
+			}
+
+			scope(const scope &) = delete;
+
+			~scope()
+			{
+				if (m_active)
+					get().record(m_id, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - m_begin).count()));
+			}
+		};
+
+		binding_profiler(const binding_profiler &) = delete;
+
+		binding_profiler(binding_profiler &&) noexcept = delete;
+
+		static binding_profiler &get()
+		{
+			static binding_profiler profiler;
+			return profiler;
+		}
+
+		// True on the script thread, the only one whose calls are recorded
+		bool is_owner_thread() const
+		{
+			return std::this_thread::get_id() == m_owner;
+		}
+
+		// Register a binding, ns is the CovScript namespace it is registered in, nullptr for the root namespace
+		std::size_t add(const char *ns, const char *name)
+		{
+			m_entries.emplace_back();
+			m_entries.back().name = ns != nullptr ? std::string(ns) + "." + name : name;
+			return m_entries.size() - 1;
+		}
+
+		void record(std::size_t id, std::uint64_t nanos)
+		{
+			entry &e = m_entries[id];
+			if (e.calls == 0)
+				m_touched.push_back(id);
+			++e.calls;
+			e.nanos += nanos;
+		}
+
+		bool is_enabled() const
+		{
+			return m_enabled;
+		}
+
+		void set_enabled(bool enabled)
+		{
+			if (enabled && !m_enabled)
+				m_frame_begin = clock_t::now();
+			m_enabled = enabled;
+		}
+
+		void reset()
+		{
+			for (auto &e : m_entries)
+				e.calls = e.nanos = 0;
+			m_touched.clear();
+			for (auto &f : m_history) {
+				f.nanos = 0;
+				f.samples.clear();
+			}
+			m_history_pos = m_history_size = 0;
+			m_frame_begin = clock_t::now();
+		}
+
+		// Called once per frame from application.prepare(), closes the counters of the previous frame.
+		void next_frame()
+		{
+			if (!m_enabled)
+				return;
+			clock_t::time_point now = clock_t::now();
+			frame &f = m_history[m_history_pos];
+			f.nanos = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_frame_begin).count());
+			f.samples.clear();
+			for (std::size_t id : m_touched) {
+				entry &e = m_entries[id];
+				f.samples.push_back({id, e.calls, e.nanos});
+				e.calls = e.nanos = 0;
+			}
+			m_touched.clear();
+			m_history_pos = (m_history_pos + 1) % max_frames;
+			m_history_size = (std::min)(m_history_size + 1, max_frames);
+			m_frame_begin = now;
+		}
+
+		std::string dump(std::size_t frames, std::size_t top) const
+		{
+			frames = (std::min)(frames, m_history_size);
+			std::vector<std::pair<std::uint64_t, std::uint64_t>> totals(m_entries.size());
+			std::uint64_t frame_nanos = 0;
+			for (std::size_t i = 0; i < frames; ++i) {
+				const frame &f = m_history[(m_history_pos + max_frames - 1 - i) % max_frames];
+				frame_nanos += f.nanos;
+				for (const sample &s : f.samples) {
+					totals[s.id].first += s.calls;
+					totals[s.id].second += s.nanos;
+				}
+			}
+			std::vector<std::size_t> order;
+			for (std::size_t id = 0; id < totals.size(); ++id)
+				if (totals[id].first > 0)
+					order.push_back(id);
+			char line[256];
+			std::string result;
+			std::snprintf(line, sizeof(line), "Binding profile of last %zu frame(s), %.3f ms/frame\n", frames,
+			              frames > 0 ? static_cast<double>(frame_nanos) / frames / 1e6 : 0.0);
+			result += line;
+			if (frames == 0)
+				return result;
+			const char *titles[] = {"By time", "By calls"};
+			for (int pass = 0; pass < 2; ++pass) {
+				std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+					return pass == 0 ? totals[a].second > totals[b].second : totals[a].first > totals[b].first;
+				});
+				std::snprintf(line, sizeof(line), "%s:\n  %-32s %12s %12s %12s %8s\n", titles[pass], "function", "calls/frame",
+				              "ms/frame", "us/call", "%frame");
+				result += line;
+				for (std::size_t i = 0; i < order.size() && i < top; ++i) {
+					const auto &t = totals[order[i]];
+					std::snprintf(line, sizeof(line), "  %-32s %12.1f %12.3f %12.3f %7.1f%%\n", m_entries[order[i]].name.c_str(),
+					              static_cast<double>(t.first) / frames, static_cast<double>(t.second) / frames / 1e6,
+					              static_cast<double>(t.second) / t.first / 1e3,
+					              frame_nanos > 0 ? 100.0 * t.second / frame_nanos : 0.0);
+					result += line;
+				}
+			}
+			return result;
+		}
+	};
+
+	// Wraps a plain binding function so that every call is accounted by binding_profiler.
+	template<typename T, T func>
+	struct profiled;
+
+	template<typename R, typename... ArgsT, R(*func)(ArgsT...)>
+	struct profiled<R(*)(ArgsT...), func> {
+		static std::size_t id;
+
+		static R call(ArgsT... args)
+		{
+			binding_profiler::scope guard(id);
+			return func(std::forward<ArgsT>(args)...);
+		}
+
+		static R(*bind(const char *ns, const char *name))(ArgsT...)
+		{
+			id = binding_profiler::get().add(ns, name);
+			return &call;
+		}
+	};
+
+	template<typename R, typename... ArgsT, R(*func)(ArgsT...)>
+	std::size_t profiled<R(*)(ArgsT...), func>::id = 0;
+
+	// Same for a function pointer or a lambda given by value, as CNI_V(...) takes them.
+	// tag_t is the type of a lambda written at the binding, which is unique to it: every binding gets its own copy
+	// of func even when several of them wrap functions of the same type.
+	template<typename tag_t, typename F, typename sig_t>
+	struct profiled_value;
+
+	template<typename tag_t, typename F, typename R, typename... ArgsT>
+	struct profiled_value<tag_t, F, R(ArgsT...)> {
+		static std::size_t id;
+		static const F *func;
+
+		static R call(ArgsT... args)
+		{
+			binding_profiler::scope guard(id);
+			return (*func)(std::forward<ArgsT>(args)...);
+		}
+
+		static R(*bind(const F &f, const char *ns, const char *name))(ArgsT...)
+		{
+			// Lives as long as the binding, i.e. the process
+			func = new F(f);
+			id = binding_profiler::get().add(ns, name);
+			return &call;
+		}
+	};
+
+	template<typename tag_t, typename F, typename R, typename... ArgsT>
+	std::size_t profiled_value<tag_t, F, R(ArgsT...)>::id = 0;
+
+	template<typename tag_t, typename F, typename R, typename... ArgsT>
+	const F *profiled_value<tag_t, F, R(ArgsT...)>::func = nullptr;
+
+	template<typename T>
+	struct function_signature : function_signature<decltype(&T::operator())> {
+	};
+
+	template<typename R, typename... ArgsT>
+	struct function_signature<R(*)(ArgsT...)> {
+		using type = R(ArgsT...);
+	};
+
+	template<typename R, typename C, typename... ArgsT>
+	struct function_signature<R(C::*)(ArgsT...) const> {
+		using type = R(ArgsT...);
+	};
+
+	template<typename tag_t, typename F>
+	auto profile_value(tag_t, F func, const char *ns, const char *name)
+	{
+		return profiled_value<tag_t, F, typename function_signature<F>::type>::bind(func, ns, name);
+	}
+}
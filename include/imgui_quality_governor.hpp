@@ -0,0 +1,192 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Quality Governor
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <chrono>
+
+#include <imgui.h>
+
+namespace imgui_cs {
+	// Trades drawing quality for frame time when a frame budget is set.
+	// Level 0 is the style as the script left it, every further level is cheaper to tessellate and fill:
+	//   level  circle error  segments  update interval  anti-aliasing
+	//   1      x2            <= 48     2                lines, fill
+	//   2      x4            <= 24     3                lines
+	//   3      x6            <= 12     4                none
+	// The level drops one step when the averaged frame time exceeds the budget, and rises one step after
+	// a long stretch well below it. A level that had to be left again soon after rising doubles the wait
+	// before the next attempt, so a frame time sitting right at the budget does not flip levels forever.
+	// The frame time is the interval between two application.prepare() calls, vsync included:
+	// with vsync on the budget has to be above the refresh interval to ever leave headroom.
+	class quality_governor final {
+		using clock_t = std::chrono::steady_clock;
+
+		struct level {
+			float circle_error_scale;
+			int max_segments;
+			int update_interval;
+			bool anti_aliased_lines;
+			bool anti_aliased_fill;
+		};
+
+		static constexpr int level_count = 4;
+		// Frames averaged after a level change before the next decision
+		static constexpr int settle_frames = 30;
+		static constexpr int min_restore_frames = 120;
+		static constexpr int max_restore_frames = 1920;
+		static constexpr float degrade_ratio = 1.05f;
+		static constexpr float restore_ratio = 0.75f;
+
+		static const level &levels(int index)
+		{
+			static const level table[level_count] = {
+				{1.0f, 0, 1, true, true},
+				{2.0f, 48, 2, true, true},
+				{4.0f, 24, 3, true, false},
+				{6.0f, 12, 4, false, false}
+			};
+			return table[index];
+		}
+
+		// Style values of level 0, captured when the governor is enabled
+		bool m_anti_aliased_lines = true;
+		bool m_anti_aliased_fill = true;
+		float m_circle_error = 0.3f;
+
+		float m_budget = 0.0f;
+		float m_average = 0.0f;
+		int m_level = 0;
+		int m_frames = 0;
+		int m_restore_frames = min_restore_frames;
+		bool m_restoring = false;
+		bool m_started = false;
+		clock_t::time_point m_last_frame;
+
+		quality_governor() = default;
+
+		void apply()
+		{
+			const level &l = levels(m_level);
+			ImGuiStyle &style = ImGui::GetStyle();
+			style.AntiAliasedLines = m_anti_aliased_lines && l.anti_aliased_lines;
+			style.AntiAliasedFill = m_anti_aliased_fill && l.anti_aliased_fill;
+			style.CircleTessellationMaxError = m_circle_error * l.circle_error_scale;
+		}
+
+		void change_level(int next)
+		{
+			if (next < m_level) {
+				// Rising quality is an attempt, it only counts as successful after a while at the new level
+				m_restoring = true;
+			}
+			else if (m_restoring && m_frames < m_restore_frames) {
+				if (m_restore_frames < max_restore_frames)
+					m_restore_frames *= 2;
+				m_restoring = false;
+			}
+			m_level = next;
+			m_frames = 0;
+			apply();
+		}
+
+	public:
+		quality_governor(const quality_governor &) = delete;
+
+		quality_governor(quality_governor &&) noexcept = delete;
+
+		static quality_governor &get()
+		{
+			static quality_governor governor;
+			return governor;
+		}
+
+		// Frame budget in milliseconds, 0 disables the governor and restores the style to level 0.
+		void set_budget(float budget_ms)
+		{
+			if (!(budget_ms >= 0.0f))
+				throw cs::lang_error("Invalid frame budget.");
+			if (m_budget <= 0.0f && budget_ms > 0.0f) {
+				const ImGuiStyle &style = ImGui::GetStyle();
+				m_anti_aliased_lines = style.AntiAliasedLines;
+				m_anti_aliased_fill = style.AntiAliasedFill;
+				m_circle_error = style.CircleTessellationMaxError;
+			}
+			else if (m_budget > 0.0f && budget_ms <= 0.0f) {
+				m_level = 0;
+				apply();
+			}
+			m_budget = budget_ms;
+			m_frames = 0;
+			m_restore_frames = min_restore_frames;
+			m_restoring = false;
+			m_started = false;
+		}
+
+		float get_budget() const
+		{
+			return m_budget;
+		}
+
+		int get_level() const
+		{
+			return m_level;
+		}
+
+		// Upper bound of script supplied circle segment counts, 0 when unbounded
+		int get_max_segments() const
+		{
+			return levels(m_level).max_segments;
+		}
+
+		// Throttled widgets refresh their content every this many frames
+		int get_update_interval() const
+		{
+			return levels(m_level).update_interval;
+		}
+
+		// Called once per frame from application.prepare() before the new frame starts, so that style changes apply to it.
+		void next_frame()
+		{
+			if (m_budget <= 0.0f)
+				return;
+			const clock_t::time_point now = clock_t::now();
+			if (!m_started) {
+				m_started = true;
+				m_last_frame = now;
+				return;
+			}
+			const float frame_ms = std::chrono::duration<float, std::milli>(now - m_last_frame).count();
+			m_last_frame = now;
+			m_average = m_frames == 0 ? frame_ms : m_average * 0.9f + frame_ms * 0.1f;
+			++m_frames;
+			if (m_restoring && m_frames >= m_restore_frames) {
+				m_restoring = false;
+				m_restore_frames = min_restore_frames;
+			}
+			if (m_frames < settle_frames)
+				return;
+			if (m_average > m_budget * degrade_ratio && m_level + 1 < level_count)
+				change_level(m_level + 1);
+			else if (m_average < m_budget * restore_ratio && m_level > 0 && m_frames >= m_restore_frames)
+				change_level(m_level - 1);
+		}
+	};
+}
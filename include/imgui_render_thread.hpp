@@ -0,0 +1,248 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Render Thread
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <cstring>
+
+#include <imgui.h>
+
+namespace imgui_cs {
+	// A single worker owning the graphics context.
+	// At most one job is in flight: submit() waits for the previous job before queueing the next one,
+	// which gives the script thread exactly one frame of overlap with the driver.
+	class render_thread final {
+		std::mutex m_mutex;
+		std::condition_variable m_cond;
+		std::function<void()> m_job;
+		std::exception_ptr m_error;
+		bool m_busy = false;
+		bool m_stop = false;
+		// Declared last, the worker must not start before the members above are constructed
+		std::thread m_thread;
+
+		void main()
+		{
+			for (;;) {
+				std::function<void()> job;
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_cond.wait(lock, [this] {
+						return m_job || m_stop;
+					});
+					if (!m_job)
+						return;
+					job = std::move(m_job);
+					m_job = nullptr;
+				}
+				std::exception_ptr error;
+				try {
+					job();
+				}
+				catch (...) {
+					error = std::current_exception();
+				}
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (error && !m_error)
+						m_error = error;
+					m_busy = false;
+				}
+				m_cond.notify_all();
+			}
+		}
+
+	public:
+		render_thread() : m_thread([this] {
+			main();
+		}) {}
+
+		render_thread(const render_thread &) = delete;
+
+		render_thread(render_thread &&) noexcept = delete;
+
+		~render_thread()
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_cond.wait(lock, [this] {
+					return !m_busy;
+				});
+				m_stop = true;
+			}
+			m_cond.notify_all();
+			m_thread.join();
+		}
+
+		bool is_current() const
+		{
+			return std::this_thread::get_id() == m_thread.get_id();
+		}
+
+		// Wait for the job in flight, rethrowing its exception on the calling thread.
+		void wait()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cond.wait(lock, [this] {
+				return !m_busy;
+			});
+			if (m_error) {
+				std::exception_ptr error = m_error;
+				m_error = nullptr;
+				std::rethrow_exception(error);
+			}
+		}
+
+		void submit(std::function<void()> job)
+		{
+			wait();
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_job = std::move(job);
+				m_busy = true;
+			}
+			m_cond.notify_all();
+		}
+
+		void run(std::function<void()> job)
+		{
+			if (is_current()) {
+				job();
+				return;
+			}
+			submit(std::move(job));
+			wait();
+		}
+	};
+
+	// Deep copy of ImDrawData, so the script thread can start the next frame while this one is being submitted.
+	// Capacity of the copied buffers is kept between frames.
+	class draw_data_snapshot final {
+		ImVector<ImDrawList *> m_lists;
+		ImDrawData m_data;
+
+		template<typename T>
+		static void copy_vector(ImVector<T> &dst, const ImVector<T> &src)
+		{
+			dst.resize(src.Size);
+			if (src.Size > 0)
+				std::memcpy(dst.Data, src.Data, static_cast<std::size_t>(src.Size) * sizeof(T));
+		}
+
+	public:
+		draw_data_snapshot() = default;
+
+		draw_data_snapshot(const draw_data_snapshot &) = delete;
+
+		~draw_data_snapshot()
+		{
+			for (ImDrawList *list : m_lists)
+				IM_DELETE(list);
+		}
+
+		void capture(const ImDrawData *src)
+		{
+			while (m_lists.Size < src->CmdLists.Size)
+				m_lists.push_back(IM_NEW(ImDrawList)(nullptr));
+			m_data.Clear();
+			m_data.Valid = src->Valid;
+			m_data.TotalIdxCount = src->TotalIdxCount;
+			m_data.TotalVtxCount = src->TotalVtxCount;
+			m_data.DisplayPos = src->DisplayPos;
+			m_data.DisplaySize = src->DisplaySize;
+			m_data.FramebufferScale = src->FramebufferScale;
+			// Textures are updated synchronously by the owner before submission, never from the snapshot
+			m_data.Textures = nullptr;
+			for (int i = 0; i < src->CmdLists.Size; ++i) {
+				const ImDrawList *src_list = src->CmdLists[i];
+				ImDrawList *dst_list = m_lists[i];
+				copy_vector(dst_list->CmdBuffer, src_list->CmdBuffer);
+				copy_vector(dst_list->IdxBuffer, src_list->IdxBuffer);
+				copy_vector(dst_list->VtxBuffer, src_list->VtxBuffer);
+				copy_vector(dst_list->_CallbacksDataBuf, src_list->_CallbacksDataBuf);
+				dst_list->Flags = src_list->Flags;
+				// Callback payloads live in the draw list, re-point them to our copy
+				for (ImDrawCmd &cmd : dst_list->CmdBuffer)
+					if (cmd.UserCallback != nullptr && cmd.UserCallbackDataSize > 0)
+						cmd.UserCallbackData = dst_list->_CallbacksDataBuf.Data + cmd.UserCallbackDataOffset;
+				m_data.CmdLists.push_back(dst_list);
+			}
+			m_data.CmdListsCount = m_data.CmdLists.Size;
+		}
+
+		// Replace ImTextureData references by their backend identifiers.
+		// Must be called after the texture requests of this frame have been processed.
+		void resolve_textures()
+		{
+			for (ImDrawList *list : m_data.CmdLists)
+				for (ImDrawCmd &cmd : list->CmdBuffer)
+					if (cmd.UserCallback == nullptr && cmd.TexRef._TexData != nullptr)
+						cmd.TexRef = ImTextureRef(cmd.TexRef._TexData->TexID);
+		}
+
+		ImDrawData *get()
+		{
+			return &m_data;
+		}
+	};
+
+	// Frames handed over to a render thread, two snapshots used in turn.
+	// Texture requests mutate ImTextureData owned by the script thread, they are processed on the render thread
+	// while the script thread waits. The frame itself is drawn from a snapshot while the next one is being built.
+	class threaded_frames final {
+		draw_data_snapshot m_snapshots[2];
+		int m_index = 0;
+
+	public:
+		// Submit the draw data of ImGui::Render() to thread: update_texture(tex) processes a texture request,
+		// draw(draw_data) draws the frame from the snapshot. Both run on the render thread.
+		template<typename update_t, typename draw_t>
+		void submit(render_thread &thread, ImDrawData *draw_data, update_t update_texture, draw_t draw)
+		{
+			draw_data_snapshot &snapshot = m_snapshots[m_index];
+			m_index ^= 1;
+			// The other snapshot may still be in flight. This one is free: submitting the previous frame waited for its job.
+			snapshot.capture(draw_data);
+			bool want_texture_updates = false;
+			if (draw_data->Textures != nullptr)
+				for (ImTextureData *tex : *draw_data->Textures)
+					if (tex->Status != ImTextureStatus_OK)
+						want_texture_updates = true;
+			if (want_texture_updates)
+				thread.run([draw_data, update_texture] {
+					for (ImTextureData *tex : *draw_data->Textures)
+						if (tex->Status != ImTextureStatus_OK)
+							update_texture(tex);
+				});
+			else
+				thread.wait();
+			snapshot.resolve_textures();
+			thread.submit([&snapshot, draw] {
+				draw(snapshot.get());
+			});
+		}
+	};
+}
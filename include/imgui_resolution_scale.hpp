@@ -0,0 +1,124 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Dynamic Resolution
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <cmath>
+
+#include <imgui.h>
+
+namespace imgui_cs {
+	// Chooses the internal render scale of a frame which is drawn into an offscreen target and upscaled to the window.
+	// Only the framebuffer shrinks: io.DisplaySize, io.DisplayFramebufferScale and input coordinates keep window units,
+	// the application multiplies ImDrawData::FramebufferScale by get_scale() for the offscreen pass only.
+	// With a budget the scale follows the measured render time, fill cost is assumed to grow with the pixel count.
+	class resolution_scaler final {
+		static constexpr float min_scale = 0.5f;
+		static constexpr float step = 0.125f;
+		// Frames averaged before the scale may change again, scaled frames need time to show their cost
+		static constexpr int settle_frames = 30;
+		// Grow only when the next step is predicted to stay this far below the budget, avoids oscillating
+		static constexpr float headroom = 0.85f;
+
+		float m_scale = 1.0f;
+		float m_budget = 0.0f;
+		float m_average = 0.0f;
+		int m_frames = 0;
+
+		static float quantize(float scale)
+		{
+			scale = std::floor(scale / step) * step;
+			return scale < min_scale ? min_scale : (scale > 1.0f ? 1.0f : scale);
+		}
+
+	public:
+		// Fixed scale, disables the budget. Returns the scale actually used.
+		float set_scale(float scale)
+		{
+			if (!(scale > 0.0f))
+				throw cs::lang_error("Invalid render scale.");
+			m_budget = 0.0f;
+			m_scale = quantize(scale + step * 0.5f);
+			m_frames = 0;
+			return m_scale;
+		}
+
+		// Render time budget in milliseconds, 0 disables automatic scaling and restores full resolution.
+		void set_budget(float budget_ms)
+		{
+			if (!(budget_ms >= 0.0f))
+				throw cs::lang_error("Invalid frame budget.");
+			m_budget = budget_ms;
+			m_scale = 1.0f;
+			m_frames = 0;
+		}
+
+		float get_budget() const
+		{
+			return m_budget;
+		}
+
+		float get_scale() const
+		{
+			return m_scale;
+		}
+
+		// Whether render time has to be measured at all
+		bool is_dynamic() const
+		{
+			return m_budget > 0.0f;
+		}
+
+		// Size of the offscreen target for a window framebuffer
+		int scaled(int size) const
+		{
+			int result = static_cast<int>(size * m_scale + 0.5f);
+			return result > 0 ? result : 1;
+		}
+
+		// Feed the measured render time of a frame drawn at get_scale()
+		void update(float render_ms)
+		{
+			if (m_budget <= 0.0f || render_ms < 0.0f)
+				return;
+			// The first frame at a new scale also pays for reallocating the target, leave it out
+			if (m_frames++ == 0)
+				return;
+			m_average = m_frames == 2 ? render_ms : m_average * 0.9f + render_ms * 0.1f;
+			if (m_frames < settle_frames)
+				return;
+			float next = m_scale;
+			if (m_average > m_budget) {
+				next = quantize(m_scale * std::sqrt(m_budget / m_average));
+				if (next == m_scale)
+					next = quantize(m_scale - step);
+			}
+			else if (m_scale < 1.0f) {
+				const float grow = (m_scale + step) / m_scale;
+				if (m_average * grow * grow < m_budget * headroom)
+					next = quantize(m_scale + step);
+			}
+			if (next != m_scale) {
+				m_scale = next;
+				m_frames = 0;
+			}
+		}
+	};
+}
@@ -139,4 +139,16 @@ namespace imgui_cs {
 			throw cs::lang_error("Monitor does not exist.");
 		return bounds.h;
 	}
+
+	// Renderer options, read by SDL when the next application creates its renderer.
+	// An empty name restores SDL's default choice, see SDL_HINT_RENDER_DRIVER for valid names.
+	bool set_render_driver(const std::string &name)
+	{
+		return SDL_SetHint(SDL_HINT_RENDER_DRIVER, name.empty() ? nullptr : name.c_str()) == SDL_TRUE;
+	}
+
+	bool set_render_batching(bool enabled)
+	{
+		return SDL_SetHint(SDL_HINT_RENDER_BATCHING, enabled ? "1" : "0") == SDL_TRUE;
+	}
 }
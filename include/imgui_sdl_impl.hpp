@@ -23,6 +23,7 @@
 #include <imgui_sdl.hpp>
 #include <imgui_impl_sdl2.h>
 #include <imgui_impl_sdlrenderer2.h>
+#include <imgui_resolution_scale.hpp>
 
 namespace imgui_cs {
 	class application final {
@@ -30,6 +31,10 @@ namespace imgui_cs {
 		SDL_Renderer *renderer = nullptr;
 		ImVec4 bg_color = {0.25f, 0.25f, 0.25f, 1.0f};
 		bool m_closed = false;
+		resolution_scaler m_scaler;
+		SDL_Texture *m_scaled_target = nullptr;
+		int m_scaled_width = 0;
+		int m_scaled_height = 0;
 
 		void init()
 		{
@@ -48,12 +53,13 @@ namespace imgui_cs {
 				throw cs::lang_error("Failed to init SDL2 renderer backend!");
 			}
 			g_SDLRenderer = renderer;
+			// We created the renderer and are its only user, no need to save and restore its state every frame
+			ImGui_ImplSDLRenderer2_SetExclusiveRenderer(true);
+			// Fonts only need coverage: the atlas stays single channel in memory, the renderer expands it on upload
+			ImGui::GetIO().Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
 
 			// Load default font
-			ImFontConfig font_cfg = ImFontConfig();
-			ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "DefaultFont, 14px");
-			ImFont *font = ImGui::GetIO().Fonts->AddFontFromMemoryCompressedBase85TTF(
-			                   get_default_font_data(), 14, &font_cfg);
+			ImFont *font = load_font(get_default_font(), 14);
 			if (font == nullptr) {
 				g_SDLRenderer = nullptr;
 				ImGui_ImplSDLRenderer2_Shutdown();
@@ -137,6 +143,8 @@ namespace imgui_cs {
 			ImGui_ImplSDL2_Shutdown();
 			ImGui::DestroyContext();
 			g_SDLRenderer = nullptr; // Clear before destroying renderer so image destructors skip texture teardown
+			if (m_scaled_target)
+				SDL_DestroyTexture(m_scaled_target);
 			if (renderer)
 				SDL_DestroyRenderer(renderer);
 			if (window)
@@ -173,6 +181,47 @@ namespace imgui_cs {
 			bg_color = color;
 		}
 
+		// SDL_Renderer must be used from the thread that created the window.
+		void set_threaded_render(bool enabled)
+		{
+			if (enabled)
+				throw cs::lang_error("Threaded rendering is not supported by SDL_Renderer implementation.");
+		}
+
+		bool is_threaded_render() const
+		{
+			return false;
+		}
+
+		std::string get_render_driver() const
+		{
+			SDL_RendererInfo info;
+			if (SDL_GetRendererInfo(renderer, &info) != 0)
+				throw cs::lang_error(SDL_GetError());
+			return info.name;
+		}
+
+		// Render at a fixed fraction of the framebuffer and upscale to the window, 1 renders directly.
+		// Returns the scale actually used: steps of 1/8 within [0.5, 1], or 1 when the renderer has no render targets.
+		float set_render_scale(float scale)
+		{
+			if (!SDL_RenderTargetSupported(renderer))
+				return 1.0f;
+			return m_scaler.set_scale(scale);
+		}
+
+		float get_render_scale() const
+		{
+			return m_scaler.get_scale();
+		}
+
+		// Choose the render scale automatically from the time SDL needs to execute the frame, 0 goes back to full resolution.
+		void set_render_budget(float budget_ms)
+		{
+			if (SDL_RenderTargetSupported(renderer))
+				m_scaler.set_budget(budget_ms);
+		}
+
 		bool is_closed() const
 		{
 			return m_closed;
@@ -198,20 +247,70 @@ namespace imgui_cs {
 		void render()
 		{
 			ImGui::Render();
+			ImDrawData *draw_data = ImGui::GetDrawData();
+			const bool timed = m_scaler.is_dynamic();
+			const Uint64 begin = timed ? SDL_GetPerformanceCounter() : 0;
 			// On HiDPI displays (e.g. macOS Retina), the framebuffer is larger
 			// than the logical window size. Set SDL_RenderSetScale so that
 			// ImGui's logical-coordinate vertices fill the entire framebuffer.
-			const ImVec2 &fb_scale = ImGui::GetIO().DisplayFramebufferScale;
-			SDL_RenderSetScale(renderer, fb_scale.x, fb_scale.y);
+			const ImVec2 fb_scale = ImGui::GetIO().DisplayFramebufferScale;
+			int display_w = 0, display_h = 0;
+			SDL_GetRendererOutputSize(renderer, &display_w, &display_h);
+			SDL_Texture *target = ensure_scaled_target(display_w, display_h);
+			if (target != nullptr) {
+				// Only the framebuffer is smaller, positions and clip rects stay in window units
+				SDL_SetRenderTarget(renderer, target);
+				draw_data->FramebufferScale = ImVec2(fb_scale.x * m_scaled_width / display_w, fb_scale.y * m_scaled_height / display_h);
+				SDL_RenderSetScale(renderer, draw_data->FramebufferScale.x, draw_data->FramebufferScale.y);
+			}
+			else
+				SDL_RenderSetScale(renderer, fb_scale.x, fb_scale.y);
 			SDL_SetRenderDrawColor(renderer,
 			                       static_cast<Uint8>(bg_color.x * 255),
 			                       static_cast<Uint8>(bg_color.y * 255),
 			                       static_cast<Uint8>(bg_color.z * 255),
 			                       static_cast<Uint8>(bg_color.w * 255));
 			SDL_RenderClear(renderer);
-			ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
+			ImGui_ImplSDLRenderer2_RenderDrawData(draw_data, renderer);
+			if (target != nullptr) {
+				draw_data->FramebufferScale = fb_scale;
+				SDL_SetRenderTarget(renderer, nullptr);
+				// The exclusive backend leaves the clip rect of the last command in place, and switching targets
+				// restores the window's: without resetting it the copy would be clipped to it
+				SDL_RenderSetClipRect(renderer, nullptr);
+				SDL_RenderSetViewport(renderer, nullptr);
+				SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+				SDL_RenderCopy(renderer, target, nullptr, nullptr);
+			}
+			if (timed) {
+				// SDL batches draw calls until present, flush so that the measured time covers the actual rendering
+				SDL_RenderFlush(renderer);
+				m_scaler.update(static_cast<float>((SDL_GetPerformanceCounter() - begin) * 1000.0 / SDL_GetPerformanceFrequency()));
+			}
 			SDL_RenderPresent(renderer);
 		}
+
+	private:
+		// Offscreen target for the current render scale, nullptr when rendering directly to the window
+		SDL_Texture *ensure_scaled_target(int display_w, int display_h)
+		{
+			if (m_scaler.get_scale() >= 1.0f || display_w <= 0 || display_h <= 0)
+				return nullptr;
+			const int width = m_scaler.scaled(display_w);
+			const int height = m_scaler.scaled(display_h);
+			if (m_scaled_target != nullptr && m_scaled_width == width && m_scaled_height == height)
+				return m_scaled_target;
+			if (m_scaled_target != nullptr)
+				SDL_DestroyTexture(m_scaled_target);
+			m_scaled_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+			if (m_scaled_target == nullptr)
+				return nullptr;
+			SDL_SetTextureBlendMode(m_scaled_target, SDL_BLENDMODE_NONE);
+			SDL_SetTextureScaleMode(m_scaled_target, SDL_ScaleModeLinear);
+			m_scaled_width = width;
+			m_scaled_height = height;
+			return m_scaled_target;
+		}
 	};
 }
 
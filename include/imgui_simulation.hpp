@@ -0,0 +1,451 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Simulation Thread
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <imgui.h>
+
+namespace imgui_cs {
+	// Single producer, single consumer ring buffer. One slot is kept empty to tell full from empty.
+	template<typename T, std::size_t N>
+	class spsc_queue final {
+		T m_items[N];
+		std::atomic<std::size_t> m_head{0};
+		std::atomic<std::size_t> m_tail{0};
+
+	public:
+		bool push(const T &item)
+		{
+			std::size_t tail = m_tail.load(std::memory_order_relaxed);
+			std::size_t next = (tail + 1) % N;
+			if (next == m_head.load(std::memory_order_acquire))
+				return false;
+			m_items[tail] = item;
+			m_tail.store(next, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(T &item)
+		{
+			std::size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_tail.load(std::memory_order_acquire))
+				return false;
+			item = m_items[head];
+			m_head.store((head + 1) % N, std::memory_order_release);
+			return true;
+		}
+	};
+
+	// Lock-free triple buffer: the writer always owns back(), the reader always owns front(),
+	// the third buffer is exchanged atomically together with a "fresh" flag.
+	template<typename T>
+	class triple_buffer final {
+		static constexpr unsigned fresh_bit = 4;
+		T m_buffers[3];
+		std::atomic<unsigned> m_middle{1};
+		unsigned m_back = 0;
+		unsigned m_front = 2;
+
+	public:
+		T &back()
+		{
+			return m_buffers[m_back];
+		}
+
+		const T &front() const
+		{
+			return m_buffers[m_front];
+		}
+
+		T &at(unsigned i)
+		{
+			return m_buffers[i];
+		}
+
+		void publish()
+		{
+			m_back = m_middle.exchange(m_back | fresh_bit, std::memory_order_acq_rel) & 3;
+		}
+
+		bool acquire()
+		{
+			if (!(m_middle.load(std::memory_order_relaxed) & fresh_bit))
+				return false;
+			m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & 3;
+			return true;
+		}
+	};
+
+	struct input_snapshot {
+		double time = 0;
+		ImVec2 mouse_pos;
+		ImVec2 display_size;
+		bool mouse_down[ImGuiMouseButton_COUNT] = {};
+		std::bitset<ImGuiKey_NamedKey_COUNT> keys_down;
+
+		static input_snapshot capture()
+		{
+			const ImGuiIO &io = ImGui::GetIO();
+			input_snapshot s;
+			s.time = ImGui::GetTime();
+			s.mouse_pos = io.MousePos;
+			s.display_size = io.DisplaySize;
+			for (int i = 0; i < ImGuiMouseButton_COUNT; ++i)
+				s.mouse_down[i] = io.MouseDown[i];
+			for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; ++key)
+				s.keys_down[key - ImGuiKey_NamedKey_BEGIN] = ImGui::IsKeyDown(static_cast<ImGuiKey>(key));
+			return s;
+		}
+	};
+
+	// Runs an update function at a fixed tick rate, with the input of the frames published by application.prepare()
+	// and its results in a block of numeric slots. Two ways to run it:
+	// - start() runs a native update on its own thread. Input goes through a queue of immutable snapshots and
+	//   the UI thread reads the slots from a triple buffer, neither side ever blocks. The update must not
+	//   release the last reference to the simulation.
+	// - start_stepped() runs the update on the UI thread inside application.prepare(), as many ticks as the
+	//   time elapsed since the previous frame asks for. Script updates run this way: the interpreter is not
+	//   reentrant and its reference counts are not atomic, so it never runs on another thread.
+	// The simulations in use are only ever tracked and destroyed on the UI thread.
+	class simulation final : public std::enable_shared_from_this<simulation> {
+		using clock_t = std::chrono::steady_clock;
+		using step_t = std::function<void(const std::shared_ptr<simulation> &)>;
+
+		// Ticks run in one go at most, after a stall the simulation slows down instead of catching up
+		static constexpr int max_catch_up = 4;
+
+		spsc_queue<input_snapshot, 64> m_inputs;
+		triple_buffer<std::vector<double>> m_states;
+		// Update only, and the UI thread between the ticks of a stepped simulation
+		std::vector<double> m_work;
+		input_snapshot m_input;
+		std::bitset<ImGuiKey_NamedKey_COUNT> m_keys_pressed;
+		bool m_mouse_clicked[ImGuiMouseButton_COUNT] = {};
+		double m_delta_time;
+		// UI thread only
+		input_snapshot m_last_published;
+		step_t m_step;
+		double m_step_time = 0;
+		double m_accumulator = 0;
+		bool m_stepping = false;
+
+		std::mutex m_mutex;
+		std::condition_variable m_wakeup;
+		std::atomic<bool> m_running{true};
+		std::atomic<std::uint64_t> m_ticks{0};
+		std::exception_ptr m_error;
+		std::atomic<bool> m_failed{false};
+		std::atomic<std::thread::id> m_thread_id;
+		std::thread m_thread;
+
+		static std::vector<std::weak_ptr<simulation>> &registry()
+		{
+			static std::vector<std::weak_ptr<simulation>> sims;
+			return sims;
+		}
+
+		// Presses and clicks are kept until a tick has seen them
+		void feed_input(const input_snapshot &next)
+		{
+			m_keys_pressed |= next.keys_down & ~m_input.keys_down;
+			for (int i = 0; i < ImGuiMouseButton_COUNT; ++i)
+				m_mouse_clicked[i] = m_mouse_clicked[i] || (next.mouse_down[i] && !m_input.mouse_down[i]);
+			m_input = next;
+		}
+
+		void clear_edges()
+		{
+			m_keys_pressed.reset();
+			for (bool &clicked : m_mouse_clicked)
+				clicked = false;
+		}
+
+		template<typename T>
+		void main(T update)
+		{
+			m_thread_id.store(std::this_thread::get_id());
+			const std::chrono::nanoseconds period(static_cast<std::int64_t>(m_delta_time * 1e9));
+			clock_t::time_point next = clock_t::now();
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (m_running.load(std::memory_order_relaxed)) {
+				lock.unlock();
+				input_snapshot snapshot;
+				while (m_inputs.pop(snapshot))
+					feed_input(snapshot);
+				try {
+					update(*this);
+				}
+				catch (...) {
+					m_error = std::current_exception();
+					m_failed.store(true, std::memory_order_release);
+					return;
+				}
+				clear_edges();
+				m_states.back().assign(m_work.begin(), m_work.end());
+				m_states.publish();
+				m_ticks.fetch_add(1, std::memory_order_relaxed);
+				next += period;
+				clock_t::time_point now = clock_t::now();
+				if (now - next > period * max_catch_up)
+					next = now;
+				lock.lock();
+				m_wakeup.wait_until(lock, next, [this] { return !m_running.load(std::memory_order_relaxed); });
+			}
+		}
+
+		// UI thread, once per frame of a stepped simulation
+		void step(const std::shared_ptr<simulation> &self, const input_snapshot &snapshot)
+		{
+			feed_input(snapshot);
+			m_accumulator += snapshot.time - m_step_time;
+			m_step_time = snapshot.time;
+			for (int n = 0; n < max_catch_up && m_accumulator >= m_delta_time; ++n) {
+				m_accumulator -= m_delta_time;
+				m_stepping = true;
+				try {
+					m_step(self);
+				}
+				catch (...) {
+					m_stepping = false;
+					m_failed.store(true, std::memory_order_release);
+					throw;
+				}
+				m_stepping = false;
+				clear_edges();
+				m_ticks.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (m_accumulator >= m_delta_time)
+				m_accumulator = 0;
+		}
+
+		bool is_stepped() const
+		{
+			return static_cast<bool>(m_step);
+		}
+
+		// Inside the update: on the simulation thread, or on the UI thread while a stepped tick runs
+		bool in_update() const
+		{
+			return on_simulation_thread() || m_stepping;
+		}
+
+		static int key_index(ImGuiKey key)
+		{
+			if (key < ImGuiKey_NamedKey_BEGIN || key >= ImGuiKey_NamedKey_END)
+				throw cs::lang_error("Invalid key.");
+			return key - ImGuiKey_NamedKey_BEGIN;
+		}
+
+		static int button_index(int button)
+		{
+			if (button < 0 || button >= ImGuiMouseButton_COUNT)
+				throw cs::lang_error("Invalid mouse button.");
+			return button;
+		}
+
+		const input_snapshot &input() const
+		{
+			return in_update() ? m_input : m_last_published;
+		}
+
+	public:
+		simulation(std::size_t slots, double tick_rate) : m_work(slots, 0.0)
+		{
+			if (tick_rate <= 0)
+				throw cs::lang_error("Invalid tick rate.");
+			m_delta_time = 1.0 / tick_rate;
+			for (unsigned i = 0; i < 3; ++i)
+				m_states.at(i).assign(slots, 0.0);
+			m_last_published = input_snapshot::capture();
+			m_input = m_last_published;
+			m_step_time = m_last_published.time;
+		}
+
+		simulation(const simulation &) = delete;
+
+		simulation(simulation &&) noexcept = delete;
+
+		// The registry only holds weak references, publish_all() drops the expired ones
+		~simulation()
+		{
+			IM_ASSERT(!on_simulation_thread() && "A simulation must not be destroyed by its own update.");
+			stop();
+			if (m_thread.joinable())
+				m_thread.join();
+		}
+
+		// From the UI thread: run update(simulation &) on a new thread, update must be native code.
+		template<typename T>
+		void start(T update)
+		{
+			registry().push_back(shared_from_this());
+			m_thread = std::thread([this](T update) {
+				main(std::move(update));
+			}, std::move(update));
+		}
+
+		// From the UI thread: run update(self) in every application.prepare() from now on.
+		void start_stepped(step_t update)
+		{
+			m_step = std::move(update);
+			registry().push_back(shared_from_this());
+		}
+
+		// The thread finishes its tick and exits, it is joined when the simulation is destroyed
+		void stop()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_running.store(false, std::memory_order_relaxed);
+			}
+			m_wakeup.notify_all();
+		}
+
+		bool is_running() const
+		{
+			return m_running.load(std::memory_order_relaxed) && !m_failed.load(std::memory_order_acquire);
+		}
+
+		bool on_simulation_thread() const
+		{
+			return std::this_thread::get_id() == m_thread_id.load();
+		}
+
+		// Called once per frame from application.prepare(): publish input, pick up the latest state of the
+		// threaded simulations, tick the stepped ones. Errors of a stepped update propagate from here.
+		static void publish_all()
+		{
+			auto &sims = registry();
+			if (sims.empty())
+				return;
+			input_snapshot snapshot = input_snapshot::capture();
+			// By index: a stepped update may start simulations, which grows the registry
+			for (std::size_t i = 0; i < sims.size();) {
+				std::shared_ptr<simulation> sim = sims[i].lock();
+				if (!sim) {
+					sims.erase(sims.begin() + i);
+					continue;
+				}
+				++i;
+				sim->m_last_published = snapshot;
+				if (!sim->is_stepped()) {
+					sim->m_inputs.push(snapshot);
+					sim->m_states.acquire();
+				}
+				else if (sim->is_running())
+					sim->step(sim, snapshot);
+			}
+		}
+
+		void check_error()
+		{
+			if (m_failed.load(std::memory_order_acquire) && m_error) {
+				std::exception_ptr error = m_error;
+				m_error = nullptr;
+				std::rethrow_exception(error);
+			}
+		}
+
+		std::uint64_t get_ticks() const
+		{
+			return m_ticks.load(std::memory_order_relaxed);
+		}
+
+		double get_delta_time() const
+		{
+			return m_delta_time;
+		}
+
+		std::size_t get_slot_count() const
+		{
+			return m_work.size();
+		}
+
+		// Inside the update: the working state. From the UI thread: the latest published state, which is
+		// the working state itself for a stepped simulation.
+		double get(std::size_t slot)
+		{
+			if (slot >= m_work.size())
+				throw cs::lang_error("Simulation slot out of range.");
+			if (in_update() || is_stepped())
+				return m_work[slot];
+			check_error();
+			return m_states.front()[slot];
+		}
+
+		// Inside the update, or from the UI thread between the ticks of a stepped simulation:
+		// the next tick starts from the value written.
+		void set(std::size_t slot, double value)
+		{
+			if (!in_update() && !is_stepped())
+				throw cs::lang_error("Simulation state can only be written by the update function.");
+			if (slot >= m_work.size())
+				throw cs::lang_error("Simulation slot out of range.");
+			m_work[slot] = value;
+		}
+
+		double get_time() const
+		{
+			return input().time;
+		}
+
+		ImVec2 get_mouse_pos() const
+		{
+			return input().mouse_pos;
+		}
+
+		ImVec2 get_display_size() const
+		{
+			return input().display_size;
+		}
+
+		bool is_mouse_down(int button) const
+		{
+			return input().mouse_down[button_index(button)];
+		}
+
+		bool is_mouse_clicked(int button) const
+		{
+			return in_update() && m_mouse_clicked[button_index(button)];
+		}
+
+		bool is_key_down(ImGuiKey key) const
+		{
+			return input().keys_down[key_index(key)];
+		}
+
+		bool is_key_pressed(ImGuiKey key) const
+		{
+			return in_update() && m_keys_pressed[key_index(key)];
+		}
+	};
+}
@@ -0,0 +1,211 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Software Rasterizer Header
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+
+#include <imgui.hpp>
+
+// STB Image
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <imgui_impl_software.h>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace imgui_cs {
+	// There is no display, the software implementation pretends to have a single 1080p monitor.
+	constexpr int software_monitor_width = 1920;
+	constexpr int software_monitor_height = 1080;
+
+	class image final {
+		int m_width = 0;
+		int m_height = 0;
+		ImTextureID m_textureID = ImTextureID_Invalid;
+
+	public:
+		image() = delete;
+		image(const image &) = delete;
+		image(image &&) noexcept = delete;
+		image(const std::string &path)
+		{
+			unsigned char *data = stbi_load(path.c_str(), &m_width, &m_height, nullptr, 4);
+			if (data == nullptr)
+				throw cs::lang_error("Open image error!");
+			// Textures are plain memory, they do not depend on the application
+			m_textureID = ImGui_ImplSoftware_CreateTexture(data, m_width, m_height);
+			stbi_image_free(data);
+		}
+		~image()
+		{
+			ImGui_ImplSoftware_DestroyTexture(m_textureID);
+		}
+		int get_width() const
+		{
+			return m_width;
+		}
+		int get_height() const
+		{
+			return m_height;
+		}
+		ImTextureID get_texture_id() const
+		{
+			return m_textureID;
+		}
+	};
+
+	int get_monitor_count()
+	{
+		return 1;
+	}
+
+	int get_monitor_width(int monitor_id)
+	{
+		if (monitor_id != 0)
+			throw cs::lang_error("Monitor does not exist.");
+		return software_monitor_width;
+	}
+
+	int get_monitor_height(int monitor_id)
+	{
+		if (monitor_id != 0)
+			throw cs::lang_error("Monitor does not exist.");
+		return software_monitor_height;
+	}
+
+	// Minimal PNG encoder for RGBA8 pixels: deflate "stored" blocks, no compression.
+	// Good enough for golden images and screenshots without pulling in zlib.
+	class png_writer final {
+		std::FILE *m_file;
+		std::uint32_t m_crc = 0;
+		std::uint32_t m_adler_a = 1, m_adler_b = 0;
+
+		static std::uint32_t crc_table(int n)
+		{
+			static std::uint32_t table[256];
+			static bool ready = false;
+			if (!ready) {
+				for (std::uint32_t i = 0; i < 256; ++i) {
+					std::uint32_t c = i;
+					for (int k = 0; k < 8; ++k)
+						c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+					table[i] = c;
+				}
+				ready = true;
+			}
+			return table[n];
+		}
+
+		void put(const void *data, std::size_t size)
+		{
+			const unsigned char *bytes = static_cast<const unsigned char *>(data);
+			for (std::size_t i = 0; i < size; ++i)
+				m_crc = crc_table((m_crc ^ bytes[i]) & 0xFF) ^ (m_crc >> 8);
+			std::fwrite(data, 1, size, m_file);
+		}
+
+		void put_u32(std::uint32_t v)
+		{
+			unsigned char bytes[4] = {static_cast<unsigned char>(v >> 24), static_cast<unsigned char>(v >> 16), static_cast<unsigned char>(v >> 8), static_cast<unsigned char>(v)};
+			put(bytes, 4);
+		}
+
+		void begin_chunk(const char *type, std::uint32_t length)
+		{
+			put_u32(length);
+			m_crc = 0xFFFFFFFFu;
+			put(type, 4);
+		}
+
+		void end_chunk()
+		{
+			put_u32(m_crc ^ 0xFFFFFFFFu);
+		}
+
+		// Image data, adler32 covers the uncompressed bytes only
+		void put_data(const void *data, std::size_t size)
+		{
+			const unsigned char *bytes = static_cast<const unsigned char *>(data);
+			for (std::size_t i = 0; i < size; ++i) {
+				m_adler_a = (m_adler_a + bytes[i]) % 65521;
+				m_adler_b = (m_adler_b + m_adler_a) % 65521;
+			}
+			put(data, size);
+		}
+
+	public:
+		explicit png_writer(std::FILE *file) : m_file(file) {}
+
+		void write(const unsigned char *pixels, int width, int height, int stride)
+		{
+			static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+			std::fwrite(signature, 1, 8, m_file);
+			begin_chunk("IHDR", 13);
+			put_u32(static_cast<std::uint32_t>(width));
+			put_u32(static_cast<std::uint32_t>(height));
+			const unsigned char ihdr[5] = {8, 6, 0, 0, 0}; // 8 bits, RGBA, deflate, no filter, no interlace
+			put(ihdr, 5);
+			end_chunk();
+
+			// Every row is prefixed by its filter type (0, none) and cut into stored blocks of at most 65535 bytes
+			const std::size_t row_size = static_cast<std::size_t>(width) * 4 + 1;
+			const std::size_t raw_size = row_size * height;
+			const std::size_t block_count = raw_size == 0 ? 1 : (raw_size + 65534) / 65535;
+			begin_chunk("IDAT", static_cast<std::uint32_t>(2 + block_count * 5 + raw_size + 4));
+			const unsigned char zlib_header[2] = {0x78, 0x01};
+			put(zlib_header, 2);
+			std::size_t row = 0, row_offset = 0;
+			for (std::size_t remaining = raw_size, block = 0; block < block_count; ++block) {
+				const std::size_t size = remaining < 65535 ? remaining : 65535;
+				remaining -= size;
+				const unsigned char header[5] = {static_cast<unsigned char>(remaining == 0 ? 1 : 0),
+				                                 static_cast<unsigned char>(size), static_cast<unsigned char>(size >> 8),
+				                                 static_cast<unsigned char>(~size), static_cast<unsigned char>(~size >> 8)
+				                                };
+				put(header, 5);
+				for (std::size_t left = size; left > 0;) {
+					if (row_offset == 0) {
+						const unsigned char filter = 0;
+						put_data(&filter, 1);
+						++row_offset;
+						--left;
+						continue;
+					}
+					std::size_t count = row_size - row_offset;
+					if (count > left)
+						count = left;
+					put_data(pixels + row * stride + (row_offset - 1), count);
+					row_offset += count;
+					left -= count;
+					if (row_offset == row_size) {
+						row_offset = 0;
+						++row;
+					}
+				}
+			}
+			put_u32(m_adler_b << 16 | m_adler_a);
+			end_chunk();
+			begin_chunk("IEND", 0);
+			end_chunk();
+		}
+	};
+}
@@ -0,0 +1,196 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Software Rasterizer Implement
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <imgui_software.hpp>
+#include <algorithm>
+#include <chrono>
+
+namespace imgui_cs {
+	// Headless application: frames are rasterized on the CPU into an in-memory RGBA framebuffer.
+	// There is no window and no input, the framebuffer can be saved as PNG or streamed as raw frames.
+	class application final {
+		int m_width = 0;
+		int m_height = 0;
+		std::string m_title;
+		std::vector<unsigned char> m_framebuffer;
+		ImVec4 bg_color = {0.25f, 0.25f, 0.25f, 1.0f};
+		std::chrono::steady_clock::time_point m_last_frame;
+		std::FILE *m_stream = nullptr;
+
+		void init()
+		{
+			IMGUI_CHECKVERSION();
+			ImGui::CreateContext();
+			ImGui_ImplSoftware_Init();
+			ImGuiIO &io = ImGui::GetIO();
+			io.BackendPlatformName = "imgui_cs_headless";
+			// Fonts only need coverage, the rasterizer samples Alpha8 textures directly
+			io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+			io.DisplaySize = ImVec2(static_cast<float>(m_width), static_cast<float>(m_height));
+			ImFont *font = load_font(get_default_font(), 14);
+			if (font == nullptr) {
+				ImGui_ImplSoftware_Shutdown();
+				ImGui::DestroyContext();
+				throw cs::lang_error("Failed to load default font!");
+			}
+			io.FontDefault = font;
+			m_framebuffer.resize(static_cast<std::size_t>(m_width) * m_height * 4);
+			m_last_frame = std::chrono::steady_clock::now();
+		}
+
+	public:
+		application() = delete;
+
+		application(const application &) = delete;
+
+		application(application &&) noexcept = delete;
+
+		application(std::size_t monitor_id, const std::string &title) : m_title(title)
+		{
+			m_width = get_monitor_width(static_cast<int>(monitor_id));
+			m_height = get_monitor_height(static_cast<int>(monitor_id));
+			init();
+		}
+
+		application(std::size_t width, std::size_t height, const std::string &title) : m_width(static_cast<int>(width)), m_height(static_cast<int>(height)), m_title(title)
+		{
+			if (m_width <= 0 || m_height <= 0)
+				throw cs::lang_error("Invalid window size.");
+			init();
+		}
+
+		~application()
+		{
+			if (m_stream)
+				std::fclose(m_stream);
+			ImGui_ImplSoftware_Shutdown();
+			ImGui::DestroyContext();
+		}
+
+		int get_window_width()
+		{
+			return m_width;
+		}
+
+		int get_window_height()
+		{
+			return m_height;
+		}
+
+		void set_window_size(int width, int height)
+		{
+			if (width <= 0 || height <= 0)
+				throw cs::lang_error("Invalid window size.");
+			m_width = width;
+			m_height = height;
+			m_framebuffer.resize(static_cast<std::size_t>(m_width) * m_height * 4);
+		}
+
+		void set_window_title(const std::string &str)
+		{
+			m_title = str;
+		}
+
+		void set_bg_color(const ImVec4 &color)
+		{
+			bg_color = color;
+		}
+
+		// The rasterizer already spreads each frame over a pool of worker threads.
+		void set_threaded_render(bool enabled)
+		{
+			if (enabled)
+				throw cs::lang_error("Threaded rendering is not supported by software implementation.");
+		}
+
+		bool is_threaded_render() const
+		{
+			return false;
+		}
+
+		std::string get_render_driver() const
+		{
+			return ImGui::GetIO().BackendRendererName;
+		}
+
+		// Nobody can close a headless application, scripts decide how many frames they render.
+		bool is_closed() const
+		{
+			return false;
+		}
+
+		void prepare()
+		{
+			ImGuiIO &io = ImGui::GetIO();
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			float delta = std::chrono::duration<float>(now - m_last_frame).count();
+			m_last_frame = now;
+			io.DeltaTime = delta > 0.0f ? delta : 1.0f / 60.0f;
+			io.DisplaySize = ImVec2(static_cast<float>(m_width), static_cast<float>(m_height));
+			io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+			ImGui_ImplSoftware_NewFrame();
+			ImGui::NewFrame();
+		}
+
+		void render()
+		{
+			ImGui::Render();
+			const ImU32 clear = ImGui::ColorConvertFloat4ToU32(bg_color);
+			ImU32 *pixels = reinterpret_cast<ImU32 *>(m_framebuffer.data());
+			std::fill(pixels, pixels + static_cast<std::size_t>(m_width) * m_height, clear);
+			ImGui_ImplSoftware_RenderDrawData(ImGui::GetDrawData(), m_framebuffer.data(), m_width, m_height, m_width * 4);
+			if (m_stream && std::fwrite(m_framebuffer.data(), 1, m_framebuffer.size(), m_stream) != m_framebuffer.size()) {
+				std::fclose(m_stream);
+				m_stream = nullptr;
+				throw cs::lang_error("Write framebuffer stream error!");
+			}
+		}
+
+		// Save the last rendered frame as a PNG image.
+		void save_framebuffer(const std::string &path)
+		{
+			std::FILE *file = std::fopen(path.c_str(), "wb");
+			if (file == nullptr)
+				throw cs::lang_error("Open file error!");
+			png_writer(file).write(m_framebuffer.data(), m_width, m_height, m_width * 4);
+			bool ok = std::ferror(file) == 0;
+			ok = std::fclose(file) == 0 && ok;
+			if (!ok)
+				throw cs::lang_error("Write file error!");
+		}
+
+		// Append every rendered frame as raw RGBA to a file or named pipe, e.g. for
+		// "ffmpeg -f rawvideo -pixel_format rgba -video_size WxH -i <path> out.mp4". An empty path stops streaming.
+		void set_framebuffer_stream(const std::string &path)
+		{
+			if (m_stream) {
+				std::fclose(m_stream);
+				m_stream = nullptr;
+			}
+			if (path.empty())
+				return;
+			m_stream = std::fopen(path.c_str(), "wb");
+			if (m_stream == nullptr)
+				throw cs::lang_error("Open file error!");
+		}
+	};
+}
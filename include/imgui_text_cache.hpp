@@ -0,0 +1,194 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Text Size Cache
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace imgui_cs {
+	// Sizes of texts measured in earlier frames.
+	// Measuring walks every character of a text through the glyph tables of its font, and HUDs measure the
+	// same labels every frame. Sizes are kept by font, size and text, a lookup only hashes and compares the
+	// text. They are dropped when the fonts of the atlas change (a font added or removed, or another font
+	// loader) and once unused for evict_frames frames.
+	class text_size_cache final {
+		static constexpr int evict_frames = 120;
+		static constexpr std::size_t max_entries = 16384;
+
+		struct entry {
+			const ImFont *font;
+			float size;
+			std::string text;
+			ImVec2 result;
+			int last_used_frame;
+		};
+
+		// Everything a change of the fonts of the atlas touches
+		struct atlas_state {
+			const ImFontAtlas *atlas = nullptr;
+			const ImFontLoader *loader = nullptr;
+			int fonts = 0;
+			int sources = 0;
+			int next_font_id = 0;
+
+			bool operator==(const atlas_state &other) const
+			{
+				return atlas == other.atlas && loader == other.loader && fonts == other.fonts && sources == other.sources && next_font_id == other.next_font_id;
+			}
+		};
+
+		std::unordered_map<std::size_t, entry> m_entries;
+		atlas_state m_state;
+		int m_generation = 0;
+		int m_hits = 0;
+		int m_misses = 0;
+
+		text_size_cache() = default;
+
+		static atlas_state current_state()
+		{
+			const ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+			atlas_state state;
+			state.atlas = atlas;
+			state.loader = atlas->FontLoader;
+			state.fonts = atlas->Fonts.Size;
+			state.sources = atlas->Sources.Size;
+			state.next_font_id = atlas->FontNextUniqueID;
+			return state;
+		}
+
+		static std::size_t hash(const ImFont *font, float size, const std::string &text)
+		{
+			std::size_t seed = std::hash<std::string>()(text);
+			seed ^= std::hash<const void *>()(font) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			seed ^= std::hash<float>()(size) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+
+		// Same as ImGui::CalcTextSize() with font and size instead of the current ones
+		static ImVec2 calc(ImFont *font, float size, const std::string &text)
+		{
+			const char *begin = text.c_str();
+			const char *end = ImGui::FindRenderedTextEnd(begin, begin + text.size());
+			if (begin == end)
+				return ImVec2(0.0f, size);
+			ImVec2 result = font->CalcTextSizeA(size, FLT_MAX, -1.0f, begin, end);
+			result.x = IM_TRUNC(result.x + 0.99999f);
+			return result;
+		}
+
+		// Drop the sizes last used before frame
+		void evict(int frame)
+		{
+			for (auto it = m_entries.begin(); it != m_entries.end();) {
+				if (it->second.last_used_frame < frame)
+					it = m_entries.erase(it);
+				else
+					++it;
+			}
+		}
+
+	public:
+		text_size_cache(const text_size_cache &) = delete;
+
+		text_size_cache(text_size_cache &&) noexcept = delete;
+
+		static text_size_cache &get()
+		{
+			static text_size_cache cache;
+			return cache;
+		}
+
+		// Size of text drawn with font at size, the text after "##" is hidden like in ImGui::CalcTextSize()
+		ImVec2 measure(ImFont *font, float size, const std::string &text)
+		{
+			if (text.empty())
+				return ImVec2(0.0f, size);
+			const atlas_state state = current_state();
+			if (!(state == m_state)) {
+				m_entries.clear();
+				m_state = state;
+				++m_generation;
+			}
+			const int frame = ImGui::GetFrameCount();
+			const std::size_t key = hash(font, size, text);
+			auto it = m_entries.find(key);
+			if (it != m_entries.end() && it->second.font == font && it->second.size == size && it->second.text == text) {
+				it->second.last_used_frame = frame;
+				++m_hits;
+				return it->second.result;
+			}
+			++m_misses;
+			const ImVec2 result = calc(font, size, text);
+			if (it != m_entries.end()) {
+				// Hash collision, the latest text wins
+				it->second = entry{font, size, text, result, frame};
+				return result;
+			}
+			if (m_entries.size() >= max_entries)
+				evict(frame);
+			if (m_entries.size() < max_entries)
+				m_entries.emplace(key, entry{font, size, text, result, frame});
+			return result;
+		}
+
+		// Drop every size, e.g. after changing the glyphs of a font in place
+		void clear()
+		{
+			m_entries.clear();
+			++m_generation;
+		}
+
+		// Number of sizes kept, of lookups answered from the cache and of sizes measured
+		std::size_t get_size() const
+		{
+			return m_entries.size();
+		}
+
+		int get_hits() const
+		{
+			return m_hits;
+		}
+
+		int get_misses() const
+		{
+			return m_misses;
+		}
+
+		// Incremented every time the cache is dropped
+		int get_generation() const
+		{
+			return m_generation;
+		}
+
+		// Called once per frame from application.prepare()
+		void next_frame()
+		{
+			const int frame = ImGui::GetFrameCount();
+			if (frame % evict_frames == 0)
+				evict(frame - evict_frames);
+		}
+	};
+}
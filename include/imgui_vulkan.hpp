@@ -0,0 +1,115 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension GLFW Vulkan Header
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+
+#include <imgui.hpp>
+
+// STB Image
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+// Vulkan/GLFW3
+#include <vulkan/vulkan.h>
+#define GLFW_INCLUDE_NONE
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include <imgui_impl_vulkan.h>
+
+namespace imgui_cs {
+	// Set by application while its device is alive, textures can only be created or destroyed meanwhile.
+	extern bool g_VulkanReady;
+
+	class image final {
+		int m_width = 0;
+		int m_height = 0;
+		mutable unsigned char *m_pixels = nullptr;
+		mutable ImTextureID m_textureID = ImTextureID_Invalid;
+
+		void ensure_texture() const
+		{
+			if (m_textureID != ImTextureID_Invalid || m_pixels == nullptr || !g_VulkanReady)
+				return;
+			m_textureID = ImGui_ImplVulkan_CreateTexture(m_pixels, m_width, m_height);
+			stbi_image_free(m_pixels);
+			m_pixels = nullptr;
+		}
+
+	public:
+		image() = delete;
+		image(const image &) = delete;
+		image(image &&) noexcept = delete;
+		image(const std::string &path)
+		{
+			m_pixels = stbi_load(path.c_str(), &m_width, &m_height, nullptr, 4);
+			if (m_pixels == nullptr)
+				throw cs::lang_error("Open image error!");
+		}
+		~image()
+		{
+			// The backend already released its textures if the application is gone
+			if (m_textureID != ImTextureID_Invalid && g_VulkanReady)
+				ImGui_ImplVulkan_DestroyTexture(m_textureID);
+			if (m_pixels)
+				stbi_image_free(m_pixels);
+		}
+		int get_width() const
+		{
+			return m_width;
+		}
+		int get_height() const
+		{
+			return m_height;
+		}
+		ImTextureID get_texture_id() const
+		{
+			ensure_texture();
+			return m_textureID;
+		}
+	};
+
+	int get_monitor_count()
+	{
+		int count = 0;
+		glfwGetMonitors(&count);
+		return count;
+	}
+
+	int get_monitor_width(int monitor_id)
+	{
+		int count = 0;
+		GLFWmonitor **monitors = glfwGetMonitors(&count);
+		if (monitor_id >= count)
+			throw cs::lang_error("Monitor does not exist.");
+		const GLFWvidmode *vidmode = glfwGetVideoMode(monitors[static_cast<std::size_t>(monitor_id)]);
+		return vidmode->width;
+	}
+
+	int get_monitor_height(int monitor_id)
+	{
+		int count = 0;
+		GLFWmonitor **monitors = glfwGetMonitors(&count);
+		if (monitor_id >= count)
+			throw cs::lang_error("Monitor does not exist.");
+		const GLFWvidmode *vidmode = glfwGetVideoMode(monitors[static_cast<std::size_t>(monitor_id)]);
+		return vidmode->height;
+	}
+}
@@ -0,0 +1,561 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Vulkan Implement
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <imgui_vulkan.hpp>
+#include <imgui_impl_glfw.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace imgui_cs {
+	class glfw_instance final {
+		static void error_callback(int error, const char *description)
+		{
+			throw cs::lang_error(description);
+		}
+
+	public:
+		glfw_instance()
+		{
+			glfwSetErrorCallback(error_callback);
+			if (!glfwInit())
+				throw cs::lang_error("Init GLFW Error.");
+		}
+
+		glfw_instance(const glfw_instance &) = delete;
+
+		glfw_instance(glfw_instance &&) noexcept = delete;
+
+		~glfw_instance()
+		{
+			glfwTerminate();
+		}
+	};
+
+	inline void check_vk_result(VkResult err)
+	{
+		if (err < 0)
+			throw cs::lang_error("Vulkan error " + std::to_string(static_cast<int>(err)) + ".");
+	}
+
+	class application final {
+		// Frames recorded ahead of the GPU. The backend keeps one vertex/index/staging buffer set per frame.
+		static constexpr std::uint32_t frames_in_flight = 2;
+
+		struct frame_data {
+			VkCommandPool command_pool = VK_NULL_HANDLE;
+			VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+			VkFence fence = VK_NULL_HANDLE;
+			VkSemaphore image_acquired = VK_NULL_HANDLE;
+		};
+
+		GLFWwindow *window = nullptr;
+		ImVec4 bg_color = {1.0f, 1.0f, 1.0f, 1.0f};
+		VkInstance instance = VK_NULL_HANDLE;
+		VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+		VkDevice device = VK_NULL_HANDLE;
+		std::uint32_t queue_family = 0;
+		VkQueue queue = VK_NULL_HANDLE;
+		VkSurfaceKHR surface = VK_NULL_HANDLE;
+		VkSurfaceFormatKHR surface_format = {};
+		VkRenderPass render_pass = VK_NULL_HANDLE;
+		VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+		VkExtent2D extent = {0, 0};
+		int fb_width = 0;
+		int fb_height = 0;
+		std::vector<VkImageView> image_views;
+		std::vector<VkFramebuffer> framebuffers;
+		std::vector<VkSemaphore> render_complete; // Per swapchain image, presentation may hold it longer than a frame
+		frame_data frames[frames_in_flight];
+		std::uint32_t frame_index = 0;
+		bool swapchain_rebuild = false;
+
+		void create_device()
+		{
+			std::uint32_t extension_count = 0;
+			const char **extensions = glfwGetRequiredInstanceExtensions(&extension_count);
+			if (extensions == nullptr)
+				throw cs::lang_error("Vulkan is not supported by GLFW on this system.");
+			VkApplicationInfo app_info = {};
+			app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+			app_info.pApplicationName = "CovScript ImGUI";
+			app_info.apiVersion = VK_API_VERSION_1_0;
+			VkInstanceCreateInfo instance_info = {};
+			instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+			instance_info.pApplicationInfo = &app_info;
+			instance_info.enabledExtensionCount = extension_count;
+			instance_info.ppEnabledExtensionNames = extensions;
+			check_vk_result(vkCreateInstance(&instance_info, nullptr, &instance));
+			check_vk_result(glfwCreateWindowSurface(instance, window, nullptr, &surface));
+
+			// Prefer a discrete GPU, then anything that can draw and present to our surface (e.g. lavapipe)
+			std::uint32_t device_count = 0;
+			check_vk_result(vkEnumeratePhysicalDevices(instance, &device_count, nullptr));
+			std::vector<VkPhysicalDevice> devices(device_count);
+			check_vk_result(vkEnumeratePhysicalDevices(instance, &device_count, devices.data()));
+			int best_score = -1;
+			for (VkPhysicalDevice candidate : devices) {
+				std::uint32_t family_count = 0;
+				vkGetPhysicalDeviceQueueFamilyProperties(candidate, &family_count, nullptr);
+				std::vector<VkQueueFamilyProperties> families(family_count);
+				vkGetPhysicalDeviceQueueFamilyProperties(candidate, &family_count, families.data());
+				for (std::uint32_t i = 0; i < family_count; ++i) {
+					VkBool32 present = VK_FALSE;
+					vkGetPhysicalDeviceSurfaceSupportKHR(candidate, i, surface, &present);
+					if (!(families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) || !present)
+						continue;
+					VkPhysicalDeviceProperties properties;
+					vkGetPhysicalDeviceProperties(candidate, &properties);
+					int score = properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU ? 2 : properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU ? 1 : 0;
+					if (score > best_score) {
+						best_score = score;
+						physical_device = candidate;
+						queue_family = i;
+					}
+					break;
+				}
+			}
+			if (physical_device == VK_NULL_HANDLE)
+				throw cs::lang_error("No Vulkan device can present to this window.");
+
+			const float queue_priority = 1.0f;
+			VkDeviceQueueCreateInfo queue_info = {};
+			queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			queue_info.queueFamilyIndex = queue_family;
+			queue_info.queueCount = 1;
+			queue_info.pQueuePriorities = &queue_priority;
+			const char *device_extensions[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+			VkDeviceCreateInfo device_info = {};
+			device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+			device_info.queueCreateInfoCount = 1;
+			device_info.pQueueCreateInfos = &queue_info;
+			device_info.enabledExtensionCount = 1;
+			device_info.ppEnabledExtensionNames = device_extensions;
+			check_vk_result(vkCreateDevice(physical_device, &device_info, nullptr, &device));
+			vkGetDeviceQueue(device, queue_family, 0, &queue);
+
+			// 8-bit UNORM output matches the blending of the OpenGL implementations
+			std::uint32_t format_count = 0;
+			check_vk_result(vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &format_count, nullptr));
+			std::vector<VkSurfaceFormatKHR> formats(format_count);
+			check_vk_result(vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &format_count, formats.data()));
+			if (formats.empty())
+				throw cs::lang_error("Vulkan surface has no format.");
+			surface_format = formats[0];
+			for (const VkSurfaceFormatKHR &format : formats)
+				if ((format.format == VK_FORMAT_B8G8R8A8_UNORM || format.format == VK_FORMAT_R8G8B8A8_UNORM) && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+					surface_format = format;
+					break;
+				}
+
+			VkAttachmentDescription attachment = {};
+			attachment.format = surface_format.format;
+			attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+			attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+			VkAttachmentReference color_attachment = {};
+			color_attachment.attachment = 0;
+			color_attachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			VkSubpassDescription subpass = {};
+			subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+			subpass.colorAttachmentCount = 1;
+			subpass.pColorAttachments = &color_attachment;
+			VkSubpassDependency dependency = {};
+			dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+			dependency.dstSubpass = 0;
+			dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			VkRenderPassCreateInfo render_pass_info = {};
+			render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+			render_pass_info.attachmentCount = 1;
+			render_pass_info.pAttachments = &attachment;
+			render_pass_info.subpassCount = 1;
+			render_pass_info.pSubpasses = &subpass;
+			render_pass_info.dependencyCount = 1;
+			render_pass_info.pDependencies = &dependency;
+			check_vk_result(vkCreateRenderPass(device, &render_pass_info, nullptr, &render_pass));
+
+			for (frame_data &frame : frames) {
+				VkCommandPoolCreateInfo pool_info = {};
+				pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+				pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+				pool_info.queueFamilyIndex = queue_family;
+				check_vk_result(vkCreateCommandPool(device, &pool_info, nullptr, &frame.command_pool));
+				VkCommandBufferAllocateInfo buffer_info = {};
+				buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				buffer_info.commandPool = frame.command_pool;
+				buffer_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+				buffer_info.commandBufferCount = 1;
+				check_vk_result(vkAllocateCommandBuffers(device, &buffer_info, &frame.command_buffer));
+				VkFenceCreateInfo fence_info = {};
+				fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+				fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+				check_vk_result(vkCreateFence(device, &fence_info, nullptr, &frame.fence));
+				VkSemaphoreCreateInfo semaphore_info = {};
+				semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+				check_vk_result(vkCreateSemaphore(device, &semaphore_info, nullptr, &frame.image_acquired));
+			}
+		}
+
+		void destroy_swapchain_resources()
+		{
+			for (VkFramebuffer framebuffer : framebuffers)
+				vkDestroyFramebuffer(device, framebuffer, nullptr);
+			for (VkImageView view : image_views)
+				vkDestroyImageView(device, view, nullptr);
+			for (VkSemaphore semaphore : render_complete)
+				vkDestroySemaphore(device, semaphore, nullptr);
+			framebuffers.clear();
+			image_views.clear();
+			render_complete.clear();
+		}
+
+		void create_swapchain()
+		{
+			check_vk_result(vkDeviceWaitIdle(device));
+			destroy_swapchain_resources();
+			glfwGetFramebufferSize(window, &fb_width, &fb_height);
+			VkSurfaceCapabilitiesKHR caps;
+			check_vk_result(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physical_device, surface, &caps));
+			if (caps.currentExtent.width != 0xFFFFFFFF)
+				extent = caps.currentExtent;
+			else {
+				extent.width = std::max(caps.minImageExtent.width, std::min(caps.maxImageExtent.width, static_cast<std::uint32_t>(fb_width)));
+				extent.height = std::max(caps.minImageExtent.height, std::min(caps.maxImageExtent.height, static_cast<std::uint32_t>(fb_height)));
+			}
+			swapchain_rebuild = false;
+			if (extent.width == 0 || extent.height == 0)
+				return; // Minimized, try again later
+			std::uint32_t image_count = caps.minImageCount + 1;
+			if (image_count < frames_in_flight)
+				image_count = frames_in_flight;
+			if (caps.maxImageCount > 0 && image_count > caps.maxImageCount)
+				image_count = caps.maxImageCount;
+			VkSwapchainCreateInfoKHR info = {};
+			info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+			info.surface = surface;
+			info.minImageCount = image_count;
+			info.imageFormat = surface_format.format;
+			info.imageColorSpace = surface_format.colorSpace;
+			info.imageExtent = extent;
+			info.imageArrayLayers = 1;
+			info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+			info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			info.preTransform = caps.currentTransform;
+			info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+			for (VkCompositeAlphaFlagBitsKHR mode : {VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR, VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR, VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR, VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR})
+				if (caps.supportedCompositeAlpha & mode) {
+					info.compositeAlpha = mode;
+					break;
+				}
+			info.presentMode = VK_PRESENT_MODE_FIFO_KHR; // V-Sync, always available
+			info.clipped = VK_TRUE;
+			info.oldSwapchain = swapchain;
+			VkSwapchainKHR new_swapchain = VK_NULL_HANDLE;
+			check_vk_result(vkCreateSwapchainKHR(device, &info, nullptr, &new_swapchain));
+			if (swapchain != VK_NULL_HANDLE)
+				vkDestroySwapchainKHR(device, swapchain, nullptr);
+			swapchain = new_swapchain;
+
+			check_vk_result(vkGetSwapchainImagesKHR(device, swapchain, &image_count, nullptr));
+			std::vector<VkImage> images(image_count);
+			check_vk_result(vkGetSwapchainImagesKHR(device, swapchain, &image_count, images.data()));
+			for (VkImage image : images) {
+				VkImageViewCreateInfo view_info = {};
+				view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+				view_info.image = image;
+				view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+				view_info.format = surface_format.format;
+				view_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				view_info.subresourceRange.levelCount = 1;
+				view_info.subresourceRange.layerCount = 1;
+				VkImageView view = VK_NULL_HANDLE;
+				check_vk_result(vkCreateImageView(device, &view_info, nullptr, &view));
+				image_views.push_back(view);
+				VkFramebufferCreateInfo framebuffer_info = {};
+				framebuffer_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+				framebuffer_info.renderPass = render_pass;
+				framebuffer_info.attachmentCount = 1;
+				framebuffer_info.pAttachments = &view;
+				framebuffer_info.width = extent.width;
+				framebuffer_info.height = extent.height;
+				framebuffer_info.layers = 1;
+				VkFramebuffer framebuffer = VK_NULL_HANDLE;
+				check_vk_result(vkCreateFramebuffer(device, &framebuffer_info, nullptr, &framebuffer));
+				framebuffers.push_back(framebuffer);
+				VkSemaphoreCreateInfo semaphore_info = {};
+				semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+				VkSemaphore semaphore = VK_NULL_HANDLE;
+				check_vk_result(vkCreateSemaphore(device, &semaphore_info, nullptr, &semaphore));
+				render_complete.push_back(semaphore);
+			}
+		}
+
+		void destroy_device()
+		{
+			if (device != VK_NULL_HANDLE) {
+				vkDeviceWaitIdle(device);
+				destroy_swapchain_resources();
+				for (frame_data &frame : frames) {
+					if (frame.image_acquired != VK_NULL_HANDLE)
+						vkDestroySemaphore(device, frame.image_acquired, nullptr);
+					if (frame.fence != VK_NULL_HANDLE)
+						vkDestroyFence(device, frame.fence, nullptr);
+					if (frame.command_pool != VK_NULL_HANDLE)
+						vkDestroyCommandPool(device, frame.command_pool, nullptr);
+					frame = frame_data();
+				}
+				if (swapchain != VK_NULL_HANDLE)
+					vkDestroySwapchainKHR(device, swapchain, nullptr);
+				if (render_pass != VK_NULL_HANDLE)
+					vkDestroyRenderPass(device, render_pass, nullptr);
+				vkDestroyDevice(device, nullptr);
+			}
+			if (surface != VK_NULL_HANDLE)
+				vkDestroySurfaceKHR(instance, surface, nullptr);
+			if (instance != VK_NULL_HANDLE)
+				vkDestroyInstance(instance, nullptr);
+			swapchain = VK_NULL_HANDLE;
+			render_pass = VK_NULL_HANDLE;
+			device = VK_NULL_HANDLE;
+			surface = VK_NULL_HANDLE;
+			instance = VK_NULL_HANDLE;
+		}
+
+		void init()
+		{
+			if (window == nullptr)
+				throw cs::lang_error("Create GLFW window error!");
+			try {
+				create_device();
+				create_swapchain();
+			}
+			catch (...) {
+				destroy_device();
+				glfwDestroyWindow(window);
+				throw;
+			}
+			IMGUI_CHECKVERSION();
+			ImGui::CreateContext();
+			ImGui_ImplGlfw_InitForVulkan(window, true);
+			ImGui_ImplVulkan_InitInfo init_info = {};
+			init_info.Instance = instance;
+			init_info.PhysicalDevice = physical_device;
+			init_info.Device = device;
+			init_info.QueueFamily = queue_family;
+			init_info.Queue = queue;
+			init_info.RenderPass = render_pass;
+			init_info.FramesInFlight = frames_in_flight;
+			init_info.CheckVkResultFn = check_vk_result;
+			ImGui_ImplVulkan_Init(&init_info);
+			g_VulkanReady = true;
+			ImGui::GetIO().FontDefault = load_font(get_default_font(), 14);
+		}
+
+	public:
+		application() = delete;
+
+		application(const application &) = delete;
+
+		application(application &&) noexcept = delete;
+
+		application(std::size_t monitor_id, const std::string &title)
+		{
+			int count = 0;
+			GLFWmonitor **monitors = glfwGetMonitors(&count);
+			if (monitor_id >= count)
+				throw cs::lang_error("Monitor does not exist.");
+			const GLFWvidmode *vidmode = glfwGetVideoMode(monitors[monitor_id]);
+			glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+			window = glfwCreateWindow(vidmode->width, vidmode->height, title.c_str(), monitors[monitor_id], NULL);
+			init();
+		}
+
+		application(std::size_t width, std::size_t height, const std::string &title)
+		{
+			glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+			window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+			init();
+		}
+
+		~application()
+		{
+			vkDeviceWaitIdle(device);
+			ImGui_ImplVulkan_Shutdown();
+			g_VulkanReady = false; // Image destructors skip texture teardown from now on
+			ImGui_ImplGlfw_Shutdown();
+			ImGui::DestroyContext();
+			destroy_device();
+			glfwDestroyWindow(window);
+		}
+
+		int get_window_width()
+		{
+			int width = 0;
+			glfwGetWindowSize(window, &width, nullptr);
+			return width;
+		}
+
+		int get_window_height()
+		{
+			int height = 0;
+			glfwGetWindowSize(window, nullptr, &height);
+			return height;
+		}
+
+		void set_window_size(int width, int height)
+		{
+			glfwSetWindowSize(window, width, height);
+		}
+
+		void set_window_title(const std::string &str)
+		{
+			glfwSetWindowTitle(window, str.c_str());
+		}
+
+		void set_bg_color(const ImVec4 &color)
+		{
+			bg_color = color;
+		}
+
+		// Frames in flight already overlap script and GPU work.
+		void set_threaded_render(bool enabled)
+		{
+			if (enabled)
+				throw cs::lang_error("Threaded rendering is not supported by Vulkan implementation.");
+		}
+
+		bool is_threaded_render() const
+		{
+			return false;
+		}
+
+		std::string get_render_driver() const
+		{
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(physical_device, &properties);
+			return properties.deviceName;
+		}
+
+		bool is_closed()
+		{
+			return glfwWindowShouldClose(window);
+		}
+
+		void prepare()
+		{
+			glfwPollEvents();
+			int width = 0, height = 0;
+			glfwGetFramebufferSize(window, &width, &height);
+			if (swapchain_rebuild || width != fb_width || height != fb_height)
+				create_swapchain();
+			ImGui_ImplVulkan_NewFrame();
+			ImGui_ImplGlfw_NewFrame();
+			ImGui::NewFrame();
+		}
+
+		void render()
+		{
+			ImGui::Render();
+			ImDrawData *draw_data = ImGui::GetDrawData();
+			if (framebuffers.empty() || draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+				return;
+
+			// Wait for the GPU to release this frame: its command buffer and the backend's buffers for it become free
+			frame_data &frame = frames[frame_index];
+			check_vk_result(vkWaitForFences(device, 1, &frame.fence, VK_TRUE, UINT64_MAX));
+			std::uint32_t image_index = 0;
+			VkResult err = vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, frame.image_acquired, VK_NULL_HANDLE, &image_index);
+			if (err == VK_ERROR_OUT_OF_DATE_KHR) {
+				swapchain_rebuild = true;
+				return;
+			}
+			if (err == VK_SUBOPTIMAL_KHR)
+				swapchain_rebuild = true;
+			else
+				check_vk_result(err);
+			check_vk_result(vkResetFences(device, 1, &frame.fence));
+
+			check_vk_result(vkResetCommandPool(device, frame.command_pool, 0));
+			VkCommandBufferBeginInfo begin_info = {};
+			begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			check_vk_result(vkBeginCommandBuffer(frame.command_buffer, &begin_info));
+			// Texture copies cannot be recorded inside the render pass
+			ImGui_ImplVulkan_RecordTextureUploads(draw_data, frame.command_buffer, frame_index);
+			VkClearValue clear_value = {};
+			clear_value.color.float32[0] = bg_color.x;
+			clear_value.color.float32[1] = bg_color.y;
+			clear_value.color.float32[2] = bg_color.z;
+			clear_value.color.float32[3] = bg_color.w;
+			VkRenderPassBeginInfo pass_info = {};
+			pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+			pass_info.renderPass = render_pass;
+			pass_info.framebuffer = framebuffers[image_index];
+			pass_info.renderArea.extent = extent;
+			pass_info.clearValueCount = 1;
+			pass_info.pClearValues = &clear_value;
+			vkCmdBeginRenderPass(frame.command_buffer, &pass_info, VK_SUBPASS_CONTENTS_INLINE);
+			ImGui_ImplVulkan_RenderDrawData(draw_data, frame.command_buffer, frame_index);
+			vkCmdEndRenderPass(frame.command_buffer);
+			check_vk_result(vkEndCommandBuffer(frame.command_buffer));
+
+			VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			VkSubmitInfo submit_info = {};
+			submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submit_info.waitSemaphoreCount = 1;
+			submit_info.pWaitSemaphores = &frame.image_acquired;
+			submit_info.pWaitDstStageMask = &wait_stage;
+			submit_info.commandBufferCount = 1;
+			submit_info.pCommandBuffers = &frame.command_buffer;
+			submit_info.signalSemaphoreCount = 1;
+			submit_info.pSignalSemaphores = &render_complete[image_index];
+			check_vk_result(vkQueueSubmit(queue, 1, &submit_info, frame.fence));
+
+			VkPresentInfoKHR present_info = {};
+			present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+			present_info.waitSemaphoreCount = 1;
+			present_info.pWaitSemaphores = &render_complete[image_index];
+			present_info.swapchainCount = 1;
+			present_info.pSwapchains = &swapchain;
+			present_info.pImageIndices = &image_index;
+			err = vkQueuePresentKHR(queue, &present_info);
+			if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
+				swapchain_rebuild = true;
+			else
+				check_vk_result(err);
+			frame_index = (frame_index + 1) % frames_in_flight;
+		}
+	};
+}
+
+// GLFW Instance
+static imgui_cs::glfw_instance glfw_instance;
+
+// Set while an application owns a Vulkan device
+bool imgui_cs::g_VulkanReady = false;
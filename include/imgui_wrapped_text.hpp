@@ -0,0 +1,163 @@
+#pragma once
+/*
+* Covariant Script ImGUI Extension Wrapped Text
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+* Copyright (C) 2017-2024 Michael Lee(李登淳)
+*
+* Email:   mikecovlee@163.com
+* Github:  https://github.com/mikecovlee
+* Website: https://covscript.org.cn
+*/
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace imgui_cs {
+	// Word-wrapped text whose line breaks are kept between frames.
+	// ImGui::TextWrapped() finds every line break of the whole text again each frame. Here they are found once
+	// per font, size and wrap width, so an unchanged paragraph only costs drawing the lines inside the clipping
+	// rectangle, the others are skipped like ImGuiListClipper skips items. Text appended to the end, e.g. to a
+	// chat log, only lays out again from the start of the last line. Lines break and draw exactly like
+	// ImGui::TextWrapped() with the same text.
+	class wrapped_text final {
+		struct line {
+			std::size_t begin;
+			std::size_t end;
+			float width;
+		};
+
+		std::string m_text;
+		std::vector<line> m_lines;
+		// Layout key, FontId rather than the address of the font which may be reused by another one
+		ImGuiID m_font_id = 0;
+		float m_size = 0.0f;
+		float m_width = 0.0f;
+		float m_text_width = 0.0f;
+		// Start of the text not laid out yet
+		std::size_t m_laid_out = 0;
+		int m_layouts = 0;
+
+		void layout(ImFont *font, float size, float width)
+		{
+			if (font->FontId != m_font_id || size != m_size || width != m_width) {
+				m_font_id = font->FontId;
+				m_size = size;
+				m_width = width;
+				m_text_width = 0.0f;
+				m_lines.clear();
+				m_laid_out = 0;
+			}
+			if (!m_lines.empty() && m_laid_out == m_text.size())
+				return;
+			const char *text = m_text.c_str();
+			const char *text_end = text + m_text.size();
+			const char *s = text + m_laid_out;
+			do {
+				// One line per call, ending after its wrapping point or line feed
+				const char *next = s;
+				const ImVec2 line_size = ImFontCalcTextSizeEx(font, size, FLT_MAX, width, s, text_end, text_end, &next, nullptr, ImDrawTextFlags_StopOnNewLine);
+				m_text_width = ImMax(m_text_width, line_size.x);
+				m_lines.push_back({static_cast<std::size_t>(s - text), static_cast<std::size_t>(next - text), line_size.x});
+				s = next;
+			} while (s < text_end);
+			m_laid_out = m_text.size();
+			++m_layouts;
+		}
+
+	public:
+		wrapped_text() = default;
+
+		explicit wrapped_text(std::string text) : m_text(std::move(text)) {}
+
+		const std::string &get_text() const
+		{
+			return m_text;
+		}
+
+		void set_text(const std::string &text)
+		{
+			if (text == m_text)
+				return;
+			m_text = text;
+			m_lines.clear();
+			m_text_width = 0.0f;
+			m_laid_out = 0;
+		}
+
+		// Only the last line is laid out again
+		void append(const std::string &text)
+		{
+			if (text.empty())
+				return;
+			m_text += text;
+			if (m_lines.empty())
+				return;
+			const line last = m_lines.back();
+			m_lines.pop_back();
+			m_laid_out = last.begin;
+			if (last.width >= m_text_width) {
+				m_text_width = 0.0f;
+				for (const line &l : m_lines)
+					m_text_width = ImMax(m_text_width, l.width);
+			}
+		}
+
+		// Number of lines of the last layout
+		int get_line_count() const
+		{
+			return static_cast<int>(m_lines.size());
+		}
+
+		// Number of times the line breaks were searched for, whole or from an appended line
+		int get_layout_count() const
+		{
+			return m_layouts;
+		}
+
+		// Draw as the next item of the current window, like ImGui::TextWrapped()
+		void draw()
+		{
+			ImGuiWindow *window = ImGui::GetCurrentWindow();
+			if (window->SkipItems)
+				return;
+			ImGuiContext &g = *GImGui;
+			// Keep a wrap position pushed by the caller, like ImGui::TextWrapped()
+			const float wrap_pos_x = window->DC.TextWrapPos >= 0.0f ? window->DC.TextWrapPos : 0.0f;
+			const float width = ImGui::CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x);
+			const float line_height = g.FontSize;
+			layout(g.Font, g.FontSize, width);
+			const ImVec2 pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+			const ImVec2 size(IM_TRUNC(m_text_width + 0.99999f), m_lines.size() * line_height);
+			const ImRect bb(pos, ImVec2(pos.x + size.x, pos.y + size.y));
+			ImGui::ItemSize(size, 0.0f);
+			if (!ImGui::ItemAdd(bb, 0))
+				return;
+			// Lines inside the clipping rectangle, tested like ImFont::RenderText() does, all of them when logging
+			int first = 0;
+			int last = static_cast<int>(m_lines.size());
+			if (!g.LogEnabled) {
+				const float y = IM_TRUNC(pos.y);
+				first = ImClamp(static_cast<int>(ImCeil((window->ClipRect.Min.y - y) / line_height)) - 1, 0, last);
+				last = ImClamp(static_cast<int>(ImFloor((window->ClipRect.Max.y - y) / line_height)) + 1, first, last);
+			}
+			const char *text = m_text.c_str();
+			for (int n = first; n < last; ++n)
+				ImGui::RenderText(ImVec2(pos.x, pos.y + n * line_height), text + m_lines[n].begin, text + m_lines[n].end, false);
+		}
+	};
+}
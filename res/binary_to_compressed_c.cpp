@@ -13,10 +13,16 @@
 // You can also find a precompiled Windows binary in the binary/demo package available from https://github.com/ocornut/imgui
 
 // Usage:
-//   binary_to_compressed_c.exe [-base85] [-nocompress] <inputfile> <symbolname>
+//   binary_to_compressed_c.exe [-base85|-bytes] [-nocompress] <inputfile> <symbolname>
 // Usage example:
 //   # binary_to_compressed_c.exe myfont.ttf MyFont > myfont.cpp
 //   # binary_to_compressed_c.exe -base85 myfont.ttf MyFont > myfont.cpp
+//   # binary_to_compressed_c.exe -bytes -nocompress myfont.ttf MyFont > myfont.cpp
+
+// -bytes emits an unsigned char array, which is endian independent and ends up in the read-only data section as is.
+// Together with -nocompress the array is the font file itself: load it with ImFontConfig::FontDataOwnedByAtlas = false
+// and AddFontFromMemoryTTF() reads it in place, no decoding, no decompression and no heap copy.
+// The pages are mapped from the module on demand, only the parts of the font touched by the rasterizer become resident.
 
 #define _CRT_SECURE_NO_WARNINGS
 #include <stdio.h>
@@ -29,22 +35,24 @@ typedef unsigned int stb_uint;
 typedef unsigned char stb_uchar;
 stb_uint stb_compress(stb_uchar *out,stb_uchar *in,stb_uint len);
 
-static bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_compression);
+static bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_bytes, bool use_compression);
 
 int main(int argc, char** argv)
 {
     if (argc < 3)
     {
-        printf("Syntax: %s [-base85] [-nocompress] <inputfile> <symbolname>\n", argv[0]);
+        printf("Syntax: %s [-base85|-bytes] [-nocompress] <inputfile> <symbolname>\n", argv[0]);
         return 0;
     }
 
     int argn = 1;
     bool use_base85_encoding = false;
+    bool use_bytes = false;
     bool use_compression = true;
-    if (argv[argn][0] == '-')
+    while (argn < argc && argv[argn][0] == '-')
     {
         if (strcmp(argv[argn], "-base85") == 0) { use_base85_encoding = true; argn++; }
+        else if (strcmp(argv[argn], "-bytes") == 0) { use_bytes = true; argn++; }
         else if (strcmp(argv[argn], "-nocompress") == 0) { use_compression = false; argn++; }
         else
         {
@@ -52,8 +60,18 @@ int main(int argc, char** argv)
             return 1;
         }
     }
+    if (use_base85_encoding && use_bytes)
+    {
+        printf("Arguments '-base85' and '-bytes' are exclusive\n");
+        return 1;
+    }
+    if (argn + 2 > argc)
+    {
+        printf("Syntax: %s [-base85|-bytes] [-nocompress] <inputfile> <symbolname>\n", argv[0]);
+        return 1;
+    }
 
-    return binary_to_compressed_c(argv[argn], argv[argn+1], use_base85_encoding, use_compression) ? 0 : 1;
+    return binary_to_compressed_c(argv[argn], argv[argn+1], use_base85_encoding, use_bytes, use_compression) ? 0 : 1;
 }
 
 char Encode85Byte(unsigned int x)
@@ -62,7 +80,7 @@ char Encode85Byte(unsigned int x)
     return (x>='\\') ? x+1 : x;
 }
 
-bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_compression)
+bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_bytes, bool use_compression)
 {
     // Read file
     FILE* f = fopen(filename, "rb");
@@ -105,6 +123,19 @@ bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_b
         }
         fprintf(out, "\";\n\n");
     }
+    else if (use_bytes)
+    {
+        fprintf(out, "static const unsigned int %s_%ssize = %d;\n", symbol, compressed_str, (int)compressed_sz);
+        fprintf(out, "static const unsigned char %s_%sdata[%d] =\n{", symbol, compressed_str, (int)compressed_sz);
+        for (int i = 0; i < compressed_sz; i++)
+        {
+            if ((i % 24) == 0)
+                fprintf(out, "\n    %d,", (unsigned char)compressed[i]);
+            else
+                fprintf(out, "%d,", (unsigned char)compressed[i]);
+        }
+        fprintf(out, "\n};\n\n");
+    }
     else
     {
         fprintf(out, "static const unsigned int %s_%ssize = %d;\n", symbol, compressed_str, (int)compressed_sz);
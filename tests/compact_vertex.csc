@@ -0,0 +1,30 @@
+import imgui_compact
+using imgui_compact
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui_compact.get_monitor_width(0),0.75*imgui_compact.get_monitor_height(0),"CovScript ImGUI Compact Vertex")
+style_color_dark()
+# Same canvas workload as vulkan.csc, swap the import for imgui to compare with 20-byte vertices
+var frames=300
+var shape_count=6000
+var frame=0
+var render_time=0
+var result=""
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Canvas", opened, {})
+        text(result)
+        for i=0, i<shape_count, ++i
+            add_circle_filled(vec2(20+(i*37+frame)%600,80+(i*91)%400),4,vec4((i%7)/7,(i%5)/5,(i%3)/3,0.8),0)
+        end
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame==frames
+        result="Draw data: "+get_draw_data_size()/1024+" KiB/frame, "+render_time/frames+" ms/render"
+        system.out.println(result)
+        frame=0
+        render_time=0
+    end
+end
@@ -0,0 +1,35 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=fullscreen_application(0,"CovScript ImGUI Dynamic Resolution")
+style_color_dark()
+# OpenGL 3 and SDL builds only. Fill bound canvas, the render scale drops until the frame fits into the budget
+var budget=16
+var shape_count=3000
+var frames=120
+var frame=0
+var render_time=0
+var result=""
+var opened=true
+app.set_render_budget(budget)
+while !app.is_closed()
+    app.prepare()
+    begin_window("Canvas", opened, {})
+        text("Driver: "+app.get_render_driver()+", budget: "+budget+" ms")
+        text(result)
+        # Input keeps window coordinates at any scale
+        text("Mouse: "+get_mouse_pos_x()+", "+get_mouse_pos_y())
+        for i=0, i<shape_count, ++i
+            add_rect_filled(vec2((i*37+frame)%1800,80+(i*91)%900),vec2((i*37+frame)%1800+60,140+(i*91)%900),vec4((i%7)/7,(i%5)/5,(i%3)/3,0.5),0)
+        end
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame==frames
+        result="Scale: "+app.get_render_scale()+", "+render_time/frames+" ms/render"
+        system.out.println(result)
+        frame=0
+        render_time=0
+    end
+end
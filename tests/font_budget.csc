@@ -0,0 +1,36 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# Labels zooming through many sizes grow the font atlas, the budget shrinks it back once they are gone
+var budget=256*1024
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Font Atlas Budget")
+style_color_dark()
+set_font_atlas_budget(budget)
+var font=get_font()
+var frame=0
+var peak=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    if get_font_atlas_memory()>peak
+        peak=get_font_atlas_memory()
+    end
+    begin_window("Atlas", opened, {})
+        text("Texture: "+get_font_atlas_width()+"x"+get_font_atlas_height()+", "+get_font_atlas_memory()+" bytes, peak "+peak+" bytes, budget "+get_font_atlas_budget()+" bytes")
+        text("Used: "+get_font_atlas_used_area()+" texels, "+get_font_atlas_glyph_count()+" glyphs, "+get_font_atlas_repack_count()+" repacks")
+        if button("Compact")
+            compact_font_atlas()
+        end
+        if button("Dump")
+            system.out.println(dump_font_atlas())
+        end
+        # Zoom in for five seconds, then only the window text is left
+        if frame%600<300
+            foreach i in range(24)
+                add_text(font,14+i*2.5+(frame%600)*0.05,vec2(20,160+i*8),vec4(1,1,1,1),"The quick brown fox jumps over the lazy dog")
+            end
+        end
+    end_window()
+    app.render()
+    frame+=1
+end
@@ -0,0 +1,29 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# Run twice: the first start rasterizes and writes font_cache.bin, the second one maps it back in
+var use_cache=true
+var begin=runtime.time()
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Font Cache")
+var cached=use_cache?enable_font_cache("./font_cache.bin"):false
+style_color_dark()
+var sizes={11, 13, 18, 24, 28}
+var first_frame=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Text", opened, {})
+        text(use_cache?(cached?"Font cache loaded":"Font cache created"):"Font cache disabled")
+        text("Time to first frame: "+first_frame+" ms")
+        var y=80
+        foreach size in sizes
+            add_text(get_font(),size,vec2(20,y),vec4(1,1,1,1),"The quick brown fox jumps over the lazy dog 0123456789")
+            y+=size+8
+        end
+    end_window()
+    app.render()
+    if first_frame==0
+        first_frame=runtime.time()-begin
+        system.out.println("Time to first frame: "+first_frame+" ms")
+    end
+end
@@ -0,0 +1,27 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# The same font file at four sizes: one shared mapping instead of four copies of the file
+var path="../res/SourceSansPro.otf"
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Font Data Sharing")
+style_color_dark()
+var sizes={14, 18, 24, 32}
+var fonts=new array
+var begin=runtime.time()
+foreach size in sizes
+    fonts.push_back(add_font(path,size))
+end
+var add_time=runtime.time()-begin
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Text", opened, {})
+        text("Added 4 sizes in "+add_time+" ms")
+        foreach font in fonts
+            push_font(font)
+            text("The quick brown fox jumps over the lazy dog 0123456789")
+            pop_font()
+        end
+    end_window()
+    app.render()
+end
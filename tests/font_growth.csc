@@ -0,0 +1,36 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# Text at a new size every few frames keeps filling the atlas, compare the slowest frame with and without headroom
+var headroom=0.25
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Font Atlas Growth")
+style_color_dark()
+set_font_atlas_headroom(headroom)
+var font=get_font()
+var sample="The quick brown fox jumps over the lazy dog 0123456789 ÀÉÎÕÜ àéîõü ÆØÅ æøå"
+var sizes=new array
+var frame=0
+var last=runtime.time()
+var worst=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    var now=runtime.time()
+    if frame>1 && now-last>worst
+        worst=now-last
+    end
+    last=now
+    if frame%4==0 && sizes.size<400
+        sizes.push_back(12+sizes.size*0.25)
+    end
+    begin_window("Atlas", opened, {})
+        text("Texture: "+get_font_atlas_width()+"x"+get_font_atlas_height()+", "+get_font_atlas_glyph_count()+" glyphs")
+        text("Grown in place: "+get_font_atlas_growth_count()+", repacks: "+get_font_atlas_repack_count())
+        text("Slowest frame: "+worst+" ms")
+        foreach size in sizes
+            add_text(font,size,vec2(20,120),vec4(1,1,1,0.05),sample)
+        end
+    end_window()
+    app.render()
+    frame+=1
+end
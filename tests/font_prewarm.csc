@@ -0,0 +1,40 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# Compare the frame where a large block of new glyphs first appears with and without prewarming
+var use_prewarm=true
+var size=28
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Font Prewarming")
+style_color_dark()
+var font=get_font()
+var sample="Съешь же ещё этих мягких французских булок, да выпей чаю. Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. Tiếng Việt có dấu."
+var queued=use_prewarm?prewarm_font(font,size,"cyrillic")+prewarm_font_text(font,size,sample):0
+var frame=0
+var shown_at=120
+var last=runtime.time()
+var worst_before=0
+var first_text_frame=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    var now=runtime.time()
+    var frame_ms=now-last
+    last=now
+    if frame<shown_at && frame>1 && frame_ms>worst_before
+        worst_before=frame_ms
+    end
+    if frame==shown_at+1
+        first_text_frame=frame_ms
+        system.out.println("Slowest frame while prewarming: "+worst_before+" ms, frame showing the text: "+first_text_frame+" ms")
+    end
+    begin_window("Text", opened, {})
+        text(use_prewarm?"Glyphs queued: "+queued+", pending: "+get_prewarm_pending():"Prewarming disabled")
+        text("Slowest frame while prewarming: "+worst_before+" ms")
+        text("Frame showing the text: "+first_text_frame+" ms")
+        if frame>=shown_at
+            add_text(font,size,vec2(20,120),vec4(1,1,1,1),sample)
+        end
+    end_window()
+    app.render()
+    frame+=1
+end
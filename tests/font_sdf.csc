@@ -0,0 +1,34 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# Labels at many sizes: the SDF font bakes each glyph once, the regular one once per size
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI SDF Fonts")
+style_color_dark()
+var sdf=add_font_default_sdf(16)
+var baked=add_font_default(16)
+var sizes={11, 13, 18, 24, 28}
+var use_sdf=is_font_sdf(sdf)
+var frame=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Text", opened, {})
+        text("SDF text supported: "+is_font_sdf(sdf))
+        text("Atlas: "+get_font_atlas_memory()+" bytes, "+get_font_atlas_glyph_count()+" glyphs")
+        check_box("Draw with the SDF font", use_sdf)
+        var font=baked
+        if use_sdf
+            font=sdf
+        end
+        var y=120
+        foreach size in sizes
+            add_text(font,size,vec2(20,y),vec4(1,1,1,1),"The quick brown fox jumps over the lazy dog 0123456789")
+            y+=size+4
+        end
+        # A zooming label walks through every size in between
+        var zoom=10+(frame%300)*0.2
+        add_text(font,zoom,vec2(20,y),vec4(1,0.8,0.2,1),"Zoom "+zoom)
+    end_window()
+    app.render()
+    frame+=1
+end
@@ -0,0 +1,47 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Instancing Benchmark")
+style_color_dark()
+# Particles drawn tessellated first, then as one instanced shape batch
+var frames_per_mode=300
+var particle_count=10000
+var instanced=false
+var results=new array
+var frame=0
+var build_time=0
+var render_time=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Particles", opened, {})
+        text(instanced?"Shape batch":"Tessellated")
+        foreach it in results
+            text(it)
+        end
+        var begin=runtime.time()
+        if instanced
+            begin_shape_batch(shapes.circle)
+            for i=0, i<particle_count, ++i
+                add_shape_instance(vec2(20+(i*37+frame)%600,80+(i*91)%400),vec2(4,4),vec4((i%7)/7,(i%5)/5,(i%3)/3,0.8))
+            end
+            end_shape_batch()
+        else
+            for i=0, i<particle_count, ++i
+                add_circle_filled(vec2(20+(i*37+frame)%600,80+(i*91)%400),4,vec4((i%7)/7,(i%5)/5,(i%3)/3,0.8),0)
+            end
+        end
+        build_time+=runtime.time()-begin
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame==frames_per_mode
+        results.push_back((instanced?"Shape batch":"Tessellated")+": "+build_time/frame+" ms/build, "+render_time/frame+" ms/render")
+        system.out.println(results.back)
+        instanced=!instanced
+        frame=0
+        build_time=0
+        render_time=0
+    end
+end
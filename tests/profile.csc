@@ -0,0 +1,32 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Binding Profile")
+var window_opened=true
+var label_count=2000
+var report=""
+var frame=0
+enable_binding_profile(true)
+while !app.is_closed()
+    app.prepare()
+    begin_window("Binding Profile", window_opened, {flags.no_resize, flags.no_title_bar, flags.no_move})
+        if !window_opened
+            break
+        end
+        set_window_pos(vec2(0,0))
+        set_window_size(vec2(app.get_window_width(),app.get_window_height()))
+        slider_float("Labels", label_count, 0, 10000)
+        if button("Reset")
+            reset_binding_profile()
+        end
+        text(report)
+        separator()
+        for i=0, i<label_count, ++i
+            text_colored(vec4(0.2,0.4,0.8,1),"Label "+i)
+        end
+    end_window()
+    app.render()
+    if ++frame%120==0
+        report=dump_binding_profile(120,10)
+    end
+end
@@ -0,0 +1,33 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Quality Governor")
+style_color_dark()
+# Dashboard on a 30 fps budget: quality drops while the frame time is over it and comes back once there is headroom
+var budget=33
+var gauge_count=2000
+var frame=0
+var samples=new array
+var opened=true
+set_quality_budget(budget)
+while !app.is_closed()
+    app.prepare()
+    begin_window("Dashboard", opened, {})
+        text("Quality level: "+get_quality_level()+", "+get_framerate()+" fps, budget "+budget+" ms")
+        # Throttled widget: the history only advances on update frames
+        if is_update_frame()
+            samples.push_back(get_framerate())
+            if samples.size>120
+                samples.pop_front()
+            end
+        end
+        text("Samples: "+samples.size)
+        for i=0, i<gauge_count, ++i
+            var pos=vec2(30+(i%50)*24,80+(i/50)*24)
+            add_circle(pos,10,vec4((i%7)/7,(i%5)/5,(i%3)/3,1),64,2)
+            add_circle_filled(pos,(frame+i)%10,vec4(1,1,1,0.5),64)
+        end
+    end_window()
+    app.render()
+    ++frame
+end
@@ -0,0 +1,29 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# SDL build only, these must be set before the application is created
+set_render_driver("software")
+set_render_batching(true)
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Render Driver")
+var shape_count=3000
+var frame=0
+var render_time=0
+var average="-"
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Canvas", opened, {})
+        text("Driver: "+app.get_render_driver())
+        text("Render: "+average+" ms")
+        for i=0, i<shape_count, ++i
+            add_circle_filled(vec2(20+(i*37+frame)%600,80+(i*91)%400),4,vec4((i%7)/7,(i%5)/5,(i%3)/3,0.8),12)
+        end
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame%100==0
+        average=to_string(render_time/100)
+        render_time=0
+    end
+end
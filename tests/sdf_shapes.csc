@@ -0,0 +1,55 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Analytic Shapes Benchmark")
+style_color_dark()
+# Round shapes with 360 segments, tessellated first, then as analytic shapes if the renderer supports them
+var frames_per_mode=300
+var shape_count=4000
+var sdf=false
+var results=new array
+var frame=0
+var build_time=0
+var render_time=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Shapes", opened, {})
+        text(sdf?"Analytic":"Tessellated")
+        foreach it in results
+            text(it)
+        end
+        var begin=runtime.time()
+        for i=0, i<shape_count, ++i
+            var pos=vec2(40+(i*37+frame)%600,100+(i*91)%400)
+            var color=vec4((i%7)/7,(i%5)/5,(i%3)/3,0.8)
+            var r=3+i%9
+            switch i%4
+                case 0
+                    add_circle_filled(pos,r,color,360)
+                end
+                case 1
+                    add_circle(pos,r,color,360,2)
+                end
+                case 2
+                    add_rect_filled(vec2(pos.x-r,pos.y-r),vec2(pos.x+r*2,pos.y+r),color,4)
+                end
+                case 3
+                    add_capsule_filled(vec2(pos.x-r,pos.y-r),vec2(pos.x+r,pos.y+r),r/2,color)
+                end
+            end
+        end
+        build_time+=runtime.time()-begin
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame==frames_per_mode
+        results.push_back((sdf?"Analytic":"Tessellated")+": "+build_time/frame+" ms/build, "+render_time/frame+" ms/render")
+        system.out.println(results.back)
+        sdf=set_sdf_shapes(!sdf)
+        frame=0
+        build_time=0
+        render_time=0
+    end
+end
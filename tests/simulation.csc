@@ -0,0 +1,50 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Simulation")
+var window_opened=true
+# Runs at 120 Hz from app.prepare(), as the frame begins: it reads and writes sim only, no drawing.
+# Slot 0/1: ball position, slot 2/3: ball velocity, slot 4: bounces, slot 5: recenter request from the UI
+function update(sim)
+    var size=sim.get_display_size()
+    var dt=sim.get_delta_time()
+    var x=sim.get(0)+sim.get(2)*dt
+    var y=sim.get(1)+sim.get(3)*dt
+    if sim.get(2)==0
+        sim.set(2,240)
+        sim.set(3,180)
+    end
+    if x<0 || x>size.x
+        sim.set(2,-sim.get(2))
+        sim.set(4,sim.get(4)+1)
+    end
+    if y<0 || y>size.y
+        sim.set(3,-sim.get(3))
+        sim.set(4,sim.get(4)+1)
+    end
+    if sim.get(5)!=0
+        x=size.x/2
+        y=size.y/2
+        sim.set(5,0)
+    end
+    sim.set(0,x)
+    sim.set(1,y)
+end
+var sim=start_simulation(update,5,120)
+while !app.is_closed()
+    app.prepare()
+    begin_window("Simulation", window_opened, {flags.no_resize, flags.no_title_bar, flags.no_move})
+        if !window_opened
+            break
+        end
+        set_window_pos(vec2(0,0))
+        set_window_size(vec2(app.get_window_width(),app.get_window_height()))
+        if is_key_pressed(keys.space)
+            sim.set(5,1)
+        end
+        text("Ticks: "+sim.get_ticks()+", bounces: "+sim.get(4)+", press space to recenter")
+        add_circle_filled(vec2(sim.get(0),sim.get(1)),10,vec4(0.9,0.4,0.2,1),24)
+    end_window()
+    app.render()
+end
+sim.stop()
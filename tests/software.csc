@@ -0,0 +1,28 @@
+import imgui_soft
+using imgui_soft
+system.file.remove("./imgui.ini")
+# Headless: rasterized on the CPU, no display or GL driver needed
+var app=software_application(1280,720)
+style_color_dark()
+var frames=300
+var shape_count=3000
+var render_time=0
+var opened=true
+# Stream every frame as raw RGBA, play with: ffplay -f rawvideo -pixel_format rgba -video_size 1280x720 software.rgba
+app.set_framebuffer_stream("./software.rgba")
+for frame=0, frame<frames, ++frame
+    app.prepare()
+    begin_window("Canvas", opened, {})
+        text("Driver: "+app.get_render_driver())
+        text("Frame: "+frame)
+        for i=0, i<shape_count, ++i
+            add_circle_filled(vec2(20+(i*37+frame)%600,80+(i*91)%400),4,vec4((i%7)/7,(i%5)/5,(i%3)/3,0.8),12)
+        end
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+end
+app.set_framebuffer_stream("")
+app.save_framebuffer("./software.png")
+system.out.println("Software: "+render_time/frames+" ms/render")
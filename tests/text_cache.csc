@@ -0,0 +1,27 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# A HUD measuring the same labels every frame: only the clock is measured again
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Text Size Cache")
+style_color_dark()
+var font=get_font()
+var labels={"Score", "Lives", "Level", "Ammo", "Shield", "Fuel"}
+var frame=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("HUD", opened, {})
+        text("Cached sizes: "+get_text_cache_size()+", hits "+get_text_cache_hits()+", misses "+get_text_cache_misses())
+        var y=120
+        foreach label in labels
+            var size=calc_text_size_at(label, 24)
+            add_text(font,24,vec2(20,y),vec4(1,1,1,1),label)
+            add_text(font,24,vec2(40+size.x,y),vec4(0.4,1,0.4,1),to_string(frame))
+            y+=size.y+4
+        end
+        var clock="Frame "+frame
+        add_text(font,13,vec2(20,y),vec4(1,0.8,0.2,1),clock+" ("+calc_text_size_at(clock, 13).x+" px)")
+    end_window()
+    app.render()
+    frame+=1
+end
@@ -0,0 +1,48 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Upload Benchmark")
+# OpenGL 3 build only. Many small windows: one draw list each, the upload cost dominates the render call
+var window_count=200
+var frames_per_mode=300
+var mode_names={"buffer_data", "map_range", "persistent_ring"}
+var modes={upload_modes.buffer_data, upload_modes.map_range, upload_modes.persistent_ring}
+var results=new array
+var mode_index=0
+var merged=false
+var frame=0
+var render_time=0
+var active=app.set_upload_mode(modes[0])
+var result_opened=true
+while !app.is_closed()
+    app.prepare()
+    for i=0, i<window_count, ++i
+        set_next_window_pos(vec2((i%20)*60,(i/20)*60))
+        set_next_window_size(vec2(56,56))
+        var opened=true
+        begin_window("W"+i, opened, {flags.no_resize, flags.no_title_bar, flags.no_move})
+            text(to_string(frame%100))
+        end_window()
+    end
+    begin_window("Result", result_opened, {})
+        text("Mode: "+mode_names[active]+(merged?" (merged)":""))
+        foreach it in results
+            text(it)
+        end
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame==frames_per_mode
+        results.push_back(mode_names[active]+(merged?" (merged)":"")+": "+render_time/frame+" ms/render")
+        system.out.println(results.back)
+        frame=0
+        render_time=0
+        mode_index=(mode_index+1)%modes.size
+        if mode_index==0
+            merged=!merged
+            app.set_merged_upload(merged)
+        end
+        active=app.set_upload_mode(modes[mode_index])
+    end
+end
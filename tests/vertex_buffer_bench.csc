@@ -0,0 +1,45 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Vertex Buffer Benchmark")
+# OpenGL 2 build only. A few canvases with thousands of shapes each: large draw lists, the legacy build copies them on every draw call
+var canvas_count=3
+var shapes_per_canvas=2000
+var frames_per_mode=300
+var results=new array
+var vertex_buffers=app.set_vertex_buffers(true)
+var frame=0
+var render_time=0
+var result_opened=true
+while !app.is_closed()
+    app.prepare()
+    var width=app.get_window_width()
+    var height=app.get_window_height()
+    for c=0, c<canvas_count, ++c
+        set_next_window_pos(vec2(c*width/canvas_count,0))
+        set_next_window_size(vec2(width/canvas_count,height))
+        var opened=true
+        begin_window("Canvas"+c, opened, {flags.no_resize, flags.no_title_bar, flags.no_move})
+            for i=0, i<shapes_per_canvas, ++i
+                var k=i+c*shapes_per_canvas
+                add_circle_filled(vec2(c*width/canvas_count+(k*37+frame)%(width/canvas_count),(k*91)%height),4,vec4((k%7)/7,(k%5)/5,(k%3)/3,0.8),12)
+            end
+        end_window()
+    end
+    begin_window("Result", result_opened, {})
+        text(vertex_buffers?"Vertex buffers":"Client arrays")
+        foreach it in results
+            text(it)
+        end
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame==frames_per_mode
+        results.push_back((vertex_buffers?"Vertex buffers":"Client arrays")+": "+render_time/frame+" ms/render")
+        system.out.println(results.back)
+        frame=0
+        render_time=0
+        vertex_buffers=app.set_vertex_buffers(!vertex_buffers)
+    end
+end
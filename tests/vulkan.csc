@@ -0,0 +1,31 @@
+import imgui_vk
+using imgui_vk
+system.file.remove("./imgui.ini")
+var app=window_application(0.75*imgui_vk.get_monitor_width(0),0.75*imgui_vk.get_monitor_height(0),"CovScript ImGUI Vulkan")
+style_color_dark()
+# Same canvas workload as software.csc, swap the import for imgui to compare with the OpenGL 3 path
+var frames=300
+var shape_count=3000
+var frame=0
+var render_time=0
+var result=""
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Canvas", opened, {})
+        text("Driver: "+app.get_render_driver())
+        text(result)
+        for i=0, i<shape_count, ++i
+            add_circle_filled(vec2(20+(i*37+frame)%600,80+(i*91)%400),4,vec4((i%7)/7,(i%5)/5,(i%3)/3,0.8),12)
+        end
+    end_window()
+    var begin=runtime.time()
+    app.render()
+    render_time+=runtime.time()-begin
+    if ++frame==frames
+        result="Vulkan: "+render_time/frames+" ms/render"
+        system.out.println(result)
+        frame=0
+        render_time=0
+    end
+end
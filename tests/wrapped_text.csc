@@ -0,0 +1,36 @@
+import imgui
+using imgui
+system.file.remove("./imgui.ini")
+# A help panel and a chat log: line breaks are only found again when the width changes or a message arrives
+var app=window_application(0.75*imgui.get_monitor_width(0),0.75*imgui.get_monitor_height(0),"CovScript ImGUI Wrapped Text")
+style_color_dark()
+var words={"lorem", "ipsum", "dolor", "sit", "amet,", "consectetur", "adipiscing", "elit", "sed", "do", "eiusmod", "tempor"}
+var help_str=""
+for i=0, i<4000, ++i
+    help_str+=words[i%words.size]+" "
+    if i%97==96
+        help_str+="\n\n"
+    end
+end
+var help=wrapped_text(help_str)
+var log=wrapped_text("")
+var frame=0
+var messages=0
+var opened=true
+while !app.is_closed()
+    app.prepare()
+    begin_window("Help", opened, {})
+        text(help_str.size+" bytes, "+help.get_line_count()+" lines, laid out "+help.get_layout_count()+" time(s)")
+        help.draw()
+    end_window()
+    if frame%30==0
+        log.append("user"+messages%5+": message sent at frame "+frame+", long enough to wrap in a narrow window\n")
+        ++messages
+    end
+    begin_window("Chat", opened, {})
+        text(log.get_line_count()+" lines, laid out "+log.get_layout_count()+" time(s)")
+        log.draw()
+    end_window()
+    app.render()
+    frame+=1
+end